@@ -0,0 +1,117 @@
+// UpdateVelocityBatch against a loop of UpdateVelocity over the same
+// controllers
+//
+//   batch_bench [--quick]
+#include "bench.h"
+#include "ini.h"
+#include "movement.h"
+#include "movement_batch.h"
+#include "movement_profiles.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace movement;
+
+namespace {
+
+constexpr auto kDeltaTime = 1.f / 60.f;
+
+struct Controllers {
+	std::vector<float> soa[13];
+	std::vector<uint32_t> moveFlags;
+	std::unique_ptr<bool[]> inAir;
+	std::vector<MoveParams> moves;
+	std::vector<MoveInput> inputs;
+	std::vector<vec3> velocities;
+
+	explicit Controllers(size_t count)
+	{
+		auto rng = std::mt19937(1);
+		auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+		inAir = std::make_unique<bool[]>(count);
+
+		for (size_t i = 0; i < count; i++) {
+			const auto forward = vec3(unit(rng), unit(rng), 0.f).normalized();
+			const auto normal = i % 3 != 0
+				? vec3(0.f, 0.f, 1.f)
+				: vec3(unit(rng) * .5f, unit(rng) * .5f, 1.f).normalized();
+			const auto velocity = vec3(unit(rng), unit(rng), 0.f) * 20.f;
+			const auto input = MoveInput {
+				.moveFlags = (uint32_t)rng() & kMoveMask,
+				.moveSpeed = 10.f + unit(rng) * 5.f,
+				.inAir     = rng() % 4 == 0
+			};
+
+			moves.push_back({.forward = forward, .up = vec3(0.f, 0.f, 1.f), .groundNormal = normal});
+			inputs.push_back(input);
+			velocities.push_back(velocity);
+
+			const float values[] = {
+				velocity.x, velocity.y, velocity.z, forward.x, forward.y, forward.z,
+				0.f, 0.f, 1.f, normal.x, normal.y, normal.z, input.moveSpeed
+			};
+
+			for (auto j = 0; j < 13; j++)
+				soa[j].push_back(values[j]);
+
+			moveFlags.push_back(input.moveFlags);
+			inAir[i] = input.inAir;
+		}
+	}
+
+	MoveBatch Batch()
+	{
+		return {
+			.count        = moves.size(),
+			.velocity     = {soa[0].data(), soa[1].data(), soa[2].data()},
+			.forward      = {soa[3].data(), soa[4].data(), soa[5].data()},
+			.up           = {soa[6].data(), soa[7].data(), soa[8].data()},
+			.groundNormal = {soa[9].data(), soa[10].data(), soa[11].data()},
+			.moveFlags    = moveFlags.data(),
+			.moveSpeed    = soa[12].data(),
+			.inAir        = inAir.get()
+		};
+	}
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto updates = bench::IsQuick(argc, argv) ? (size_t)10000 : (size_t)10000000;
+	const auto &settings = ini::Get();
+	const auto &kernels = GetProfileKernels(0);
+
+	for (const auto count : {(size_t)1, (size_t)64, (size_t)1024}) {
+		auto controllers = Controllers(count);
+		const auto batch = controllers.Batch();
+		const auto steps = std::max(updates / count, (size_t)1);
+
+		const auto scalar = bench::BestOf(3, [&] {
+			for (size_t step = 0; step < steps; step++) {
+				for (size_t i = 0; i < count; i++) {
+					kernels.updateVelocity(
+						settings, controllers.moves[i], controllers.inputs[i], &controllers.velocities[i],
+						kDeltaTime, Integrator::Euler);
+				}
+
+				bench::DoNotOptimize(controllers.velocities[0]);
+			}
+		});
+
+		const auto batched = bench::BestOf(3, [&] {
+			for (size_t step = 0; step < steps; step++) {
+				UpdateVelocityBatch(settings, batch, kernels, kDeltaTime);
+				bench::DoNotOptimize(batch.velocity.x[0]);
+			}
+		});
+
+		const auto total = (double)(steps * count);
+		printf(
+			"%4zu controllers: scalar %.2f ns, batch %.2f ns per controller (%.2fx)\n",
+			count, scalar / total, batched / total, scalar / batched);
+	}
+}
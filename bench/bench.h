@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Timing helpers shared by the benchmarks
+namespace bench {
+
+// Keep value alive as if it were read
+template<typename T>
+inline void DoNotOptimize(const T &value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Whether --quick was passed, which ctest does to only check the benchmark runs
+inline bool IsQuick(int argc, char *argv[])
+{
+	return std::any_of(argv + 1, argv + argc, [](const char *arg) {
+		return strcmp(arg, "--quick") == 0;
+	});
+}
+
+// Fastest of several runs of callable in nanoseconds, leaving out warmup and
+// preemption
+inline double BestOf(int runs, auto &&callable)
+{
+	auto best = 1e18;
+
+	for (auto i = 0; i < runs; i++) {
+		const auto start = std::chrono::steady_clock::now();
+		callable();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		best = std::min(best, (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	}
+
+	return best;
+}
+
+} // namespace bench
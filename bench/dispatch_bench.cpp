@@ -0,0 +1,106 @@
+// Calls through 1, 2 and 5 handlers sharing a call site through the dispatch
+// registry, against the same handlers chained through each other's TLS
+// trampolines, as separate modules hooking the site would be
+//
+//   dispatch_bench [--quick]
+#include "bench.h"
+#include "hook_targets.h"
+#include "util/hook_dispatch.h"
+#include "util/memory.h"
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+using int_function = int(*)(int);
+
+constexpr auto kMaxHandlers = 5;
+
+template<int N>
+int handler(int x)
+{
+	return ((int_function)HookGetOriginal<handler<N>>())(x) + 1;
+}
+
+template<int N>
+int tls_handler(int x)
+{
+	return ((int_function)HookGetOriginal())(x) + 1;
+}
+
+const void *const kHandlers[] = {
+	(const void*)handler<0>, (const void*)handler<1>, (const void*)handler<2>,
+	(const void*)handler<3>, (const void*)handler<4>
+};
+
+const void **const kSlots[] = {
+	&detail::hook::static_original<handler<0>>, &detail::hook::static_original<handler<1>>,
+	&detail::hook::static_original<handler<2>>, &detail::hook::static_original<handler<3>>,
+	&detail::hook::static_original<handler<4>>
+};
+
+const void *const kTlsHandlers[] = {
+	(const void*)tls_handler<0>, (const void*)tls_handler<1>, (const void*)tls_handler<2>,
+	(const void*)tls_handler<3>, (const void*)tls_handler<4>
+};
+
+static_assert(std::size(kHandlers) == kMaxHandlers);
+
+int g_calls;
+
+// ns per call of function
+double TimeCalls(int_function function)
+{
+	const auto elapsed = bench::BestOf(5, [&] {
+		for (auto i = 0; i < g_calls; i++)
+			bench::DoNotOptimize(function(i));
+	});
+
+	return elapsed / g_calls;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	g_calls = bench::IsQuick(argc, argv) ? 100000 : 10000000;
+
+	auto *registry = get_hook_dispatch_registry();
+	const auto dispatchSite = (uintptr_t)caller_bench_dispatch_site;
+	const auto chainSite = (uintptr_t)caller_bench_chain_site;
+
+	const auto base = TimeCalls(caller_bench_dispatch);
+	printf("unhooked call: %.2f ns\n", base);
+
+	for (const auto count : {1, 2, 5}) {
+		uintptr_t handles[kMaxHandlers];
+
+		for (auto i = 0; i < count; i++)
+			handles[i] = registry->add(hook_site::call_rel32, dispatchSite, kHandlers[i], kSlots[i], i);
+
+		// Each trampoline patched over the last, so the newest runs first
+		uint8_t saved[5];
+		memcpy(saved, caller_bench_chain_site, sizeof(saved));
+
+		for (auto i = count; i-- > 0;)
+			patch_call_rel32(chainSite, kTlsHandlers[i]);
+
+		// Every handler ran
+		const auto expected = caller_base(3) + count;
+
+		if (caller_bench_dispatch(3) != expected || caller_bench_chain(3) != expected) {
+			printf("%d handlers: wrong result\n", count);
+			return 1;
+		}
+
+		printf(
+			"%d handlers: registry +%.2f ns, chained TLS trampolines +%.2f ns per call\n",
+			count, TimeCalls(caller_bench_dispatch) - base, TimeCalls(caller_bench_chain) - base);
+
+		for (auto i = count; i-- > 0;)
+			registry->remove(handles[i]);
+
+		patch_code(chainSite, saved, sizeof(saved));
+	}
+}
@@ -0,0 +1,103 @@
+// The exact ground move integrator against Euler split into substeps, in time
+// per step and error against Euler over many substeps
+//
+//   exact_bench [--quick]
+#include "bench.h"
+#include "ini.h"
+#include "movement.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace movement;
+
+namespace {
+
+constexpr auto kDeltaTime = 1.f / 30.f;
+constexpr auto kReferenceSubsteps = 4096;
+
+struct Case {
+	MoveParams move;
+	MoveInput input;
+	vec3 velocity;
+};
+
+// Ground states around the stop and max speeds, turning to new directions
+std::vector<Case> MakeCases(size_t count)
+{
+	auto rng = std::mt19937(1);
+	auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+	auto cases = std::vector<Case>(count);
+
+	for (size_t i = 0; i < count; i++) {
+		const auto normal = i % 3 != 0
+			? vec3(0.f, 0.f, 1.f)
+			: vec3(unit(rng) * .5f, unit(rng) * .5f, 1.f).normalized();
+		const auto scale = i % 4 == 0 ? 4.f : i % 4 == 1 ? 12.f : 30.f;
+
+		cases[i] = {
+			.move = {
+				.forward      = vec3(1.f, 0.f, 0.f),
+				.up           = vec3(0.f, 0.f, 1.f),
+				.groundNormal = normal
+			},
+			.input = {
+				.moveFlags = ((uint32_t)rng() & kMoveMask) | kMoveFlag_Forward,
+				.moveSpeed = 8.f + unit(rng) * 4.f
+			},
+			.velocity = vec3(unit(rng), unit(rng), 0.f) * scale
+		};
+	}
+
+	return cases;
+}
+
+vec3 Step(const Case &c, Integrator integrator, int substeps)
+{
+	const auto &settings = ini::Get();
+	auto velocity = c.velocity;
+
+	for (auto i = 0; i < substeps; i++)
+		UpdateVelocity(settings, c.move, c.input, &velocity, kDeltaTime / (float)substeps, integrator);
+
+	return velocity;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto quick = bench::IsQuick(argc, argv);
+	const auto cases = MakeCases(quick ? 64 : 4096);
+	const auto repeats = quick ? 1 : 50;
+
+	auto reference = std::vector<vec3>();
+	for (const auto &c : cases)
+		reference.push_back(Step(c, Integrator::Euler, kReferenceSubsteps));
+
+	const auto run = [&](const char *name, Integrator integrator, int substeps) {
+		auto maxError = 0.f;
+
+		for (size_t i = 0; i < cases.size(); i++) {
+			const auto error = (Step(cases[i], integrator, substeps) - reference[i]).length();
+			maxError = std::max(maxError, error / std::max(1.f, reference[i].length()));
+		}
+
+		const auto time = bench::BestOf(3, [&] {
+			for (auto repeat = 0; repeat < repeats; repeat++) {
+				for (const auto &c : cases)
+					bench::DoNotOptimize(Step(c, integrator, substeps));
+			}
+		});
+
+		printf(
+			"%-6s %3d substeps: %8.2f ns/step, max relative error %.2e\n",
+			name, substeps, time / (double)(cases.size() * repeats), maxError);
+	};
+
+	run("exact", Integrator::Exact, 1);
+
+	for (const auto substeps : {1, 4, 16, 64})
+		run("euler", Integrator::Euler, substeps);
+}
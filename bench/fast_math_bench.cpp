@@ -0,0 +1,67 @@
+// fast_math throughput against the exact functions
+//
+//   fast_math_bench [--quick]
+#include "bench.h"
+#include "util/fast_math.h"
+#include "util/vector.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kCount = 4096;
+
+// ns per call of op over every input
+template<typename T>
+double Time(const std::vector<T> &inputs, size_t repeats, auto &&op)
+{
+	const auto time = bench::BestOf(3, [&] {
+		for (size_t repeat = 0; repeat < repeats; repeat++) {
+			for (const auto &input : inputs)
+				bench::DoNotOptimize(op(input));
+		}
+	});
+
+	return time / (double)(inputs.size() * repeats);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto repeats = bench::IsQuick(argc, argv) ? (size_t)1 : (size_t)2000;
+	auto rng = std::mt19937(1);
+	auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+
+	auto scalars = std::vector<float>();
+	auto exponents = std::vector<float>();
+	auto vectors = std::vector<vec3>();
+
+	for (size_t i = 0; i < kCount; i++) {
+		scalars.push_back(std::ldexp(1.f + unit(rng), (int)(rng() % 64) - 32));
+		exponents.push_back(unit(rng) * 20.f);
+		vectors.push_back(vec3(unit(rng), unit(rng), unit(rng)) * 100.f);
+	}
+
+	const auto report = [](const char *name, double fast, double exact) {
+		printf("%-10s fast %.2f ns, exact %.2f ns (%.2fx)\n", name, fast, exact, exact / fast);
+	};
+
+	report("rsqrt",
+		Time(scalars, repeats, [](float x) { return fast_math::rsqrt(x); }),
+		Time(scalars, repeats, [](float x) { return 1.f / std::sqrt(x); }));
+
+	report("exp2",
+		Time(exponents, repeats, [](float x) { return fast_math::exp2(x); }),
+		Time(exponents, repeats, [](float x) { return exp2f(x); }));
+
+	report("length",
+		Time(vectors, repeats, [](const vec3 &v) { return fast_math::length(v); }),
+		Time(vectors, repeats, [](const vec3 &v) { return v.length(); }));
+
+	report("normalized",
+		Time(vectors, repeats, [](const vec3 &v) { return fast_math::normalized(v); }),
+		Time(vectors, repeats, [](const vec3 &v) { return v.normalized(); }));
+}
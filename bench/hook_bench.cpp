@@ -0,0 +1,84 @@
+// Cost of installing each kind of hook and of calling through it
+//
+//   hook_bench [--quick]
+#include "bench.h"
+#include "hook_targets.h"
+#include "util/hooks.h"
+#include "util/memory.h"
+#include "util/patch_transaction.h"
+#include <cstdio>
+#include <optional>
+
+namespace {
+
+using int_function = int(*)(int);
+
+int hook_tls(int x)
+{
+	return ((int_function)HookGetOriginal())(x);
+}
+
+int hook_static(int x)
+{
+	return ((int_function)HookGetOriginal<hook_static>())(x);
+}
+
+JmpHook<int_function, int_function, int> *g_jmpHook;
+
+int hook_jmp(int x)
+{
+	return g_jmpHook->callOriginal(x);
+}
+
+int g_calls;
+
+// ns per call of function
+double TimeCalls(int_function function)
+{
+	const auto elapsed = bench::BestOf(5, [&] {
+		for (auto i = 0; i < g_calls; i++)
+			bench::DoNotOptimize(function(i));
+	});
+
+	return elapsed / g_calls;
+}
+
+double TimeInstall(auto &&install)
+{
+	return bench::BestOf(1, install) * 1e-3;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	g_calls = bench::IsQuick(argc, argv) ? 100000 : 10000000;
+
+	const auto base = TimeCalls(caller_base);
+	const auto jmpBase = TimeCalls(jmp_target);
+	printf("unhooked call: %.2f ns\n", base);
+
+	// The first install reserves the arena block near the targets
+	const auto tlsInstall = TimeInstall([] {
+		patch_call_rel32((uintptr_t)caller_bench_tls_site, (const void*)hook_tls);
+	});
+
+	auto patches = patch_transaction();
+	const auto staticInstall = TimeInstall([&] {
+		patches.call_rel32(
+			(uintptr_t)caller_bench_static_site, (const void*)hook_static,
+			{}, &detail::hook::static_original<hook_static>);
+		patches.commit();
+	});
+
+	std::optional<JmpHook<int_function, int_function, int>> jmpHook;
+	const auto jmpInstall = TimeInstall([&] {
+		jmpHook.emplace((void*)jmp_target_bench, hook_jmp);
+	});
+
+	g_jmpHook = &*jmpHook;
+
+	printf("TLS trampoline: install %.1f us, +%.2f ns/call\n", tlsInstall, TimeCalls(caller_bench_tls) - base);
+	printf("static call hook: install %.1f us, +%.2f ns/call\n", staticInstall, TimeCalls(caller_bench_static) - base);
+	printf("JmpHook: install %.1f us, +%.2f ns/call\n", jmpInstall, TimeCalls(jmp_target_bench) - jmpBase);
+}
@@ -0,0 +1,147 @@
+// matrix operations on the SSE path against the same operations on the
+// generic path, and batched transforms against transforming one at a time
+//
+//   matrix_bench [--quick]
+#include "bench.h"
+#include "util/matrix.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+// A float without an SSE specialization, so matrices of it take the generic
+// path with the same float operations
+struct scalar_float {
+	float value;
+
+	constexpr scalar_float operator+(scalar_float other) const { return {value + other.value}; }
+	constexpr scalar_float operator-(scalar_float other) const { return {value - other.value}; }
+	constexpr scalar_float operator*(scalar_float other) const { return {value * other.value}; }
+	constexpr scalar_float operator/(scalar_float other) const { return {value / other.value}; }
+	constexpr scalar_float operator-() const { return {-value}; }
+	constexpr bool operator==(scalar_float other) const { return value == other.value; }
+};
+
+constexpr size_t kCount = 1024;
+
+// Well conditioned matrices, so every inverse exists
+template<typename T>
+struct Arrays {
+	std::vector<matrix<T, 4, 4>> a;
+	std::vector<matrix<T, 3, 4>> c;
+	std::vector<matrix<T, 4, 4>> out;
+	std::vector<matrix<T, 3, 4>> affineOut;
+
+	Arrays()
+	{
+		auto rng = std::mt19937(1);
+		auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+		a.resize(kCount);
+		c.resize(kCount);
+		out.resize(kCount);
+		affineOut.resize(kCount);
+
+		for (size_t i = 0; i < kCount; i++) {
+			for (size_t k = 0; k < 16; k++)
+				a[i].elems[k] = T{unit(rng) + (k % 5 == 0 ? 4.f : 0.f)};
+
+			for (size_t k = 0; k < 12; k++)
+				c[i].elems[k] = T{unit(rng) + (k % 5 == 0 ? 4.f : 0.f)};
+		}
+	}
+};
+
+// ns per matrix of op over every matrix
+template<typename T>
+double Time(size_t repeats, auto &&op)
+{
+	static auto arrays = Arrays<T>();
+
+	return bench::BestOf(3, [&] {
+		for (size_t repeat = 0; repeat < repeats; repeat++) {
+			for (size_t i = 0; i < kCount; i++)
+				op(arrays, i);
+
+			bench::DoNotOptimize(arrays.out[0]);
+			bench::DoNotOptimize(arrays.affineOut[0]);
+		}
+	}) / (double)(kCount * repeats);
+}
+
+void Report(const char *name, size_t repeats, auto &&op)
+{
+	printf(
+		"%-15s sse %6.2f ns, generic %6.2f ns\n", name,
+		Time<float>(repeats, op), Time<scalar_float>(repeats, op));
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto quick = bench::IsQuick(argc, argv);
+	const auto repeats = quick ? (size_t)1 : (size_t)5000;
+
+	Report("4x4 * 4x4", repeats, [](auto &x, size_t i) { x.out[i] = x.a[i] * x.a[(i + 1) % kCount]; });
+	Report("3x4 * 4x4", repeats, [](auto &x, size_t i) { x.affineOut[i] = x.c[i] * x.a[i]; });
+
+	Report("affine_multiply", repeats, [](auto &x, size_t i) {
+		x.affineOut[i] = affine_multiply(x.c[i], x.c[(i + 1) % kCount]);
+	});
+
+	Report("transposed", repeats, [](auto &x, size_t i) { x.out[i] = x.a[i].transposed(); });
+	Report("inverse", repeats, [](auto &x, size_t i) { x.out[i] = *inverse(x.a[i]); });
+	Report("affine_inverse", repeats, [](auto &x, size_t i) { x.affineOut[i] = *affine_inverse(x.c[i]); });
+
+	// In cache and well out of it
+	const auto m = Arrays<float>().c[5];
+
+	for (const auto count : {(size_t)4096, (size_t)1 << 22}) {
+		auto in = std::vector<vec3>(count);
+		auto out = std::vector<vec3>(count);
+
+		for (size_t i = 0; i < count; i++)
+			in[i] = vec3((float)i, (float)i * .5f, 1.f);
+
+		const auto passes = quick ? (size_t)1 : std::max(((size_t)64 << 20) / count, (size_t)4);
+		const auto total = (double)(count * passes);
+
+		const auto points = bench::BestOf(3, [&] {
+			for (size_t pass = 0; pass < passes; pass++) {
+				transform_points(m, in, out);
+				bench::DoNotOptimize(out[0]);
+			}
+		});
+
+		const auto singlePoints = bench::BestOf(3, [&] {
+			for (size_t pass = 0; pass < passes; pass++) {
+				for (size_t i = 0; i < count; i++)
+					out[i] = transform_point(m, in[i]);
+
+				bench::DoNotOptimize(out[0]);
+			}
+		});
+
+		const auto directions = bench::BestOf(3, [&] {
+			for (size_t pass = 0; pass < passes; pass++) {
+				transform_directions(m, in, out);
+				bench::DoNotOptimize(out[0]);
+			}
+		});
+
+		const auto singleDirections = bench::BestOf(3, [&] {
+			for (size_t pass = 0; pass < passes; pass++) {
+				for (size_t i = 0; i < count; i++)
+					out[i] = transform_direction(m, in[i]);
+
+				bench::DoNotOptimize(out[0]);
+			}
+		});
+
+		printf(
+			"%7zu vec3s: transform_points %.2f ns, transform_point %.2f ns, "
+			"transform_directions %.2f ns, transform_direction %.2f ns\n",
+			count, points / total, singlePoints / total, directions / total, singleDirections / total);
+	}
+}
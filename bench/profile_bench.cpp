@@ -0,0 +1,92 @@
+// UpdateVelocity instantiated for ConstantProfile<profiles::Default> against
+// RuntimeProfile reading the same values from a snapshot, over the same inputs
+//
+//   profile_bench [--quick]
+#include "bench.h"
+#include "ini.h"
+#include "movement.h"
+#include "movement_profiles.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace movement;
+
+namespace {
+
+constexpr auto kDeltaTime = 1.f / 60.f;
+
+struct Case {
+	MoveParams move;
+	MoveInput input;
+	vec3 velocity;
+};
+
+// Ground and air states on flat ground and slopes, with random keys held
+std::vector<Case> MakeCases(size_t count)
+{
+	auto rng = std::mt19937(1);
+	auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+	auto cases = std::vector<Case>(count);
+
+	for (size_t i = 0; i < count; i++) {
+		const auto normal = i % 3 != 0
+			? vec3(0.f, 0.f, 1.f)
+			: vec3(unit(rng) * .5f, unit(rng) * .5f, 1.f).normalized();
+
+		cases[i] = {
+			.move = {
+				.forward      = vec3(1.f, 0.f, 0.f),
+				.up           = vec3(0.f, 0.f, 1.f),
+				.groundNormal = normal
+			},
+			.input = {
+				.moveFlags = (uint32_t)rng() & kMoveMask,
+				.moveSpeed = 8.f + unit(rng) * 4.f,
+				.inAir     = i % 4 == 0
+			},
+			.velocity = vec3(unit(rng), unit(rng), 0.f) * 20.f
+		};
+	}
+
+	return cases;
+}
+
+// ns per UpdateVelocity call of Profile's instantiation
+template<typename Profile>
+double Time(const std::vector<Case> &cases, size_t repeats, Integrator integrator)
+{
+	const auto &snapshot = ini::Get();
+	auto velocities = std::vector<vec3>(cases.size());
+
+	return bench::BestOf(3, [&] {
+		for (size_t repeat = 0; repeat < repeats; repeat++) {
+			for (size_t i = 0; i < cases.size(); i++) {
+				velocities[i] = cases[i].velocity;
+				UpdateVelocity<Profile>(
+					snapshot, cases[i].move, cases[i].input, &velocities[i], kDeltaTime, integrator);
+			}
+
+			bench::DoNotOptimize(velocities[0]);
+		}
+	}) / (double)(cases.size() * repeats);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto quick = bench::IsQuick(argc, argv);
+	const auto cases = MakeCases(1024);
+	const auto repeats = quick ? (size_t)1 : (size_t)5000;
+
+	// The published snapshot holds the INI defaults, the same as profiles::Default
+	for (const auto integrator : {Integrator::Euler, Integrator::Exact}) {
+		const auto constant = Time<ConstantProfile<profiles::Default>>(cases, repeats, integrator);
+		const auto runtime = Time<RuntimeProfile>(cases, repeats, integrator);
+
+		printf(
+			"%-5s: ConstantProfile<Default> %.2f ns, RuntimeProfile %.2f ns (%.2fx)\n",
+			integrator == Integrator::Euler ? "euler" : "exact", constant, runtime, runtime / constant);
+	}
+}
@@ -0,0 +1,88 @@
+// Composing and applying rotations as quats, on the SSE and scalar paths,
+// against the same rotations as matrix3x3
+//
+//   quat_bench [--quick]
+#include "bench.h"
+#include "util/quat.h"
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr size_t kCount = 1024;
+
+struct Arrays {
+	std::vector<quat> quats;
+	std::vector<matrix3x3> matrices;
+	std::vector<vec3> vectors;
+	std::vector<quat> quatOut;
+	std::vector<matrix3x3> matrixOut;
+	std::vector<vec3> vectorOut;
+
+	Arrays()
+	{
+		for (size_t i = 0; i < kCount; i++) {
+			const auto q = quat::from_axis_angle(vec3(0.f, .6f, .8f), (float)i * .01f);
+			quats.push_back(q);
+			matrices.push_back(quat::to_matrix(q));
+			vectors.push_back(vec3((float)i, 1.f, 2.f));
+		}
+
+		quatOut.resize(kCount);
+		matrixOut.resize(kCount);
+		vectorOut.resize(kCount);
+	}
+};
+
+// ns per rotation of op over every element
+double Time(size_t repeats, auto &&op)
+{
+	static auto arrays = Arrays();
+
+	return bench::BestOf(3, [&] {
+		for (size_t repeat = 0; repeat < repeats; repeat++) {
+			for (size_t i = 0; i < kCount; i++)
+				op(arrays, i);
+
+			bench::DoNotOptimize(arrays.quatOut[0]);
+			bench::DoNotOptimize(arrays.matrixOut[0]);
+			bench::DoNotOptimize(arrays.vectorOut[0]);
+		}
+	}) / (double)(kCount * repeats);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto repeats = bench::IsQuick(argc, argv) ? (size_t)1 : (size_t)10000;
+
+	const auto compose = Time(repeats, [](Arrays &x, size_t i) {
+		x.quatOut[i] = quat::multiply(x.quats[i], x.quats[(i + 1) % kCount]);
+	});
+
+	const auto composeScalar = Time(repeats, [](Arrays &x, size_t i) {
+		x.quatOut[i] = detail::quat_scalar::multiply(x.quats[i], x.quats[(i + 1) % kCount]);
+	});
+
+	const auto composeMatrix = Time(repeats, [](Arrays &x, size_t i) {
+		x.matrixOut[i] = x.matrices[i] * x.matrices[(i + 1) % kCount];
+	});
+
+	const auto rotate = Time(repeats, [](Arrays &x, size_t i) {
+		x.vectorOut[i] = quat::rotate(x.quats[i], x.vectors[i]);
+	});
+
+	const auto rotateScalar = Time(repeats, [](Arrays &x, size_t i) {
+		x.vectorOut[i] = detail::quat_scalar::rotate(x.quats[i], x.vectors[i]);
+	});
+
+	const auto rotateMatrix = Time(repeats, [](Arrays &x, size_t i) {
+		const auto &v = x.vectors[i];
+		const auto product = x.matrices[i] * matrix<float, 3, 1>(v.x, v.y, v.z);
+		x.vectorOut[i] = vec3(product.elems[0], product.elems[1], product.elems[2]);
+	});
+
+	printf("compose: quat %.2f ns, scalar quat %.2f ns, matrix3x3 %.2f ns\n", compose, composeScalar, composeMatrix);
+	printf("rotate:  quat %.2f ns, scalar quat %.2f ns, matrix3x3 %.2f ns\n", rotate, rotateScalar, rotateMatrix);
+}
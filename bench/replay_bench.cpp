@@ -0,0 +1,195 @@
+// Replays movement frames through the movement core and reports throughput
+//
+//   replay_bench [options]
+//
+//   --frames <n>      frames to replay, cycling through the frame set
+//   --trace <file>    replay the MoveCharacter steps of a bTrace recording
+//                     instead of synthetic frames
+//   --profile <n>     iProfile
+//   --integrator <n>  iIntegrator
+//   --fixed <tick>    fFixedTimestep
+//   --fast-math       bFastMath=1
+//   --quick           few frames, for ctest
+#include "bench.h"
+#include "ini.h"
+#include "movement.h"
+#include "movement_profiles.h"
+#include "trace_format.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using namespace movement;
+
+namespace {
+
+// hkpCharacterState::StateType
+constexpr uint8_t kHkStateInAir = 2;
+
+struct Frame {
+	MoveParams move;
+	MoveInput input;
+	vec3 velocity;
+	float deltaTime;
+};
+
+vec3 ToVec3(const trace::TraceVec3 &vector)
+{
+	return vec3(vector.x, vector.y, vector.z);
+}
+
+// Runs of held keys over flat ground and slopes, with jumps and frame time
+// jitter around 60 FPS
+std::vector<Frame> MakeSyntheticFrames(size_t count)
+{
+	auto rng = std::mt19937(1);
+	auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+	auto frames = std::vector<Frame>(count);
+	auto moveFlags = 0u;
+	auto airFrames = 0;
+
+	for (auto &frame : frames) {
+		if (rng() % 30 == 0)
+			moveFlags = rng() & kMoveMask;
+
+		if (airFrames > 0)
+			airFrames--;
+		else if (rng() % 120 == 0)
+			airFrames = 40;
+
+		const auto yaw = unit(rng) * 3.14159265f;
+		const auto normal = rng() % 4 == 0
+			? vec3(unit(rng) * .5f, unit(rng) * .5f, 1.f).normalized()
+			: vec3(0.f, 0.f, 1.f);
+
+		frame = {
+			.move = {
+				.forward      = vec3(std::cos(yaw), std::sin(yaw), 0.f),
+				.up           = vec3(0.f, 0.f, 1.f),
+				.groundNormal = normal
+			},
+			.input = {
+				.moveFlags = moveFlags,
+				.moveSpeed = 10.f + unit(rng) * 5.f,
+				.inAir     = airFrames > 0
+			},
+			.velocity  = vec3(unit(rng) * 20.f, unit(rng) * 20.f, 0.f),
+			.deltaTime = 1.f / 60.f + unit(rng) * .002f
+		};
+	}
+
+	return frames;
+}
+
+// Traces don't record the mover's speed, so the Havok max speed stands in
+// for it
+std::vector<Frame> LoadTraceFrames(const char *path)
+{
+	auto *file = fopen(path, "rb");
+
+	if (file == nullptr) {
+		perror(path);
+		exit(1);
+	}
+
+	auto header = trace::TraceHeader();
+	auto frames = std::vector<Frame>();
+
+	if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != trace::kTraceMagic ||
+	    header.recordSize != sizeof(trace::TraceRecord)) {
+		fprintf(stderr, "%s: not a trace\n", path);
+		exit(1);
+	}
+
+	auto record = trace::TraceRecord();
+
+	while (fread(&record, sizeof(record), 1, file) == 1) {
+		if (record.kind != trace::kTraceKind_MoveCharacter || !(record.flags & trace::kTraceFlag_HasParams))
+			continue;
+
+		const auto &params = record.params;
+		frames.push_back({
+			.move = {
+				.forward      = ToVec3(params.forward),
+				.up           = ToVec3(params.up),
+				.groundNormal = ToVec3(params.groundNormal)
+			},
+			.input = {
+				.moveFlags = record.moveFlags,
+				.moveSpeed = params.maxSpeed,
+				.inAir     = record.hkState == kHkStateInAir
+			},
+			.velocity  = ToVec3(record.velocityIn),
+			.deltaTime = record.deltaTime
+		});
+	}
+
+	fclose(file);
+
+	if (frames.empty()) {
+		fprintf(stderr, "%s: no MoveCharacter steps with params\n", path);
+		exit(1);
+	}
+
+	return frames;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	auto frameCount = bench::IsQuick(argc, argv) ? (size_t)10000 : (size_t)4000000;
+	const char *tracePath = nullptr;
+	auto settings = ini::Settings();
+
+	for (auto i = 1; i < argc; i++) {
+		const auto arg = std::string_view(argv[i]);
+		const auto *value = i + 1 < argc ? argv[i + 1] : "0";
+
+		if (arg == "--frames")
+			frameCount = strtoull(value, nullptr, 10), i++;
+		else if (arg == "--trace")
+			tracePath = value, i++;
+		else if (arg == "--profile")
+			settings.iProfile = atoi(value), i++;
+		else if (arg == "--integrator")
+			settings.iIntegrator = atoi(value), i++;
+		else if (arg == "--fixed")
+			settings.fFixedTimestep = strtof(value, nullptr), i++;
+		else if (arg == "--fast-math")
+			settings.bFastMath = 1;
+	}
+
+	// Big enough to defeat branch prediction, small enough to stay in cache
+	const auto frames = tracePath != nullptr ? LoadTraceFrames(tracePath) : MakeSyntheticFrames(4096);
+	const auto &profile = GetProfileKernels(settings.iProfile);
+	const auto integrator = static_cast<Integrator>(settings.iIntegrator);
+	auto fixedStep = FixedStepState();
+	auto velocity = vec3(0.f, 0.f, 0.f);
+
+	const auto elapsed = bench::BestOf(3, [&] {
+		for (size_t i = 0; i < frameCount; i++) {
+			const auto &frame = frames[i % frames.size()];
+
+			// Recorded velocities already include collisions
+			if (tracePath != nullptr)
+				velocity = frame.velocity;
+
+			if (settings.fFixedTimestep > 0.f) {
+				profile.updateVelocityFixed(
+					settings, frame.move, frame.input, &fixedStep, &velocity,
+					frame.deltaTime, settings.fFixedTimestep, settings.iMaxSubsteps, integrator);
+			} else {
+				profile.updateVelocity(settings, frame.move, frame.input, &velocity, frame.deltaTime, integrator);
+			}
+
+			bench::DoNotOptimize(velocity);
+		}
+	});
+
+	printf(
+		"%zu frames (%zu distinct): %.0f frames/s, %.2f ns/frame\n",
+		frameCount, frames.size(), frameCount / (elapsed * 1e-9), elapsed / frameCount);
+}
@@ -0,0 +1,102 @@
+// state_table lookups and updates against std::unordered_map, with thousands
+// of controllers
+//
+//   state_table_bench [--quick]
+#include "bench.h"
+#include "util/state_table.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// About the size of the plugin's per-controller state
+struct State {
+	float velocity[4];
+	float airVelocity[4];
+	uint32_t steps;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto lookups = bench::IsQuick(argc, argv) ? (size_t)10000 : (size_t)10000000;
+	auto rng = std::mt19937(1);
+
+	for (const auto count : {(size_t)1000, (size_t)3000}) {
+		// Heap objects standing in for character controllers
+		std::vector<std::unique_ptr<std::byte[]>> objects;
+		std::vector<const void*> order;
+
+		for (size_t i = 0; i < count; i++)
+			order.push_back(objects.emplace_back(std::make_unique<std::byte[]>(0x400)).get());
+
+		auto table = std::make_unique<state_table<State, 4096>>();
+		auto map = std::unordered_map<const void*, State>();
+
+		for (const auto *object : order) {
+			table->find_or_insert(object);
+			map[object];
+		}
+
+		std::ranges::shuffle(order, rng);
+
+		const auto timeTable = bench::BestOf(3, [&] {
+			for (size_t i = 0; i < lookups; i++) {
+				auto *state = table->find(order[i % count]);
+				state->steps++;
+				bench::DoNotOptimize(state);
+			}
+		});
+
+		const auto timeMap = bench::BestOf(3, [&] {
+			for (size_t i = 0; i < lookups; i++) {
+				auto &state = map.find(order[i % count])->second;
+				state.steps++;
+				bench::DoNotOptimize(state);
+			}
+		});
+
+		printf(
+			"%zu entries: state_table %.2f ns, unordered_map %.2f ns per lookup and update\n",
+			count, timeTable / lookups, timeMap / lookups);
+	}
+
+	// Lookups of objects without state, such as NPC controllers, after every
+	// controller has been recreated many times over
+	for (const auto generations : {(size_t)1, (size_t)100}) {
+		constexpr size_t count = 256;
+		auto table = std::make_unique<state_table<State, 4096>>();
+		std::vector<std::unique_ptr<std::byte[]>> objects;
+		std::vector<std::unique_ptr<std::byte[]>> missing;
+
+		// Earlier generations stay allocated so addresses aren't reused
+		for (size_t generation = 0; generation < generations; generation++) {
+			const auto first = objects.size();
+
+			for (size_t i = 0; i < count; i++)
+				table->find_or_insert(objects.emplace_back(std::make_unique<std::byte[]>(0x400)).get());
+
+			if (generation + 1 < generations) {
+				for (size_t i = first; i < objects.size(); i++)
+					table->erase(objects[i].get());
+			}
+		}
+
+		for (size_t i = 0; i < count; i++)
+			missing.push_back(std::make_unique<std::byte[]>(0x400));
+
+		const auto timeMiss = bench::BestOf(3, [&] {
+			for (size_t i = 0; i < lookups; i++)
+				bench::DoNotOptimize(table->find(missing[i % count].get()));
+		});
+
+		printf(
+			"%zu entries, %zu generations: state_table %.2f ns per miss\n",
+			count, generations, timeMiss / lookups);
+	}
+}
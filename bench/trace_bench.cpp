@@ -0,0 +1,66 @@
+// Cost of trace::Record on the hot path, from one thread and from several at
+// once, with the flush thread draining to a file
+//
+//   trace_bench [--quick]
+#include "bench.h"
+#include "trace.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Under the ring's size, so bursts aren't dropped
+constexpr uint32_t kBurst = 1024;
+
+// ns per Record, with each of threadCount threads recording bursts
+double TimeRecord(uint32_t threadCount, int bursts)
+{
+	auto best = 1e18;
+
+	for (auto burst = 0; burst < bursts; burst++) {
+		// Let the flush thread empty the ring
+		std::this_thread::sleep_for(std::chrono::milliseconds(12));
+
+		std::vector<std::thread> threads;
+
+		for (uint32_t t = 0; t < threadCount; t++) {
+			threads.emplace_back([&best, t] {
+				const auto time = bench::BestOf(1, [t] {
+					for (uint32_t i = 0; i < kBurst; i++)
+						trace::Record({.controller = t, .moveFlags = i});
+				});
+
+				// The first thread's time stands for the burst
+				if (t == 0)
+					best = std::min(best, time / kBurst);
+			});
+		}
+
+		for (auto &thread : threads)
+			thread.join();
+	}
+
+	return best;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto bursts = bench::IsQuick(argc, argv) ? 1 : 50;
+	const auto path = (std::filesystem::temp_directory_path() / "trace_bench.trace").string();
+
+	if (!trace::Start(path.c_str(), (size_t)kBurst * 4 * bursts * 2)) {
+		fprintf(stderr, "can't create %s\n", path.c_str());
+		return 1;
+	}
+
+	for (const auto threadCount : {1u, 2u, 4u})
+		printf("%u threads: %.2f ns per record\n", threadCount, TimeRecord(threadCount, bursts));
+
+	trace::Stop();
+	std::filesystem::remove(path);
+}
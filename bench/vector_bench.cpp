@@ -0,0 +1,126 @@
+// vec3 and vec4 operations against the same operations on the scalar path,
+// over arrays of vectors. vec4 goes through SSE.
+//
+// Unoptimized builds take microseconds per element on the scalar path, where
+// every foreach lambda is a call, so time those with --quick.
+//
+//   vector_bench [--quick]
+#include "bench.h"
+#include "util/vector.h"
+#include <cstdio>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// The same layouts without an SSE specialization
+struct scalar_vec3_base : vec3_base<float> {};
+struct scalar_vec4_base : vec4_base<float> {};
+
+using scalar_vec3 = vec_impl<scalar_vec3_base>;
+using scalar_vec4 = vec_impl<scalar_vec4_base>;
+
+constexpr size_t kCount = 4096;
+
+template<typename V>
+struct Arrays {
+	std::vector<V> a;
+	std::vector<V> b;
+	std::vector<V> out;
+	std::vector<float> sums;
+
+	Arrays()
+	{
+		auto rng = std::mt19937(1);
+		auto unit = std::uniform_real_distribution<float>(-100.f, 100.f);
+
+		for (size_t i = 0; i < kCount; i++) {
+			V va, vb;
+			va.foreach([&](float &x) { x = unit(rng); });
+			vb.foreach([&](float &x) { x = unit(rng); });
+			a.push_back(va);
+			b.push_back(vb);
+		}
+
+		out.resize(kCount);
+		sums.resize(kCount);
+	}
+};
+
+// ns per element of op over every element
+template<typename V>
+double Time(size_t repeats, auto &&op)
+{
+	static auto arrays = Arrays<V>();
+
+	return bench::BestOf(3, [&] {
+		for (size_t repeat = 0; repeat < repeats; repeat++) {
+			for (size_t i = 0; i < kCount; i++)
+				op(arrays, i);
+
+			bench::DoNotOptimize(arrays.out[0]);
+			bench::DoNotOptimize(arrays.sums[0]);
+		}
+	}) / (double)(kCount * repeats);
+}
+
+void Report(const char *name, size_t repeats, auto &&op)
+{
+	printf(
+		"%-12s vec3 %5.2f ns, scalar %5.2f ns   vec4 %5.2f ns, scalar %5.2f ns\n", name,
+		Time<vec3>(repeats, op), Time<scalar_vec3>(repeats, op),
+		Time<vec4>(repeats, op), Time<scalar_vec4>(repeats, op));
+}
+
+// Cross is only defined on vec3
+void Report3(const char *name, size_t repeats, auto &&op)
+{
+	printf(
+		"%-12s vec3 %5.2f ns, scalar %5.2f ns\n", name,
+		Time<vec3>(repeats, op), Time<scalar_vec3>(repeats, op));
+}
+
+template<typename T>
+using vec_of = std::remove_cvref_t<decltype(std::declval<T>().a[0])>;
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const auto repeats = bench::IsQuick(argc, argv) ? (size_t)1 : (size_t)2000;
+
+	Report("add", repeats, [](auto &x, size_t i) { x.out[i] = x.a[i] + x.b[i]; });
+	Report("scale", repeats, [](auto &x, size_t i) { x.out[i] = x.a[i] * .5f; });
+	Report("divide", repeats, [](auto &x, size_t i) { x.out[i] = x.a[i] / 1.5f; });
+	Report("subtract_eq", repeats, [](auto &x, size_t i) { x.out[i] -= x.a[i]; });
+	Report("negate", repeats, [](auto &x, size_t i) { x.out[i] = -x.a[i]; });
+	Report("abs", repeats, [](auto &x, size_t i) { x.out[i] = x.a[i].abs(); });
+
+	Report("dot", repeats, [](auto &x, size_t i) {
+		using V = vec_of<decltype(x)>;
+		x.sums[i] = V::dot(x.a[i], x.b[i]);
+	});
+
+	Report("min", repeats, [](auto &x, size_t i) {
+		using V = vec_of<decltype(x)>;
+		x.out[i] = V::min(x.a[i], x.b[i]);
+	});
+
+	Report("equal", repeats, [](auto &x, size_t i) { x.sums[i] = x.a[i] == x.b[i]; });
+	Report("normalized", repeats, [](auto &x, size_t i) { x.out[i] = x.a[i].normalized(); });
+
+	Report3("cross", repeats, [](auto &x, size_t i) {
+		using V = vec_of<decltype(x)>;
+		x.out[i] = V(V::cross(x.a[i], x.b[i]));
+	});
+
+	// A chain of the above as the movement code writes them
+	Report("mixed", repeats, [](auto &x, size_t i) {
+		using V = vec_of<decltype(x)>;
+		auto v = x.a[i] + x.b[i] * .25f;
+		v -= V::min(v, x.b[i]);
+		x.sums[i] += V::dot(v.normalized(), x.b[i]);
+		x.out[i] = v / 1.5f;
+	});
+}
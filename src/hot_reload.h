@@ -0,0 +1,56 @@
+#pragma once
+
+#include "movement.h"
+#include <cstdint>
+
+// Replacing the running plugin with a new build without restarting the game.
+// The running build reverts its patches, waits for its hooks to return and
+// stops its threads, then hands its state to the new build, which installs
+// its own patches. Superseded builds stay loaded, so a hook that was entered
+// as its patch was reverted can still return.
+namespace hot_reload {
+
+// Bump when Handoff changes, builds with another version start fresh
+constexpr uint32_t kHandoffVersion = 3;
+
+using ReloadFunction = bool(*)();
+
+// Values for SetEnabledFunction besides 0 and 1
+constexpr int kEnabledToggle = -1;
+constexpr int kEnabledQuery = -2;
+
+// Enable or disable the patches, returning whether they're enabled
+using SetEnabledFunction = bool(*)(int enabled);
+
+struct PlayerState {
+	const void *controller;
+	float airVelocity[4];
+	bool usedJumpInput;
+	bool justLanded;
+	movement::FixedStepState fixedStep;
+};
+
+struct Handoff {
+	uint32_t version;
+	uint32_t size;
+	// Commands stay registered to the first build loaded, which reloads
+	// through whichever build the current one points this at
+	ReloadFunction *current;
+	bool hasPlayer;
+	PlayerState player;
+	// Whether the patches were enabled, and where the first build's enable
+	// commands look for the current build
+	bool enabled;
+	SetEnabledFunction *currentSetEnabled;
+};
+
+// Exported by each build as PlayerPhysics_HotLoad
+using HotLoadFunction = bool(*)(const Handoff *handoff);
+
+// Load a copy of the build at path, so the file can be rebuilt while the copy
+// is loaded. Returns nullptr if it can't be loaded or has no PlayerPhysics_HotLoad.
+HotLoadFunction LoadBuild(const char *path, void **module);
+
+void UnloadBuild(void *module);
+
+} // namespace hot_reload
@@ -0,0 +1,61 @@
+#include "hot_reload.h"
+#include <atomic>
+#include <cstdio>
+#include <dlfcn.h>
+#include <filesystem>
+#include <unistd.h>
+
+namespace {
+
+// Copies loaded this session
+std::atomic<uint32_t> g_copies;
+
+} // namespace
+
+namespace hot_reload {
+
+HotLoadFunction LoadBuild(const char *path, void **module)
+{
+	auto error = std::error_code();
+	const auto directory = std::filesystem::temp_directory_path(error);
+
+	if (error)
+		return nullptr;
+
+	// Each copy needs its own name, the loader reuses objects by path. Every
+	// build counts its own copies, and builds stay loaded, so the address of
+	// this build's counter keeps different builds' copies apart.
+	char name[64];
+	snprintf(
+		name, sizeof(name), "PlayerPhysics_%d_%llx_%u.so",
+		(int)getpid(), (unsigned long long)(uintptr_t)&g_copies, ++g_copies);
+
+	const auto copyPath = directory / name;
+
+	if (!std::filesystem::copy_file(path, copyPath, std::filesystem::copy_options::overwrite_existing, error))
+		return nullptr;
+
+	// Mapped objects outlive their file, so the copy is removed right away
+	auto *handle = dlopen(copyPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+	std::filesystem::remove(copyPath, error);
+
+	if (handle == nullptr)
+		return nullptr;
+
+	const auto hotLoad = (HotLoadFunction)dlsym(handle, "PlayerPhysics_HotLoad");
+
+	if (hotLoad == nullptr) {
+		dlclose(handle);
+		return nullptr;
+	}
+
+	*module = handle;
+	return hotLoad;
+}
+
+void UnloadBuild(void *module)
+{
+	dlclose(module);
+}
+
+} // namespace hot_reload
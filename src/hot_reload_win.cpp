@@ -0,0 +1,65 @@
+#include "hot_reload.h"
+#include <atomic>
+#include <cstdio>
+#include <Windows.h>
+
+namespace {
+
+// Copies loaded this session
+std::atomic<uint32_t> g_copies;
+
+} // namespace
+
+namespace hot_reload {
+
+HotLoadFunction LoadBuild(const char *path, void **module)
+{
+	char directory[MAX_PATH];
+	char copyPath[MAX_PATH];
+
+	const auto length = GetTempPathA(MAX_PATH, directory);
+
+	if (length == 0 || length > MAX_PATH)
+		return nullptr;
+
+	// Each copy needs its own name, the module loader reuses modules by path.
+	// Every build counts its own copies, and builds stay loaded, so the
+	// address of this build's counter keeps different builds' copies apart.
+	snprintf(
+		copyPath, sizeof(copyPath), "%sPlayerPhysics_%lu_%llx_%u.dll",
+		directory, GetCurrentProcessId(), (unsigned long long)(uintptr_t)&g_copies, ++g_copies);
+
+	if (!CopyFileA(path, copyPath, FALSE))
+		return nullptr;
+
+	auto *handle = LoadLibraryA(copyPath);
+
+	if (handle == nullptr) {
+		DeleteFileA(copyPath);
+		return nullptr;
+	}
+
+	const auto hotLoad = (HotLoadFunction)GetProcAddress(handle, "PlayerPhysics_HotLoad");
+
+	if (hotLoad == nullptr) {
+		FreeLibrary(handle);
+		DeleteFileA(copyPath);
+		return nullptr;
+	}
+
+	*module = handle;
+	return hotLoad;
+}
+
+void UnloadBuild(void *module)
+{
+	char path[MAX_PATH];
+	const auto length = GetModuleFileNameA((HMODULE)module, path, MAX_PATH);
+
+	FreeLibrary((HMODULE)module);
+
+	if (length != 0 && length < MAX_PATH)
+		DeleteFileA(path);
+}
+
+} // namespace hot_reload
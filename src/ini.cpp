@@ -0,0 +1,120 @@
+#include "ini.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr auto kSection = std::string_view("Physics");
+
+std::string_view Trim(std::string_view string)
+{
+	constexpr auto whitespace = " \t\r\n";
+	const auto start = string.find_first_not_of(whitespace);
+
+	if (start == std::string_view::npos)
+		return {};
+
+	const auto end = string.find_last_not_of(whitespace);
+	return string.substr(start, end - start + 1);
+}
+
+bool EqualsNoCase(std::string_view a, std::string_view b)
+{
+	return std::ranges::equal(a, b, [](char x, char y) {
+		return std::tolower((unsigned char)x) == std::tolower((unsigned char)y);
+	});
+}
+
+template<typename T>
+void ParseValue(std::string_view string, T *out)
+{
+	auto value = T();
+	const auto *end = string.data() + string.size();
+
+	if (const auto result = std::from_chars(string.data(), end, value); result.ec == std::errc())
+		*out = value;
+}
+
+void ParseSetting(ini::Settings *settings, std::string_view key, std::string_view value)
+{
+#define INI_PARSE(type, name, fallback) \
+	if (EqualsNoCase(key, #name)) \
+		return ParseValue(value, &settings->name);
+
+	INI_SETTINGS(INI_PARSE)
+#undef INI_PARSE
+}
+
+// Enough for a 1/512 s tick at 8 fps, while a typo can't stall a step
+constexpr auto kMaxSubsteps = 64;
+
+// Landing penalties divide by this, so it stays positive
+constexpr auto kMinImpactSpeed50 = 1.f;
+
+// Keep values the movement model can't run with from reaching it
+void Clamp(ini::Settings *settings)
+{
+	settings->iMaxSubsteps = std::clamp(settings->iMaxSubsteps, 1, kMaxSubsteps);
+
+	if (!std::isfinite(settings->fFixedTimestep) || settings->fFixedTimestep < 0.f)
+		settings->fFixedTimestep = 0.f;
+
+	// NaN fails the comparison too
+	if (!(settings->fLandingPenaltyImpactSpeed50 >= kMinImpactSpeed50))
+		settings->fLandingPenaltyImpactSpeed50 = kMinImpactSpeed50;
+}
+
+} // namespace
+
+namespace ini {
+
+void Publish(const Settings &settings)
+{
+	// Readers may hold any snapshot indefinitely, so retain them all. Reloads
+	// are manual edits, so this stays small.
+	static std::mutex mutex;
+	static std::vector<std::unique_ptr<const Settings>> snapshots;
+
+	const auto lock = std::scoped_lock(mutex);
+	const auto &snapshot = snapshots.emplace_back(std::make_unique<const Settings>(settings));
+	detail::current.store(snapshot.get(), std::memory_order_release);
+}
+
+Settings Parse(std::string_view text, const Settings &base)
+{
+	auto settings = base;
+	auto inSection = false;
+
+	while (!text.empty()) {
+		const auto lineEnd = text.find('\n');
+		auto line = Trim(text.substr(0, lineEnd));
+		text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+
+		if (const auto comment = line.find_first_of(";#"); comment != std::string_view::npos)
+			line = Trim(line.substr(0, comment));
+
+		if (line.empty())
+			continue;
+
+		if (line.front() == '[') {
+			const auto close = line.find(']');
+			inSection = close != std::string_view::npos &&
+			            EqualsNoCase(Trim(line.substr(1, close - 1)), kSection);
+			continue;
+		}
+
+		if (const auto equals = line.find('='); inSection && equals != std::string_view::npos)
+			ParseSetting(&settings, Trim(line.substr(0, equals)), Trim(line.substr(equals + 1)));
+	}
+
+	Clamp(&settings);
+	return settings;
+}
+
+} // namespace ini
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+// Tunables read from the [Physics] section of the INI, as (type, name, default)
+//
+// fFixedTimestep: run the movement model in fixed ticks of this many seconds,
+// 0 to step with the frame
+// iMaxSubsteps: most ticks run per frame with fFixedTimestep, 1 to 64
+// iIntegrator: 0 for explicit Euler steps, 1 for closed form integration
+// fLandingPenaltyImpactSpeed50: impact speed that halves velocity on landing,
+// at least 1
+// bFastMath: use approximate square roots and exponentials in the movement
+// model, within ~1e-6 relative error
+// bTrace: record movement steps to player_physics.trace, read at load
+// iTraceMaxRecords: size of the trace file in 128 byte records
+// iInputSampleRate: poll movement and jump keys at this rate in Hz off the
+// frame loop, 0 (default) to only use the game's input. Windows before 10 1803
+// can't wait under a scheduler tick, which caps the rate at about 64 Hz; the
+// achieved rate is in PlayerPhysics_GetInputStats.
+// iKey*: virtual key codes polled by the sampler
+// iProfile: 0 to use the values here, otherwise a built in profile from
+// movement_profiles.h. A profile only replaces fFriction through
+// fLandingPenaltyImpactSpeed50; fFixedTimestep, iMaxSubsteps, iIntegrator and
+// bFastMath choose how the model is stepped and always come from here.
+#define INI_SETTINGS(X) \
+	X(float, fFriction,                    5.f) \
+	X(float, fAcceleration,                6.f) \
+	X(float, fAirAcceleration,             1.f) \
+	X(float, fMinAccelScaleSpeed,          25.f) \
+	X(float, fStopSpeed,                   16.f) \
+	X(float, fAirSpeed,                    1.f) \
+	X(float, fGravityMult,                 2.f) \
+	X(float, fKnockbackScale,              10.f) \
+	X(float, fLandingPenaltyImpactSpeed50, 100.f) \
+	X(float, fFixedTimestep,               0.f) \
+	X(int,   iMaxSubsteps,                 8) \
+	X(int,   iIntegrator,                  0) \
+	X(int,   bFastMath,                    0) \
+	X(int,   iProfile,                     0) \
+	X(int,   iInputSampleRate,             0) \
+	X(int,   iKeyForward,                  'W') \
+	X(int,   iKeyBackward,                 'S') \
+	X(int,   iKeyLeft,                     'A') \
+	X(int,   iKeyRight,                    'D') \
+	X(int,   iKeyJump,                     0x20) \
+	X(int,   bTrace,                       0) \
+	X(int,   iTraceMaxRecords,             1 << 18)
+
+namespace ini {
+
+struct Settings {
+#define INI_DECLARE(type, name, value) type name = value;
+	INI_SETTINGS(INI_DECLARE)
+#undef INI_DECLARE
+};
+
+namespace detail {
+inline constexpr Settings defaults;
+inline std::atomic<const Settings*> current = &defaults;
+}
+
+// Current snapshot. Snapshots are immutable and never freed, so the reference
+// stays valid after a reload. Take it once per update to read consistent values.
+inline const Settings &Get()
+{
+	return *detail::current.load(std::memory_order_acquire);
+}
+
+// Make a copy of settings current
+void Publish(const Settings &settings);
+
+// Apply the [Physics] section of INI text over base. Unknown keys and
+// malformed values are ignored, and out of range values are clamped.
+Settings Parse(std::string_view text, const Settings &base = {});
+
+// Timings of the last reload, taken on the watcher thread
+struct LoadStats {
+	uint32_t reloads;
+	uint32_t parseMicroseconds;
+	uint32_t publishNanoseconds;
+};
+
+// Load the file synchronously, then watch it for changes on a background
+// thread, publishing a new snapshot for each change
+void Load(const char *path);
+void StartWatcher(const char *path);
+void StopWatcher();
+
+LoadStats GetLoadStats();
+
+} // namespace ini
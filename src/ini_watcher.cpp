@@ -0,0 +1,151 @@
+#include "ini.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <Windows.h>
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+// Wait for a save to finish before rereading
+constexpr auto kSettleTime = std::chrono::milliseconds(50);
+
+std::atomic<uint32_t> g_reloads;
+std::atomic<uint32_t> g_parseMicroseconds;
+std::atomic<uint32_t> g_publishNanoseconds;
+
+// A native thread, as a joinable std::thread would terminate on exit
+HANDLE g_watcher;
+HANDLE g_stopEvent;
+std::string g_watchPath;
+
+bool GetWriteTime(const char *path, FILETIME *out)
+{
+	WIN32_FILE_ATTRIBUTE_DATA data;
+
+	if (!GetFileAttributesExA(path, GetFileExInfoStandard, &data))
+		return false;
+
+	*out = data.ftLastWriteTime;
+	return true;
+}
+
+void Reload(const char *path)
+{
+	auto file = std::ifstream(path, std::ios::binary);
+
+	if (!file)
+		return;
+
+	auto stream = std::ostringstream();
+	stream << file.rdbuf();
+	const auto text = std::move(stream).str();
+
+	const auto parseStart = clock::now();
+	// Missing keys keep their defaults rather than the previous values
+	const auto settings = ini::Parse(text);
+	const auto publishStart = clock::now();
+	ini::Publish(settings);
+	const auto publishEnd = clock::now();
+
+	using namespace std::chrono;
+	g_parseMicroseconds = (uint32_t)duration_cast<microseconds>(publishStart - parseStart).count();
+	g_publishNanoseconds = (uint32_t)duration_cast<nanoseconds>(publishEnd - publishStart).count();
+	g_reloads++;
+}
+
+void WatchFile(const std::string &path)
+{
+	// Watch the containing directory, the file itself may be replaced
+	const auto slash = path.find_last_of("\\/");
+	const auto directory = slash != std::string::npos ? path.substr(0, slash) : std::string(".");
+
+	const auto handle = FindFirstChangeNotificationA(
+		directory.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+
+	if (handle == INVALID_HANDLE_VALUE)
+		return;
+
+	auto lastWrite = FILETIME();
+	GetWriteTime(path.c_str(), &lastWrite);
+
+	const HANDLE handles[] = {handle, g_stopEvent};
+
+	while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0) {
+		std::this_thread::sleep_for(kSettleTime);
+
+		if (auto writeTime = FILETIME(); GetWriteTime(path.c_str(), &writeTime)) {
+			if (CompareFileTime(&writeTime, &lastWrite) != 0) {
+				lastWrite = writeTime;
+				Reload(path.c_str());
+			}
+		}
+
+		if (!FindNextChangeNotification(handle))
+			break;
+	}
+
+	FindCloseChangeNotification(handle);
+}
+
+DWORD WINAPI WatchThread(void*)
+{
+	WatchFile(g_watchPath);
+	return 0;
+}
+
+} // namespace
+
+namespace ini {
+
+void Load(const char *path)
+{
+	Reload(path);
+}
+
+void StartWatcher(const char *path)
+{
+	if (g_watcher != nullptr)
+		return;
+
+	g_stopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+	if (g_stopEvent == nullptr)
+		return;
+
+	g_watchPath = path;
+	g_watcher = CreateThread(nullptr, 0, WatchThread, nullptr, 0, nullptr);
+
+	if (g_watcher == nullptr) {
+		CloseHandle(g_stopEvent);
+		g_stopEvent = nullptr;
+	}
+}
+
+void StopWatcher()
+{
+	if (g_watcher == nullptr)
+		return;
+
+	SetEvent(g_stopEvent);
+	WaitForSingleObject(g_watcher, INFINITE);
+	CloseHandle(g_watcher);
+	CloseHandle(g_stopEvent);
+	g_watcher = nullptr;
+	g_stopEvent = nullptr;
+}
+
+LoadStats GetLoadStats()
+{
+	return {
+		.reloads            = g_reloads,
+		.parseMicroseconds  = g_parseMicroseconds,
+		.publishNanoseconds = g_publishNanoseconds
+	};
+}
+
+} // namespace ini
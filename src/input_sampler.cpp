@@ -0,0 +1,126 @@
+#include "input_sampler.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace input {
+
+uint32_t ScriptedInputSource::Poll()
+{
+	const auto now = Now();
+	auto keys = 0u;
+
+	for (const auto &edge : script) {
+		if (edge.timestamp > now)
+			break;
+
+		keys = edge.keys;
+	}
+
+	return keys;
+}
+
+void InputSource::Wait(int64_t ticks)
+{
+	std::this_thread::sleep_for(std::chrono::nanoseconds(ticks * 1'000'000'000 / Frequency()));
+}
+
+void InputSampler::Run(uint32_t keys)
+{
+	while (running.load(std::memory_order_relaxed)) {
+		source->Wait(interval);
+
+		const auto newKeys = source->Poll();
+		const auto now = source->Now();
+		pollCount.fetch_add(1, std::memory_order_relaxed);
+		lastPollTime.store(now, std::memory_order_relaxed);
+
+		if (newKeys == keys)
+			continue;
+
+		keys = newKeys;
+		edgeCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (!edges.push({.timestamp = now, .keys = keys}))
+			droppedCount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void InputSampler::Start(InputSource *newSource, int64_t newInterval)
+{
+	Stop();
+
+	source = newSource;
+	interval = newInterval;
+	edges.clear();
+	lastKeys = source->Poll();
+	lastTime = source->Now();
+	startTime = lastTime;
+	pollCount = 0;
+	lastPollTime = lastTime;
+	running = true;
+
+	// From the keys the consumer starts with, so a change before the thread
+	// runs is still an edge
+	thread = std::thread(&InputSampler::Run, this, lastKeys);
+}
+
+void InputSampler::Stop()
+{
+	if (!running)
+		return;
+
+	running = false;
+	thread.join();
+}
+
+SamplerStats InputSampler::GetStats() const
+{
+	return {
+		.polls        = pollCount.load(std::memory_order_relaxed),
+		.pollTime     = lastPollTime.load(std::memory_order_relaxed) - startTime,
+		.edges        = edgeCount.load(std::memory_order_relaxed),
+		.dropped      = droppedCount.load(std::memory_order_relaxed),
+		.maxLatency   = maxLatency,
+		.totalLatency = totalLatency
+	};
+}
+
+size_t SplitInterval(
+	uint32_t startKeys,
+	std::span<const InputEdge> edges,
+	int64_t start,
+	int64_t end,
+	std::span<InputSegment> out)
+{
+	if (out.empty())
+		return 0;
+
+	const auto length = std::max(end - start, (int64_t)1);
+	auto keys = startKeys;
+	auto time = start;
+	size_t count = 0;
+
+	const auto emit = [&](int64_t until) {
+		const auto fraction = (float)(until - time) / length;
+		time = until;
+
+		if (fraction <= 0.f)
+			return;
+
+		if (count > 0 && (out[count - 1].keys == keys || count == out.size()))
+			out[count - 1].fraction += fraction;
+		else
+			out[count++] = {keys, fraction};
+	};
+
+	for (const auto &edge : edges) {
+		emit(std::clamp(edge.timestamp, time, end));
+		keys = edge.keys;
+	}
+
+	emit(end);
+	return count;
+}
+
+} // namespace input
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "util/spsc_ring.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Key state sampled on a dedicated thread, independent of the frame loop, so
+// the movement step can see edges between frames and when they happened
+namespace input {
+
+enum InputKey : uint8_t {
+	kInputKey_Forward,
+	kInputKey_Backward,
+	kInputKey_Left,
+	kInputKey_Right,
+	kInputKey_Jump,
+	kInputKey_Count
+};
+
+constexpr uint32_t KeyBit(InputKey key)
+{
+	return 1u << key;
+}
+
+constexpr auto kDirectionKeys =
+	KeyBit(kInputKey_Forward) | KeyBit(kInputKey_Backward) |
+	KeyBit(kInputKey_Left)    | KeyBit(kInputKey_Right);
+
+// Held key mask after a change, and when the change was seen
+struct InputEdge {
+	int64_t timestamp;
+	uint32_t keys;
+};
+
+// Raw key state for the sampler to poll
+class InputSource {
+public:
+	virtual ~InputSource() = default;
+	// Mask of held InputKeys
+	virtual uint32_t Poll() = 0;
+	// Timestamp in ticks of Frequency()
+	virtual int64_t Now() = 0;
+	virtual int64_t Frequency() = 0;
+	// Block the sampler thread for about ticks
+	virtual void Wait(int64_t ticks);
+};
+
+// Plays back a list of key masks at set times for headless runs. Time only
+// moves when advanced, so results don't depend on thread scheduling.
+class ScriptedInputSource : public InputSource {
+	std::vector<InputEdge> script;
+	std::atomic<int64_t> time = 0;
+
+public:
+	// Edges in timestamp order, in ticks of one nanosecond
+	explicit ScriptedInputSource(std::vector<InputEdge> script) : script(std::move(script)) {}
+
+	void Advance(int64_t ticks) { time.fetch_add(ticks, std::memory_order_relaxed); }
+
+	uint32_t Poll() override;
+	int64_t Now() override { return time.load(std::memory_order_relaxed); }
+	int64_t Frequency() override { return 1'000'000'000; }
+};
+
+struct SamplerStats {
+	// Times the source was polled and the source ticks they took, giving the
+	// achieved sample rate
+	uint32_t polls;
+	int64_t pollTime;
+	uint32_t edges;
+	// Lost to a full buffer
+	uint32_t dropped;
+	// From an edge being seen to it being consumed, in source ticks
+	int64_t maxLatency;
+	int64_t totalLatency;
+};
+
+class InputSampler {
+	static constexpr size_t kBufferSize = 256;
+
+	InputSource *source = nullptr;
+	spsc_ring<InputEdge, kBufferSize> edges;
+	std::thread thread;
+	std::atomic<bool> running = false;
+	int64_t interval = 0;
+	int64_t startTime = 0;
+	std::atomic<uint32_t> pollCount = 0;
+	std::atomic<int64_t> lastPollTime = 0;
+	std::atomic<uint32_t> edgeCount = 0;
+	std::atomic<uint32_t> droppedCount = 0;
+	// Consumer side
+	uint32_t lastKeys = 0;
+	int64_t lastTime = 0;
+	int64_t maxLatency = 0;
+	int64_t totalLatency = 0;
+
+	void Run(uint32_t keys);
+
+public:
+	~InputSampler() { Stop(); }
+
+	// Poll source every interval ticks on a new thread
+	void Start(InputSource *source, int64_t interval);
+	void Stop();
+
+	bool IsRunning() const { return running.load(std::memory_order_relaxed); }
+
+	// Consumer only. Report each edge seen up to now, then return the keys
+	// held at now.
+	uint32_t Consume(int64_t now, auto &&callable)
+	{
+		edges.consume([&](const InputEdge &edge) {
+			if (edge.timestamp > now)
+				return false;
+
+			const auto latency = now - edge.timestamp;
+			maxLatency = std::max(maxLatency, latency);
+			totalLatency += latency;
+
+			callable(edge, lastKeys);
+			lastKeys = edge.keys;
+			return true;
+		});
+
+		lastTime = now;
+		return lastKeys;
+	}
+
+	// Consumer only
+	SamplerStats GetStats() const;
+	int64_t GetLastConsumeTime() const { return lastTime; }
+};
+
+// Time in a step with a given set of keys held
+struct InputSegment {
+	uint32_t keys;
+	float fraction;
+};
+
+// Split the interval from start to end at edges, as fractions of the interval.
+// Returns the segments written, merging any beyond out.size() into the last.
+size_t SplitInterval(
+	uint32_t startKeys,
+	std::span<const InputEdge> edges,
+	int64_t start,
+	int64_t end,
+	std::span<InputSegment> out);
+
+} // namespace input
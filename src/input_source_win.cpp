@@ -0,0 +1,76 @@
+#include "input_source_win.h"
+#include <algorithm>
+#include <Windows.h>
+
+// Missing from SDKs before 10.0.17134
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+static bool HasFocus()
+{
+	DWORD processId;
+	GetWindowThreadProcessId(GetForegroundWindow(), &processId);
+	return processId == GetCurrentProcessId();
+}
+
+AsyncKeyInputSource::AsyncKeyInputSource(std::span<const int, input::kInputKey_Count> keys)
+{
+	std::ranges::copy(keys, virtualKeys);
+
+	LARGE_INTEGER value;
+	QueryPerformanceFrequency(&value);
+	frequency = value.QuadPart;
+
+	// High resolution timers need Windows 10 1803, fall back to a plain one
+	auto handle = CreateWaitableTimerExW(
+		nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+	if (handle == nullptr)
+		handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+
+	timer = (uintptr_t)handle;
+}
+
+AsyncKeyInputSource::~AsyncKeyInputSource()
+{
+	if (timer != 0)
+		CloseHandle((HANDLE)timer);
+}
+
+uint32_t AsyncKeyInputSource::Poll()
+{
+	if (!HasFocus())
+		return 0;
+
+	auto keys = 0u;
+
+	for (auto key = 0; key < input::kInputKey_Count; key++) {
+		if (GetAsyncKeyState(virtualKeys[key]) & 0x8000)
+			keys |= input::KeyBit((input::InputKey)key);
+	}
+
+	return keys;
+}
+
+int64_t AsyncKeyInputSource::Now()
+{
+	LARGE_INTEGER value;
+	QueryPerformanceCounter(&value);
+	return value.QuadPart;
+}
+
+void AsyncKeyInputSource::Wait(int64_t ticks)
+{
+	if (timer == 0)
+		return InputSource::Wait(ticks);
+
+	// Relative due time in 100 ns units
+	LARGE_INTEGER dueTime;
+	dueTime.QuadPart = -std::max(ticks * 10'000'000 / frequency, (int64_t)1);
+
+	if (SetWaitableTimer((HANDLE)timer, &dueTime, 0, nullptr, nullptr, FALSE))
+		WaitForSingleObject((HANDLE)timer, INFINITE);
+	else
+		InputSource::Wait(ticks);
+}
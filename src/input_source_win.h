@@ -0,0 +1,25 @@
+#pragma once
+
+#include "input_sampler.h"
+#include <cstdint>
+#include <span>
+
+// Polls the keyboard with GetAsyncKeyState while the game has focus, with
+// QueryPerformanceCounter timestamps. Waits on a high resolution waitable
+// timer where the OS has one, as Sleep rounds up to the ~15.6 ms scheduler
+// tick.
+class AsyncKeyInputSource : public input::InputSource {
+	int virtualKeys[input::kInputKey_Count];
+	int64_t frequency;
+	// Timer HANDLE
+	uintptr_t timer;
+
+public:
+	explicit AsyncKeyInputSource(std::span<const int, input::kInputKey_Count> virtualKeys);
+	~AsyncKeyInputSource() override;
+
+	uint32_t Poll() override;
+	int64_t Now() override;
+	int64_t Frequency() override { return frequency; }
+	void Wait(int64_t ticks) override;
+};
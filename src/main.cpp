@@ -1,5 +1,27 @@
+#include "hot_reload.h"
+#include "ini.h"
+#include "input_sampler.h"
+#include "input_source_win.h"
+#include "movement.h"
+#include "movement_profiles.h"
+#include "trace.h"
+#include "util/exec_arena.h"
+#include "util/hook_dispatch.h"
+#include "util/hook_gate.h"
+#include "util/hook_profile.h"
 #include "util/memory.h"
+#include "util/mid_hook.h"
+#include "util/patch_transaction.h"
+#include "util/state_table.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <thread>
 #include <Windows.h>
 
 using enum hkpCharacterState::StateType;
@@ -7,12 +29,38 @@ using enum bhkCharacterListener::ListenerFlags;
 using enum ActorMover::MovementFlags;
 
 constexpr auto kHavokUnitScale = 1.f / 6.9991255f;
+constexpr auto kIniPath = "Data\\NVSE\\Plugins\\player_physics.ini";
+// Sampled jump presses older than this are ignored
+constexpr auto kJumpBufferTime = .1f;
+constexpr auto kTracePath = "Data\\NVSE\\Plugins\\player_physics.trace";
+constexpr auto kHookProfilePath = "Data\\NVSE\\Plugins\\player_physics_hooks.txt";
+constexpr auto kHookProfileInterval = std::chrono::seconds(10);
+// Console commands need the opcode base the xNVSE team assigns the plugin,
+// passed in as PLAYER_PHYSICS_OPCODE_BASE. Development builds without one use
+// the shared test range, which releases must not.
+#if defined(PLAYER_PHYSICS_OPCODE_BASE)
+#define PLAYER_PHYSICS_COMMANDS
+constexpr auto kOpcodeBase = PLAYER_PHYSICS_OPCODE_BASE;
+#elif defined(PLAYER_PHYSICS_DEV)
+#define PLAYER_PHYSICS_COMMANDS
+constexpr auto kOpcodeBase = 0x2000;
+#endif
+// New builds to hot load, outside the folder NVSE loads plugins from
+constexpr auto kReloadPath = "Data\\NVSE\\Plugins\\player_physics\\PlayerPhysics.dll";
+// Longest to wait for running hooks to return when reloading
+constexpr auto kReloadDrainTimeout = std::chrono::milliseconds(500);
 
 enum ControlState {
 	kControlState_Held = 0,
 	kControlState_Pressed = 1
 };
 
+// PlayerCharacter::disabledControlFlags bit set by DisablePlayerControls
+constexpr UInt8 kDisabledControl_Movement = 1 << 0;
+
+// InterfaceManager::currentMode outside of menus
+constexpr UInt32 kInterfaceMode_Game = 1;
+
 struct CharacterMoveParams {
 	// this struct alignment pisses me off
 	float multiplier;
@@ -25,23 +73,82 @@ struct CharacterMoveParams {
 	AlignedVector4 surfaceVelocity;
 };
 
-namespace ini {
-constexpr auto fFriction = 5.f;
-constexpr auto fAcceleration = 6.f;
-constexpr auto fAirAcceleration = 1.f;
-constexpr auto fMinAccelScaleSpeed = 25.f;
-constexpr auto fStopSpeed = 16.f;
-constexpr auto fAirSpeed = 1.f;
-constexpr auto fGravityMult = 2.f;
-constexpr auto fKnockbackScale = 10.f;
-constexpr auto fLandingPenaltyImpactSpeed50 = 100.f;
-}
+// ShouldUsePhysics result, computed once per Havok step
+struct PhysicsDecision {
+	bool valid = false;
+	bool usePhysics;
+	UInt32 vatsMode;
+	UInt16 weaponSequence;
+	// Held for the step so sequence changes can be checked with a load
+	const AnimData *animData;
+};
 
-struct {
+struct PhysicsState {
+	Actor *actor = nullptr;
+	PhysicsDecision decision;
 	AlignedVector4 airVelocity;
-	bool usedJumpInput = true;
+	// Written from input polling
+	std::atomic<bool> usedJumpInput = true;
 	bool justLanded = false;
-} g_player;
+	movement::FixedStepState fixedStep;
+	// INI snapshot for the current Havok step, taken in UpdateCharacterState
+	// so every hook in the step reads the same values
+	const ini::Settings *settings = &ini::Get();
+};
+
+// Controllers using custom physics
+static state_table<PhysicsState, 1024> g_physicsStates;
+
+// Player keys sampled off the frame loop
+static struct {
+	std::unique_ptr<AsyncKeyInputSource> source;
+	input::InputSampler sampler;
+	// Time of a sampled jump press not yet seen by CheckJumpButton
+	std::atomic<int64_t> jumpPressTime = INT64_MIN;
+	// Scan code of the sampled jump key, to match against the game's binding
+	UInt8 jumpScanCode;
+	// Held keys over the current player step
+	input::InputSegment segments[8];
+	size_t segmentCount;
+	uint32_t keys;
+} g_input;
+
+static_assert(movement::kMoveFlag_Forward  == input::KeyBit(input::kInputKey_Forward));
+static_assert(movement::kMoveFlag_Backward == input::KeyBit(input::kInputKey_Backward));
+static_assert(movement::kMoveFlag_Left     == input::KeyBit(input::kInputKey_Left));
+static_assert(movement::kMoveFlag_Right    == input::KeyBit(input::kInputKey_Right));
+
+// ShouldUsePhysics evaluations, rolled over at the start of each player step.
+// Controllers may step on Havok's worker threads.
+static struct {
+	std::atomic<UInt32> evaluations;
+	std::atomic<UInt32> saved;
+	std::atomic<UInt32> lastEvaluations;
+	std::atomic<UInt32> lastSaved;
+} g_decisionStats;
+
+struct PatchStats {
+	UInt32 patches;
+	UInt32 pages;
+	UInt32 microseconds;
+};
+
+static PatchStats g_patchStats;
+
+// Patches installed by this build, reverted when reloading
+static std::optional<patch_transaction> g_patches;
+
+// Entered by every hook, so reloading can wait for them to return
+static hook_gate g_hookGate;
+
+// Slot in the first build loaded pointing at the newest build's Reload
+static hot_reload::ReloadFunction *g_currentReload;
+
+// Likewise for SetEnabled
+static hot_reload::SetEnabledFunction *g_currentSetEnabled;
+
+// Patches are installed while enabled, toggled from the console or scripts
+static bool g_enabled = true;
 
 static PlayerCharacter *GetPlayer()
 {
@@ -53,184 +160,414 @@ static bool IsPlayerController(bhkCharacterController *charCtrl)
 	return charCtrl == GetPlayer()->GetCharacterController();
 }
 
-static bool IsMovementOverrideSequence(UInt16 sequence)
+// Only the player's mover is a PlayerMover, holding the input the model runs on
+static const PlayerMover *GetPlayerMover(const PhysicsState &physics)
 {
-	return CdeclCall<bool>(0x5F2670, sequence);
+	if (physics.actor != GetPlayer())
+		return nullptr;
+
+	return (const PlayerMover*)physics.actor->actorMover;
 }
 
-static bool ShouldUsePhysics(bhkCharacterController *charCtrl)
+static PhysicsState *GetPhysicsState(bhkCharacterController *charCtrl)
+{
+	return g_physicsStates.find(charCtrl);
+}
+
+static PhysicsState *GetPlayerState()
+{
+	return GetPhysicsState(GetPlayer()->GetCharacterController());
+}
+
+static void EnablePhysics(Actor *actor, bhkCharacterController *charCtrl)
+{
+	if (auto *physics = g_physicsStates.find_or_insert(charCtrl); physics != nullptr)
+		physics->actor = actor;
+}
+
+static void TrackPlayerController(bhkCharacterController *charCtrl)
+{
+	static bhkCharacterController *playerController;
+
+	if (charCtrl == playerController)
+		return;
+
+	// Controller was recreated, drop the stale state
+	g_physicsStates.erase(playerController);
+	playerController = charCtrl;
+	EnablePhysics(GetPlayer(), charCtrl);
+}
+
+static void StartInputSampler(const ini::Settings &settings)
+{
+	if (settings.iInputSampleRate <= 0)
+		return;
+
+	const int keys[] = {
+		settings.iKeyForward,
+		settings.iKeyBackward,
+		settings.iKeyLeft,
+		settings.iKeyRight,
+		settings.iKeyJump
+	};
+
+	static_assert(std::size(keys) == input::kInputKey_Count);
+
+	g_input.source = std::make_unique<AsyncKeyInputSource>(keys);
+	g_input.jumpScanCode = (UInt8)MapVirtualKeyA(settings.iKeyJump, MAPVK_VK_TO_VSC);
+	const auto interval = g_input.source->Frequency() / settings.iInputSampleRate;
+	g_input.sampler.Start(g_input.source.get(), std::max(interval, (int64_t)1));
+	g_input.keys = g_input.source->Poll();
+}
+
+// Take the edges sampled since the last player step
+static void ConsumeSampledInput()
+{
+	if (!g_input.sampler.IsRunning())
+		return;
+
+	input::InputEdge edges[16];
+	size_t edgeCount = 0;
+
+	const auto startKeys = g_input.keys;
+	const auto start = g_input.sampler.GetLastConsumeTime();
+	const auto now = g_input.source->Now();
+
+	g_input.keys = g_input.sampler.Consume(now, [&](const input::InputEdge &edge, uint32_t previous) {
+		if (edge.keys & ~previous & input::KeyBit(input::kInputKey_Jump))
+			g_input.jumpPressTime = edge.timestamp;
+
+		// Fold overflow into the last edge
+		edges[std::min(edgeCount, std::size(edges) - 1)] = edge;
+		edgeCount = std::min(edgeCount + 1, std::size(edges));
+	});
+
+	g_input.segmentCount = input::SplitInterval(
+		startKeys, {edges, edgeCount}, start, now, g_input.segments);
+}
+
+// The sampler reads the keyboard directly, so its presses only count where the
+// game would take the key as a jump: bound to jump, controls enabled and no
+// menu open
+static bool CanTakeSampledJump(const OSInputGlobals *input, int key)
 {
-	if (!IsPlayerController(charCtrl))
+	if (g_input.jumpScanCode == 0 || input->keyBinds[key] != g_input.jumpScanCode)
 		return false;
 
-	if (VATSCameraData::Get()->mode != 0)
+	if (GetPlayer()->disabledControlFlags & kDisabledControl_Movement)
 		return false;
 
-	const auto *animData = GetPlayer()->GetAnimData();
+	return InterfaceManager::GetSingleton()->currentMode == kInterfaceMode_Game;
+}
 
-	if (IsMovementOverrideSequence(animData->animGroupIDs[AnimData::kSequence_Weapon]))
+// Whether the game registered a sampled jump press, including taps released
+// before the game polled. Presses the game wouldn't take are dropped.
+static bool TakeSampledJumpPress(const OSInputGlobals *input, int key)
+{
+	if (!g_input.sampler.IsRunning())
 		return false;
 
-	return true;
+	const auto pressTime = g_input.jumpPressTime.exchange(INT64_MIN);
+
+	if (pressTime == INT64_MIN || !CanTakeSampledJump(input, key))
+		return false;
+
+	const auto age = g_input.source->Now() - pressTime;
+	return age < (int64_t)(kJumpBufferTime * g_input.source->Frequency());
 }
 
-static void ApplyFriction(
-	const CharacterMoveParams &move,
-	AlignedVector4 *velocity,
-	float deltaTime)
+// Sampled keys only stand in for the game's when they agree at the end of
+// the step, which rules out menus and disabled controls
+static bool UseSampledInput(const PhysicsState &physics, uint32_t moveFlags)
 {
-	const auto speed = ((NiVector3&)*velocity).Length();
-	const auto scaleSpeed = std::max(speed, ini::fStopSpeed);
-	const auto friction = ini::fFriction * scaleSpeed * move.groundNormal.z * deltaTime;
+	if (!g_input.sampler.IsRunning() || physics.actor != GetPlayer())
+		return false;
 
-	if (friction >= speed)
-		*velocity = AlignedVector4(0, 0, 0, 0);
-	else
-		*velocity *= 1.f - friction / speed;
+	return (g_input.keys & input::kDirectionKeys) == (moveFlags & movement::kMoveMask);
 }
 
-static void ApplyAcceleration(
-	const CharacterMoveParams &move,
-	AlignedVector4 *velocity,
-	const NiVector3 &moveVector,
-	bool inAir,
-	float baseSpeed,
-	float deltaTime)
+static bool IsMovementOverrideSequence(UInt16 sequence)
 {
-	const auto speed = ((NiVector3&)*velocity).DotProduct(moveVector);
-	const auto maxSpeed = inAir ? baseSpeed * ini::fAirSpeed : baseSpeed;
-	const auto speedCap = std::max(baseSpeed, ((NiVector3&)*velocity).Length());
+	return CdeclCall<bool>(0x5F2670, sequence);
+}
 
-	if (speed >= maxSpeed)
-		return;
+static void InvalidateDecision(PhysicsState *physics)
+{
+	physics->decision.valid = false;
+}
+
+static void RollOverDecisionStats()
+{
+	const auto evaluations = g_decisionStats.evaluations.exchange(0, std::memory_order_relaxed);
+	const auto saved = g_decisionStats.saved.exchange(0, std::memory_order_relaxed);
+	g_decisionStats.lastEvaluations.store(evaluations, std::memory_order_relaxed);
+	g_decisionStats.lastSaved.store(saved, std::memory_order_relaxed);
+}
+
+static bool EvaluateShouldUsePhysics(const PhysicsDecision &decision)
+{
+	if (decision.vatsMode != 0)
+		return false;
 
-	const auto accelMultiplier = inAir ? ini::fAirAcceleration : ini::fAcceleration;
-	const auto scaleSpeed = std::max(baseSpeed, ini::fMinAccelScaleSpeed);
-	const auto accel = accelMultiplier * scaleSpeed * move.groundNormal.z * deltaTime;
-	*velocity += moveVector * std::min(accel, maxSpeed - speed);
+	if (IsMovementOverrideSequence(decision.weaponSequence))
+		return false;
 
-	if (const auto newLength = ((NiVector3&)*velocity).Length(); newLength > speedCap)
-		*velocity *= speedCap / newLength;
+	return true;
 }
 
-static AlignedVector4 GetInputVector(UInt32 moveFlags)
+static bool ShouldUsePhysics(bhkCharacterController *charCtrl)
 {
-	auto result = AlignedVector4(0, 0, 0, 0);
+	auto *physics = GetPhysicsState(charCtrl);
 
-	if (moveFlags & kMoveFlag_Forward)
-		result.x = 1.f;
-	else if (moveFlags & kMoveFlag_Backward)
-		result.x = -1.f;
+	if (physics == nullptr)
+		return false;
+
+	auto *decision = &physics->decision;
+	const auto vatsMode = VATSCameraData::Get()->mode;
 
-	if (moveFlags & kMoveFlag_Left)
-		result.y = -1.f;
-	else if (moveFlags & kMoveFlag_Right)
-		result.y = 1.f;
+	if (decision->valid) {
+		// Entering VATS or starting a weapon sequence mid step invalidates
+		const auto weaponSequence = decision->animData->animGroupIDs[AnimData::kSequence_Weapon];
 
-	return result;
+		if (vatsMode == decision->vatsMode && weaponSequence == decision->weaponSequence) {
+			g_decisionStats.saved.fetch_add(1, std::memory_order_relaxed);
+			return decision->usePhysics;
+		}
+	}
+
+	decision->animData = physics->actor->GetAnimData();
+	decision->vatsMode = vatsMode;
+	decision->weaponSequence = decision->animData->animGroupIDs[AnimData::kSequence_Weapon];
+	decision->usePhysics = GetPlayerMover(*physics) != nullptr && EvaluateShouldUsePhysics(*decision);
+	decision->valid = true;
+	g_decisionStats.evaluations.fetch_add(1, std::memory_order_relaxed);
+	return decision->usePhysics;
 }
 
-static AlignedVector4 GetMoveVector(const CharacterMoveParams &move, const AlignedVector4 &input)
+static_assert(movement::kMoveFlag_Forward  == kMoveFlag_Forward);
+static_assert(movement::kMoveFlag_Backward == kMoveFlag_Backward);
+static_assert(movement::kMoveFlag_Left     == kMoveFlag_Left);
+static_assert(movement::kMoveFlag_Right    == kMoveFlag_Right);
+
+static vec3 ToVec3(const AlignedVector4 &vector)
 {
-	const auto &forward = move.forward;
-	const auto &up = move.up;
-	const auto right = AlignedVector4(((NiVector3&)forward).CrossProduct(up));
-	const auto moveVectorRaw = forward * -input.x + right * input.y + up * input.z;
-	const auto moveVector = NiVector3(moveVectorRaw).Normalize();
-	const auto &normal = move.groundNormal;
+	return vec3(vector.x, vector.y, vector.z);
+}
 
-	if (normal.z <= 1e-4f || normal.z >= 1.f - 1e-4f)
-		return {moveVector};
+static void FromVec3(AlignedVector4 *out, const vec3 &vector)
+{
+	out->x = vector.x;
+	out->y = vector.y;
+	out->z = vector.z;
+}
 
-	const auto dot = moveVector.DotProduct(normal);
-	return {NiVector3(moveVector.x, moveVector.y, -dot / normal.z).Normalize()};
+static movement::MoveParams GetMoveParams(const CharacterMoveParams &move)
+{
+	return {
+		.forward      = ToVec3(move.forward),
+		.up           = ToVec3(move.up),
+		.groundNormal = ToVec3(move.groundNormal)
+	};
 }
 
 static void UpdateVelocity(
+	const ini::Settings &settings,
+	PhysicsState *physics,
+	const PlayerMover &mover,
 	const CharacterMoveParams &move,
 	AlignedVector4 *velocity,
 	UInt32 state,
 	float deltaTime)
 {
-	const auto inAir = state == kState_InAir || g_player.justLanded;
-
-	if (!inAir)
-		ApplyFriction(move, velocity, deltaTime);
+	const auto input = movement::MoveInput {
+		.moveFlags = mover.pcMovementFlags,
+		.moveSpeed = mover.moveSpeed * kHavokUnitScale,
+		.inAir     = state == kState_InAir || physics->justLanded
+	};
 
-	constexpr auto kMoveMask =
-		kMoveFlag_Forward | kMoveFlag_Backward |
-		kMoveFlag_Left    | kMoveFlag_Right;
+	const auto &profile = movement::GetProfileKernels(settings.iProfile);
+	const auto params = GetMoveParams(move);
+	auto result = ToVec3(*velocity);
+	const auto integrator = static_cast<movement::Integrator>(settings.iIntegrator);
 
-	const auto *mover = (PlayerMover*)GetPlayer()->actorMover;
+	// Start fixed steps over when they're switched back on
+	if (settings.fFixedTimestep <= 0.f)
+		physics->fixedStep = {};
 
-	if ((mover->pcMovementFlags & kMoveMask) != 0) {
-		const auto inputVector = GetInputVector(mover->pcMovementFlags);
-		const auto moveVector = GetMoveVector(move, inputVector);
-		const auto moveSpeed = mover->moveSpeed * kHavokUnitScale;
-		ApplyAcceleration(move, velocity, moveVector, inAir, moveSpeed, deltaTime);
+	if (settings.fFixedTimestep > 0.f) {
+		profile.updateVelocityFixed(
+			settings, params, input, &physics->fixedStep, &result,
+			deltaTime, settings.fFixedTimestep, settings.iMaxSubsteps, integrator);
+	} else if (UseSampledInput(*physics, input.moveFlags)) {
+		// Split the step where sampled direction keys changed
+		for (size_t i = 0; i < g_input.segmentCount; i++) {
+			const auto &segment = g_input.segments[i];
+			auto segmentInput = input;
+			segmentInput.moveFlags &= ~movement::kMoveMask;
+			segmentInput.moveFlags |= segment.keys & input::kDirectionKeys;
+			profile.updateVelocity(
+				settings, params, segmentInput, &result, deltaTime * segment.fraction, integrator);
+		}
+	} else {
+		profile.updateVelocity(settings, params, input, &result, deltaTime, integrator);
 	}
+
+	FromVec3(velocity, result);
+}
+
+static trace::TraceVec3 ToTraceVec3(const AlignedVector4 &vector)
+{
+	return {vector.x, vector.y, vector.z};
 }
 
-static void ApplyThrowback(bhkCharacterController *charCtrl)
+static trace::TraceMoveParams ToTraceMoveParams(const CharacterMoveParams &move)
+{
+	return {
+		.multiplier      = move.multiplier,
+		.forward         = ToTraceVec3(move.forward),
+		.up              = ToTraceVec3(move.up),
+		.groundNormal    = ToTraceVec3(move.groundNormal),
+		.velocity        = ToTraceVec3(move.velocity),
+		.input           = ToTraceVec3(move.input),
+		.maxSpeed        = move.maxSpeed,
+		.surfaceVelocity = ToTraceVec3(move.surfaceVelocity)
+	};
+}
+
+// Records a hook's effect on a velocity over its scope, along with the
+// hook's ShouldUsePhysics result
+class StepTrace {
+	trace::TraceKind kind;
+	bhkCharacterController *charCtrl;
+	bool usedPhysics;
+	const PhysicsState *physics = nullptr;
+	const AlignedVector4 *velocity;
+	const CharacterMoveParams *move;
+	trace::TraceVec3 velocityIn;
+
+public:
+	StepTrace(
+		trace::TraceKind kind,
+		bhkCharacterController *charCtrl,
+		bool usedPhysics,
+		const AlignedVector4 *velocity,
+		const CharacterMoveParams *move = nullptr) :
+		kind(kind), charCtrl(charCtrl), usedPhysics(usedPhysics), velocity(velocity), move(move)
+	{
+		if (!trace::IsRecording())
+			return;
+
+		physics = GetPhysicsState(charCtrl);
+		velocityIn = ToTraceVec3(*velocity);
+	}
+
+	~StepTrace()
+	{
+		if (physics == nullptr)
+			return;
+
+		auto flags = (uint8_t)0;
+		if (usedPhysics)
+			flags |= trace::kTraceFlag_UsedPhysics;
+		if (move != nullptr)
+			flags |= trace::kTraceFlag_HasParams;
+
+		const auto *mover = GetPlayerMover(*physics);
+
+		trace::Record({
+			.controller  = (uint32_t)(uintptr_t)charCtrl,
+			.kind        = kind,
+			.flags       = flags,
+			.hkState     = (uint8_t)charCtrl->chrContext.hkState,
+			.wantState   = (uint8_t)charCtrl->wantState,
+			.moveFlags   = mover != nullptr ? mover->pcMovementFlags : 0,
+			.deltaTime   = charCtrl->stepInfo.deltaTime,
+			.velocityIn  = velocityIn,
+			.velocityOut = ToTraceVec3(*velocity),
+			.params      = move != nullptr ? ToTraceMoveParams(*move) : trace::TraceMoveParams {}
+		});
+	}
+};
+
+static void ApplyThrowback(const ini::Settings &settings, bhkCharacterController *charCtrl)
 {
 	if (charCtrl->throwbackTimer <= 0.f || !charCtrl->chrListener.ReceivesThrowback())
 		return;
 
-	// Scale based on total distance moved in vanilla
-	const auto scale = charCtrl->throwbackTimer * charCtrl->throwbackTimer * .5f;
-	charCtrl->velocity += charCtrl->throwbackVelocity * (scale * ini::fKnockbackScale);
+	const auto &profile = movement::GetProfileKernels(settings.iProfile);
+	const auto impulse = profile.getThrowbackImpulse(
+		settings, charCtrl->throwbackTimer, ToVec3(charCtrl->throwbackVelocity));
+
+	charCtrl->velocity += AlignedVector4(impulse.x, impulse.y, impulse.z, 0.f);
 	charCtrl->throwbackTimer = 0.f;
 	charCtrl->throwbackVelocity = AlignedVector4(0, 0, 0, 0);
 }
 
-static void hook_MoveCharacter(
-	bhkCharacterController *charCtrl,
-	CharacterMoveParams *move,
-	AlignedVector4 *velocity)
+// Runs in place of MoveCharacter, which takes the controller in esi. One
+// instance per call site, so each site has its own original.
+template<uintptr_t Site>
+static bool hook_MoveCharacter(mid_hook_context *context)
 {
-	if (!ShouldUsePhysics(charCtrl)) {
-		// call original
-		CdeclCall(HookGetOriginal(), move, velocity);
-		return;
+	const auto gate = g_hookGate.enter();
+	auto *charCtrl = (bhkCharacterController*)context->si;
+	auto *move = context->stack<CharacterMoveParams*>(4);
+	auto *velocity = context->stack<AlignedVector4*>(8);
+
+	if (!gate) {
+		CdeclCall(HookGetOriginal<hook_MoveCharacter<Site>>(), move, velocity);
+		return true;
+	}
+
+	const auto usePhysics = ShouldUsePhysics(charCtrl);
+	const auto stepTrace = StepTrace(trace::kTraceKind_MoveCharacter, charCtrl, usePhysics, velocity, move);
+
+	if (!usePhysics) {
+		// Call the original here rather than falling through so the trace
+		// sees its result
+		CdeclCall(HookGetOriginal<hook_MoveCharacter<Site>>(), move, velocity);
+		return true;
 	}
 
+	// ShouldUsePhysics only passes the player
+	auto *physics = GetPhysicsState(charCtrl);
+	const auto &settings = *physics->settings;
+	const auto *mover = GetPlayerMover(*physics);
 	const auto state = charCtrl->chrContext.hkState;
 	const auto deltaTime = charCtrl->stepInfo.deltaTime;
 
 	*velocity -= move->surfaceVelocity.PS();
-	UpdateVelocity(*move, velocity, state, deltaTime);
-	ApplyThrowback(charCtrl);
+	UpdateVelocity(settings, physics, *mover, *move, velocity, state, deltaTime);
+	ApplyThrowback(settings, charCtrl);
 	*velocity += move->surfaceVelocity.PS();
 
 	// Prevent ground state from restoring Z velocity
 	if (state == kState_OnGround)
 		move->velocity.z = velocity->z;
-}
 
-static __declspec(naked) void hook_MoveCharacter_wrapper()
-{
-	__asm {
-		push [esp+8]
-		push [esp+8]
-		push esi
-		call hook_MoveCharacter
-		add esp, 12
-		ret
-	}
+	return true;
 }
 
 static int __fastcall hook_CheckJumpButton(
 	OSInputGlobals *input, int, int key, ControlState state)
 {
-	if (ThisCall<int>(HookGetOriginal(), input, key, kControlState_Pressed)) {
+	const auto gate = g_hookGate.enter();
+	auto *physics = gate ? GetPlayerState() : nullptr;
+
+	if (physics == nullptr)
+		return ThisCall<int>(HookGetOriginal<hook_CheckJumpButton>(), input, key, state);
+
+	const auto pressed = TakeSampledJumpPress(input, key) ||
+	                     ThisCall<int>(HookGetOriginal<hook_CheckJumpButton>(), input, key, kControlState_Pressed);
+
+	if (pressed) {
 		// Fresh input
-		g_player.usedJumpInput = false;
+		physics->usedJumpInput = false;
 		return true;
-	} else if (g_player.usedJumpInput) {
+	} else if (physics->usedJumpInput) {
 		// Already used this input to jump
 		return false;
 	}
-	return ThisCall<int>(HookGetOriginal(), input, key, kControlState_Held);
+	return ThisCall<int>(HookGetOriginal<hook_CheckJumpButton>(), input, key, kControlState_Held);
 }
 
 static bool WillJump(bhkCharacterController *charCtrl)
@@ -248,15 +585,25 @@ static bool WillJump(bhkCharacterController *charCtrl)
 static void __fastcall hook_bhkCharacterStateJumping_UpdateVelocity(
 	bhkCharacterStateJumping *state, int, bhkCharacterController *charCtrl)
 {
-	if (!ShouldUsePhysics(charCtrl) || !WillJump(charCtrl)) {
-		ThisCall(HookGetOriginal(), state, charCtrl);
+	const auto gate = g_hookGate.enter();
+
+	if (!gate) {
+		ThisCall(HookGetOriginal<hook_bhkCharacterStateJumping_UpdateVelocity>(), state, charCtrl);
+		return;
+	}
+
+	const auto usePhysics = ShouldUsePhysics(charCtrl);
+	const auto stepTrace = StepTrace(trace::kTraceKind_Jumping, charCtrl, usePhysics, &charCtrl->velocity);
+
+	if (!usePhysics || !WillJump(charCtrl)) {
+		ThisCall(HookGetOriginal<hook_bhkCharacterStateJumping_UpdateVelocity>(), state, charCtrl);
 		return;
 	}
 	// Must repress jump input
-	g_player.usedJumpInput = true;
+	GetPhysicsState(charCtrl)->usedJumpInput = true;
 	// Additive jumps
 	const auto startZ = charCtrl->velocity.z;
-	ThisCall(HookGetOriginal(), state, charCtrl);
+	ThisCall(HookGetOriginal<hook_bhkCharacterStateJumping_UpdateVelocity>(), state, charCtrl);
 	if (startZ > 0.f)
 		charCtrl->velocity.z += startZ;
 }
@@ -266,87 +613,619 @@ static bool WillFall(bhkCharacterController *charCtrl)
 	return !(charCtrl->chrListener.flags & kHasSupport) && !charCtrl->bFakeSupport;
 }
 
-static void ApplyLandingPenalty(bhkCharacterController *charCtrl)
+static void ApplyLandingPenalty(const PhysicsState &physics, bhkCharacterController *charCtrl)
 {
-	const auto delta = NiVector3(charCtrl->velocity - g_player.airVelocity.PS()).Length();
-	charCtrl->velocity *= powf(.5f, delta / ini::fLandingPenaltyImpactSpeed50);
+	const auto &settings = *physics.settings;
+	const auto &profile = movement::GetProfileKernels(settings.iProfile);
+	charCtrl->velocity *= profile.getLandingPenalty(
+		settings, ToVec3(charCtrl->velocity), ToVec3(physics.airVelocity));
 }
 
 static void __fastcall hook_bhkCharacterStateOnGround_UpdateVelocity(
 	bhkCharacterStateOnGround *state, int, bhkCharacterController *charCtrl)
 {
+	const auto gate = g_hookGate.enter();
+
+	if (!gate) {
+		ThisCall(HookGetOriginal<hook_bhkCharacterStateOnGround_UpdateVelocity>(), state, charCtrl);
+		return;
+	}
+
+	const auto usePhysics = ShouldUsePhysics(charCtrl);
+	const auto stepTrace = StepTrace(trace::kTraceKind_OnGround, charCtrl, usePhysics, &charCtrl->velocity);
+
 	// Preserve downward velocity when walking off things
-	if (WillFall(charCtrl) && (!ShouldUsePhysics(charCtrl) || charCtrl->velocity.z > 0.f))
+	if (WillFall(charCtrl) && (!usePhysics || charCtrl->velocity.z > 0.f))
 		charCtrl->velocity.z = 0.f;
 
-	ThisCall(HookGetOriginal(), state, charCtrl);
+	ThisCall(HookGetOriginal<hook_bhkCharacterStateOnGround_UpdateVelocity>(), state, charCtrl);
 
-	if (IsPlayerController(charCtrl) && g_player.justLanded) {
-		g_player.justLanded = false;
-		if (ShouldUsePhysics(charCtrl))
-			ApplyLandingPenalty(charCtrl);
+	if (auto *physics = GetPhysicsState(charCtrl); physics != nullptr && physics->justLanded) {
+		physics->justLanded = false;
+		if (usePhysics)
+			ApplyLandingPenalty(*physics, charCtrl);
 	}
 }
 
 static void __fastcall hook_bhkCharacterStateInAir_UpdateVelocity(
 	bhkCharacterStateInAir *state, int, bhkCharacterController *charCtrl)
 {
-	ThisCall(HookGetOriginal(), state, charCtrl);
+	const auto gate = g_hookGate.enter();
 
-	if (IsPlayerController(charCtrl)) {
+	if (!gate) {
+		ThisCall(HookGetOriginal<hook_bhkCharacterStateInAir_UpdateVelocity>(), state, charCtrl);
+		return;
+	}
+
+	// The in air step doesn't depend on the decision, so only make it for the trace
+	const auto usePhysics = trace::IsRecording() && ShouldUsePhysics(charCtrl);
+	const auto stepTrace = StepTrace(trace::kTraceKind_InAir, charCtrl, usePhysics, &charCtrl->velocity);
+
+	ThisCall(HookGetOriginal<hook_bhkCharacterStateInAir_UpdateVelocity>(), state, charCtrl);
+
+	if (auto *physics = GetPhysicsState(charCtrl); physics != nullptr) {
 		if (charCtrl->chrContext.hkState == kState_OnGround)
-			g_player.justLanded = true;
+			physics->justLanded = true;
 		else
-			g_player.airVelocity = charCtrl->velocity;
+			physics->airVelocity = charCtrl->velocity;
 	}
 }
 
 static void __fastcall hook_bhkCharacterController_UpdateCharacterState(
 	bhkCharacterController *charCtrl, int, const void *params)
 {
+	const auto gate = g_hookGate.enter();
+
+	if (!gate) {
+		ThisCall(HookGetOriginal<hook_bhkCharacterController_UpdateCharacterState>(), charCtrl, params);
+		return;
+	}
+
 	if (IsPlayerController(charCtrl)) {
-		charCtrl->gravityMult = ini::fGravityMult;
+		TrackPlayerController(charCtrl);
+		RollOverDecisionStats();
+		ConsumeSampledInput();
+	}
+
+	if (auto *physics = GetPhysicsState(charCtrl); physics != nullptr) {
+		// New Havok step
+		InvalidateDecision(physics);
+		physics->settings = &ini::Get();
+		const auto &settings = *physics->settings;
+		const auto &profile = movement::GetProfileKernels(settings.iProfile);
+		charCtrl->gravityMult = profile.getSettings(settings).fGravityMult;
 		charCtrl->chrListener.collisionTolerance = 0.f;
 	}
 
-	ThisCall(HookGetOriginal(), charCtrl, params);
+	ThisCall(HookGetOriginal<hook_bhkCharacterController_UpdateCharacterState>(), charCtrl, params);
 }
 
 static float __fastcall hook_bhkCharacterController_GetFallDistance(
 	bhkCharacterController *charCtrl)
 {
+	const auto gate = g_hookGate.enter();
+
 	// Prevent fake midair landing
-	if (ShouldUsePhysics(charCtrl))
+	if (gate && ShouldUsePhysics(charCtrl))
 		return 1.f;
 
-	return ThisCall<float>(HookGetOriginal(), charCtrl);
+	return ThisCall<float>(HookGetOriginal<hook_bhkCharacterController_GetFallDistance>(), charCtrl);
 }
 
+// One instance per call site, like hook_MoveCharacter
+template<uintptr_t Site>
 static void __fastcall hook_bhkCharacterController_UpdateThrowback(
 	bhkCharacterController *charCtrl)
 {
+	const auto gate = g_hookGate.enter();
+
 	// Handle throwback ourselves
-	if (!ShouldUsePhysics(charCtrl))
-		ThisCall(HookGetOriginal(), charCtrl);
-}
-
-static __declspec(naked) void hook_CheckToRootCharacter()
-{
-	// Don't root the player in place (when not driven by animation)
-	__asm {
-		push ebx
-		call ShouldUsePhysics
-		add esp, 4
-		test al, al
-		jne skip
-		// Overwritten instruction
-		cmp byte ptr [esp+0x1B], 0
-		mov eax, 0xC73ACE
-		jmp eax
-	skip:
-		mov eax, 0xC73C0D
-		jmp eax
+	if (!gate || !ShouldUsePhysics(charCtrl))
+		ThisCall(HookGetOriginal<hook_bhkCharacterController_UpdateThrowback<Site>>(), charCtrl);
+}
+
+// Don't root the player in place (when not driven by animation)
+static bool hook_CheckToRootCharacter(mid_hook_context *context)
+{
+	const auto gate = g_hookGate.enter();
+	return gate && ShouldUsePhysics((bhkCharacterController*)context->bx);
+}
+
+using namespace std::string_view_literals;
+
+// Other plugins hook the same call sites and vtable entries, so these join
+// them through the dispatch registry
+template<auto Hook>
+constexpr auto call_hook(uintptr_t address)
+{
+	return patch_entry {
+		.kind     = patch_kind::call_rel32,
+		.address  = address,
+		.hook     = function_address<instrumented<Hook>>,
+		.original = &detail::hook::static_original<Hook>,
+		.shared   = true
+	};
+}
+
+// Runs Hook with the caller's registers in place of a cdecl function taking
+// nothing in registers. Hook returns true once it's done the call's work, or
+// false to fall through to the original.
+template<auto Hook>
+constexpr auto register_call_hook(uintptr_t address, uint32_t context)
+{
+	return patch_entry {
+		.kind     = patch_kind::call_rel32,
+		.address  = address,
+		.original = &detail::hook::static_original<Hook>,
+		.shared   = true,
+		.mid      = { .callback = instrumented<Hook>, .context = context, .dead = MID_HOOK_VOLATILE }
+	};
+}
+
+// Runs Hook in place of the instructions at address, which are replayed if
+// it returns false
+template<auto Hook>
+constexpr auto mid_function_hook(
+	uintptr_t address, std::string_view expected, uint32_t context, uint32_t dead, uintptr_t jumpTarget)
+{
+	return patch_entry {
+		.kind     = patch_kind::mid,
+		.address  = address,
+		.expected = expected,
+		.mid      = {
+			.callback    = instrumented<Hook>,
+			.context     = context,
+			.dead        = dead,
+			.jump_target = jumpTarget
+		}
+	};
+}
+
+template<auto Hook>
+constexpr auto vtable_hook(uintptr_t vtable, size_t index)
+{
+	return patch_entry {
+		.kind     = patch_kind::vtable,
+		.address  = vtable,
+		.index    = index,
+		.hook     = function_address<instrumented<Hook>>,
+		.original = &detail::hook::static_original<Hook>,
+		.shared   = true
+	};
+}
+
+constexpr auto code_patch(
+	uintptr_t address, std::string_view bytes, std::string_view expected, std::string_view expectedMask = {})
+{
+	return patch_entry {
+		.kind          = patch_kind::code,
+		.address       = address,
+		.bytes         = bytes,
+		.expected      = expected,
+		.expected_mask = expectedMask
+	};
+}
+
+// Turns a short conditional jump into an unconditional one, whichever
+// condition the game tested
+constexpr auto jcc_to_jmp(uintptr_t address)
+{
+	return code_patch(address, "\xEB"sv, "\x70"sv, "\xF0"sv);
+}
+
+static constexpr patch_entry kPatchManifest[] = {
+	register_call_hook<hook_MoveCharacter<0xCD414D>>(0xCD414D, MID_HOOK_SI),
+	register_call_hook<hook_MoveCharacter<0xCD45D0>>(0xCD45D0, MID_HOOK_SI),
+	register_call_hook<hook_MoveCharacter<0xCD4A2A>>(0xCD4A2A, MID_HOOK_SI),
+	call_hook<hook_CheckJumpButton>(0x94215F),
+	vtable_hook<hook_bhkCharacterStateJumping_UpdateVelocity>(kVtbl_bhkCharacterStateJumping, 8),
+	vtable_hook<hook_bhkCharacterStateOnGround_UpdateVelocity>(kVtbl_bhkCharacterStateOnGround, 8),
+	vtable_hook<hook_bhkCharacterStateInAir_UpdateVelocity>(kVtbl_bhkCharacterStateInAir, 8),
+	vtable_hook<hook_bhkCharacterController_UpdateCharacterState>(kVtbl_bhkCharacterController, 50),
+	call_hook<hook_bhkCharacterController_GetFallDistance>(0xCD400B),
+	call_hook<hook_bhkCharacterController_UpdateThrowback<0xCD47AB>>(0xCD47AB),
+	call_hook<hook_bhkCharacterController_UpdateThrowback<0xCD4AA2>>(0xCD4AA2),
+	// Replaces cmp byte ptr [esp+0x1B], 0, which sets the flags itself
+	mid_function_hook<hook_CheckToRootCharacter>(
+		0xC73AC9, "\x80\x7C\x24\x1B\x00"sv, MID_HOOK_BX, MID_HOOK_VOLATILE, 0xC73C0D),
+	// Zero out bhkCharacterStateOnGround::clearZVelocityOnFall, replacing
+	// mov byte ptr [eax+8], imm8; ret
+	code_patch(0xCD47F1, "\xC6\x40\x08\x00\xC3"sv, "\xC6\x40\x08\x00\xC3"sv, "\xFF\xFF\xFF\x00\xFF"sv),
+	// Don't zero Z velocity with no input on ground
+	jcc_to_jmp(0xC7386A),
+	// Allow jumping while aiming
+	jcc_to_jmp(0x9422AA),
+	// Use standard ground collision when not giving input
+	jcc_to_jmp(0xC72025),
+	// Don't factor speedPct into ground collisions
+	jcc_to_jmp(0xC7203A)
+};
+
+// Decisions computed and served from cache over the last player step
+extern "C" __declspec(dllexport) void PlayerPhysics_GetDecisionStats(UInt32 *evaluations, UInt32 *saved)
+{
+	*evaluations = g_decisionStats.lastEvaluations.load(std::memory_order_relaxed);
+	*saved = g_decisionStats.lastSaved.load(std::memory_order_relaxed);
+}
+
+// Timings of the last INI reload
+extern "C" __declspec(dllexport) void PlayerPhysics_GetIniStats(ini::LoadStats *stats)
+{
+	*stats = ini::GetLoadStats();
+}
+
+// Sampled input edges, drops and latency to the player step in QPC ticks
+extern "C" __declspec(dllexport) void PlayerPhysics_GetInputStats(input::SamplerStats *stats)
+{
+	*stats = g_input.sampler.GetStats();
+}
+
+// Patches applied at load, pages they touched and time taken to apply them
+extern "C" __declspec(dllexport) void PlayerPhysics_GetPatchStats(PatchStats *stats)
+{
+	*stats = g_patchStats;
+}
+
+// Executable memory held by hook stubs
+extern "C" __declspec(dllexport) void PlayerPhysics_GetExecStats(exec_stats *stats)
+{
+	*stats = get_exec_stats();
+}
+
+// Shared with other plugins hooking the same sites
+extern "C" __declspec(dllexport) hook_dispatch_registry *HookDispatch_GetRegistry()
+{
+	return get_local_hook_dispatch_registry();
+}
+
+#ifdef HOOK_PROFILING
+
+// Upper bound in cycles of the bucket reaching the given fraction of calls
+static uint64_t GetHookLatencyPercentile(const hook_profile &profile, double fraction)
+{
+	const auto target = (uint64_t)((double)profile.calls * fraction);
+	uint64_t seen = 0;
+
+	for (size_t bucket = 0; bucket < HOOK_PROFILE_BUCKETS; bucket++) {
+		seen += profile.buckets[bucket];
+
+		if (seen > target)
+			return 2ull << bucket;
+	}
+
+	return 0;
+}
+
+static void FormatHookProfile(const hook_profile &profile, char *buffer, size_t size)
+{
+	snprintf(
+		buffer, size, "%.*s: %llu calls, avg %llu cycles, p50 < %llu, p99 < %llu",
+		(int)profile.name.size(), profile.name.data(),
+		profile.calls,
+		profile.calls != 0 ? profile.cycles / profile.calls : 0ull,
+		GetHookLatencyPercentile(profile, .5),
+		GetHookLatencyPercentile(profile, .99));
+}
+
+static void DumpHookProfiles()
+{
+	auto *file = fopen(kHookProfilePath, "w");
+
+	if (file == nullptr)
+		return;
+
+	char line[256];
+
+	for (const auto &profile : get_hook_profiles()) {
+		FormatHookProfile(profile, line, sizeof(line));
+		fprintf(file, "%s\n", line);
+
+		// Calls per power of two cycles
+		for (const auto count : profile.buckets)
+			fprintf(file, " %llu", count);
+
+		fputc('\n', file);
+	}
+
+	fclose(file);
+}
+
+// Bumped to stop the running dump thread
+static std::atomic<uint32_t> g_hookProfileDumpGeneration;
+
+static void StartHookProfileDump()
+{
+	std::thread([generation = ++g_hookProfileDumpGeneration] {
+		while (true) {
+			std::this_thread::sleep_for(kHookProfileInterval);
+
+			if (g_hookProfileDumpGeneration != generation)
+				return;
+
+			DumpHookProfiles();
+		}
+	}).detach();
+}
+
+static void StopHookProfileDump()
+{
+	g_hookProfileDumpGeneration++;
+}
+
+DEFINE_COMMAND_PLUGIN(PlayerPhysicsHookProfile, 0, 0, nullptr);
+
+bool Cmd_PlayerPhysicsHookProfile_Execute(COMMAND_ARGS)
+{
+	char line[256];
+
+	for (const auto &profile : get_hook_profiles()) {
+		FormatHookProfile(profile, line, sizeof(line));
+		Console_Print("%s", line);
+	}
+
+	return true;
+}
+
+#endif
+
+// Install patches, then start background work. Nothing is left running on
+// failure.
+static bool Start()
+{
+	ini::Load(kIniPath);
+
+	const auto start = std::chrono::steady_clock::now();
+	auto &patches = g_patches.emplace();
+	patches.add(kPatchManifest);
+
+	// Closed by a Stop before a failed reload
+	g_hookGate.reopen();
+
+	if (g_enabled && !patches.commit())
+		return false;
+
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	g_patchStats = {
+		.patches      = (UInt32)patches.patch_count(),
+		.pages        = (UInt32)patches.page_count(),
+		.microseconds = (UInt32)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()
+	};
+
+	ini::StartWatcher(kIniPath);
+
+	const auto &settings = ini::Get();
+
+	if (settings.bTrace)
+		trace::Start(kTracePath, (size_t)std::max(settings.iTraceMaxRecords, 0));
+
+	StartInputSampler(settings);
+
+#ifdef HOOK_PROFILING
+	StartHookProfileDump();
+#endif
+
+	return true;
+}
+
+// Revert patches, wait for hooks to return, then stop background work. On
+// failure everything is left running.
+static bool Stop()
+{
+	if (!g_patches->revert())
+		return false;
+
+	if (!g_hookGate.drain(kReloadDrainTimeout)) {
+		// Disabled, the patches were already reverted and stay that way
+		if (g_enabled)
+			g_patches->commit();
+		g_hookGate.reopen();
+		return false;
+	}
+
+	ini::StopWatcher();
+	trace::Stop();
+	g_input.sampler.Stop();
+
+#ifdef HOOK_PROFILING
+	StopHookProfileDump();
+#endif
+
+	return true;
+}
+
+// Install or revert every patch while the game runs. Disabled, the game runs
+// unhooked, with no per step ShouldUsePhysics cost.
+static bool SetEnabled(int enabled)
+{
+	if (enabled == hot_reload::kEnabledToggle)
+		enabled = !g_enabled;
+	else if (enabled != 0 && enabled != 1)
+		return g_enabled;
+
+	if ((bool)enabled == g_enabled)
+		return g_enabled;
+
+	if (enabled) {
+		// Decisions cached before the patches were reverted are stale
+		if (auto *physics = GetPlayerState(); physics != nullptr)
+			InvalidateDecision(physics);
+
+		if (!g_patches->commit()) {
+			Console_Print("Player Physics: couldn't install patches, patched code may have changed while disabled");
+			return g_enabled;
+		}
+	} else if (!g_patches->revert()) {
+		Console_Print("Player Physics: patched code was overwritten, can't disable");
+		return g_enabled;
+	}
+
+	g_enabled = enabled;
+	return g_enabled;
+}
+
+static hot_reload::Handoff ExportState()
+{
+	auto handoff = hot_reload::Handoff {
+		.version           = hot_reload::kHandoffVersion,
+		.size              = sizeof(hot_reload::Handoff),
+		.current           = g_currentReload,
+		.enabled           = g_enabled,
+		.currentSetEnabled = g_currentSetEnabled
+	};
+
+	auto *player = GetPlayer();
+
+	if (player == nullptr)
+		return handoff;
+
+	auto *charCtrl = player->GetCharacterController();
+
+	if (const auto *physics = GetPhysicsState(charCtrl); physics != nullptr) {
+		const auto &airVelocity = physics->airVelocity;
+		handoff.hasPlayer = true;
+		handoff.player = {
+			.controller    = charCtrl,
+			.airVelocity   = {airVelocity.x, airVelocity.y, airVelocity.z, airVelocity.w},
+			.usedJumpInput = physics->usedJumpInput,
+			.justLanded    = physics->justLanded,
+			.fixedStep     = physics->fixedStep
+		};
 	}
+
+	return handoff;
+}
+
+static void ImportState(const hot_reload::Handoff &handoff)
+{
+	if (handoff.version != hot_reload::kHandoffVersion || handoff.size != sizeof(handoff))
+		return;
+
+	g_enabled = handoff.enabled;
+
+	if (!handoff.hasPlayer)
+		return;
+
+	const auto &player = handoff.player;
+	auto *actor = GetPlayer();
+
+	// The controller may have been recreated in between
+	if (actor == nullptr || actor->GetCharacterController() != player.controller)
+		return;
+
+	auto *physics = g_physicsStates.find_or_insert(player.controller);
+
+	if (physics == nullptr)
+		return;
+
+	physics->actor = actor;
+	physics->airVelocity = AlignedVector4(
+		player.airVelocity[0], player.airVelocity[1], player.airVelocity[2], player.airVelocity[3]);
+	physics->usedJumpInput = player.usedJumpInput;
+	physics->justLanded = player.justLanded;
+	physics->fixedStep = player.fixedStep;
+}
+
+// Replace this build with the one at kReloadPath, keeping this one running if
+// anything fails
+static bool Reload()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	void *module;
+	const auto hotLoad = hot_reload::LoadBuild(kReloadPath, &module);
+
+	if (hotLoad == nullptr) {
+		Console_Print("Player Physics: couldn't load %s", kReloadPath);
+		return false;
+	}
+
+	if (!Stop()) {
+		hot_reload::UnloadBuild(module);
+		Console_Print("Player Physics: hooks didn't return, reload cancelled");
+		return false;
+	}
+
+	const auto handoff = ExportState();
+
+	if (!hotLoad(&handoff)) {
+		hot_reload::UnloadBuild(module);
+
+		if (!Start()) {
+			g_enabled = false;
+			Console_Print("Player Physics: new build failed to patch and this one couldn't repatch, physics is disabled");
+			return false;
+		}
+
+		Console_Print("Player Physics: new build failed to patch, reload cancelled");
+		return false;
+	}
+
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	Console_Print(
+		"Player Physics: reloaded in %u ms",
+		(UInt32)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+
+	return true;
+}
+
+// Development builds only, defining PLAYER_PHYSICS_DEV
+#ifdef PLAYER_PHYSICS_DEV
+
+DEFINE_COMMAND_PLUGIN(PlayerPhysicsReload, 0, 0, nullptr);
+
+bool Cmd_PlayerPhysicsReload_Execute(COMMAND_ARGS)
+{
+	(*g_currentReload)();
+	return true;
+}
+
+#endif
+
+static ParamInfo kParams_SetPlayerPhysicsEnabled[] = {
+	{ "enabled", kParamType_Integer, 1 }
+};
+
+// SetPlayerPhysicsEnabled [0/1], toggling with no argument
+DEFINE_COMMAND_PLUGIN(SetPlayerPhysicsEnabled, 0, 1, kParams_SetPlayerPhysicsEnabled);
+
+bool Cmd_SetPlayerPhysicsEnabled_Execute(COMMAND_ARGS)
+{
+	auto enabled = (SInt32)hot_reload::kEnabledToggle;
+
+	if (!ExtractArgsEx(EXTRACT_ARGS_EX, &enabled))
+		return true;
+
+	*result = (*g_currentSetEnabled)(enabled);
+	return true;
+}
+
+DEFINE_COMMAND_PLUGIN(GetPlayerPhysicsEnabled, 0, 0, nullptr);
+
+bool Cmd_GetPlayerPhysicsEnabled_Execute(COMMAND_ARGS)
+{
+	*result = (*g_currentSetEnabled)(hot_reload::kEnabledQuery);
+	return true;
+}
+
+// Called on a new build by the build it replaces. version, size and current
+// keep their place in Handoff across versions.
+extern "C" __declspec(dllexport) bool PlayerPhysics_HotLoad(const hot_reload::Handoff *handoff)
+{
+	ImportState(*handoff);
+
+	if (!Start())
+		return false;
+
+	g_currentReload = handoff->current;
+	*g_currentReload = Reload;
+
+	// Builds from before a Handoff change keep their own enable commands
+	if (handoff->version == hot_reload::kHandoffVersion && handoff->size == sizeof(*handoff)) {
+		g_currentSetEnabled = handoff->currentSetEnabled;
+		*g_currentSetEnabled = SetEnabled;
+	}
+
+	return true;
 }
 
 extern "C" __declspec(dllexport) bool NVSEPlugin_Query(const NVSEInterface *nvse, PluginInfo *info)
@@ -359,27 +1238,25 @@ extern "C" __declspec(dllexport) bool NVSEPlugin_Query(const NVSEInterface *nvse
 
 extern "C" __declspec(dllexport) bool NVSEPlugin_Load(NVSEInterface *nvse)
 {
-	patch_call_rel32(0xCD414D, hook_MoveCharacter_wrapper);
-	patch_call_rel32(0xCD45D0, hook_MoveCharacter_wrapper);
-	patch_call_rel32(0xCD4A2A, hook_MoveCharacter_wrapper);
-	patch_call_rel32(0x94215F, hook_CheckJumpButton);
-	patch_vtable(kVtbl_bhkCharacterStateJumping, 8, hook_bhkCharacterStateJumping_UpdateVelocity);
-	patch_vtable(kVtbl_bhkCharacterStateOnGround, 8, hook_bhkCharacterStateOnGround_UpdateVelocity);
-	patch_vtable(kVtbl_bhkCharacterStateInAir, 8, hook_bhkCharacterStateInAir_UpdateVelocity);
-	patch_vtable(kVtbl_bhkCharacterController, 50, hook_bhkCharacterController_UpdateCharacterState);
-	patch_call_rel32(0xCD400B, hook_bhkCharacterController_GetFallDistance);
-	patch_call_rel32(0xCD47AB, hook_bhkCharacterController_UpdateThrowback);
-	patch_call_rel32(0xCD4AA2, hook_bhkCharacterController_UpdateThrowback);
-	patch_jmp_rel32(0xC73AC9, hook_CheckToRootCharacter);
-	// Zero out bhkCharacterStateOnGround::clearZVelocityOnFall
-	patch_code(0xCD47F1, "\xC6\x40\x08\x00\xC3");
-	// Don't zero Z velocity with no input on ground
-	patch_code(0xC7386A, "\xEB");
-	// Allow jumping while aiming
-	patch_code(0x9422AA, "\xEB");
-	// Use standard ground collision when not giving input
-	patch_code(0xC72025, "\xEB");
-	// Don't factor speedPct into ground collisions
-	patch_code(0xC7203A, "\xEB");
-	return true;
-}
\ No newline at end of file
+	static hot_reload::ReloadFunction reload = Reload;
+	static hot_reload::SetEnabledFunction setEnabled = SetEnabled;
+	g_currentReload = &reload;
+	g_currentSetEnabled = &setEnabled;
+
+#ifdef PLAYER_PHYSICS_COMMANDS
+	// Development commands go last, so they don't shift the others' opcodes
+	nvse->SetOpcodeBase(kOpcodeBase);
+	nvse->RegisterCommand(&kCommandInfo_SetPlayerPhysicsEnabled);
+	nvse->RegisterCommand(&kCommandInfo_GetPlayerPhysicsEnabled);
+
+#ifdef PLAYER_PHYSICS_DEV
+	nvse->RegisterCommand(&kCommandInfo_PlayerPhysicsReload);
+#endif
+
+#ifdef HOOK_PROFILING
+	nvse->RegisterCommand(&kCommandInfo_PlayerPhysicsHookProfile);
+#endif
+#endif
+
+	return Start();
+}
@@ -0,0 +1,195 @@
+#include "movement.h"
+#include "movement_profiles.h"
+#include "ini.h"
+#include "util/fast_math.h"
+#include <algorithm>
+#include <cmath>
+
+namespace movement {
+
+static float Length(const ini::Settings &snapshot, const vec3 &vector)
+{
+	return snapshot.bFastMath ? fast_math::length(vector) : vector.length();
+}
+
+static vec3 Normalized(const ini::Settings &snapshot, const vec3 &vector)
+{
+	return snapshot.bFastMath ? fast_math::normalized(vector) : vector.normalized();
+}
+
+template<typename Profile>
+void ApplyFriction(const ini::Settings &snapshot, const MoveParams &move, vec3 *velocity, float deltaTime)
+{
+	const auto &settings = Profile::Get(snapshot);
+	const auto speed = Length(snapshot, *velocity);
+	const auto scaleSpeed = std::max(speed, settings.fStopSpeed);
+	const auto friction = settings.fFriction * scaleSpeed * move.groundNormal.z * deltaTime;
+
+	if (friction >= speed)
+		*velocity = vec3(0, 0, 0);
+	else
+		*velocity *= 1.f - friction / speed;
+}
+
+template<typename Profile>
+void ApplyAcceleration(
+	const ini::Settings &snapshot,
+	const MoveParams &move,
+	vec3 *velocity,
+	const vec3 &moveVector,
+	bool inAir,
+	float baseSpeed,
+	float deltaTime)
+{
+	const auto &settings = Profile::Get(snapshot);
+	const auto speed = vec3::dot(*velocity, moveVector);
+	const auto maxSpeed = inAir ? baseSpeed * settings.fAirSpeed : baseSpeed;
+	const auto speedCap = std::max(baseSpeed, Length(snapshot, *velocity));
+
+	if (speed >= maxSpeed)
+		return;
+
+	const auto accelMultiplier = inAir ? settings.fAirAcceleration : settings.fAcceleration;
+	const auto scaleSpeed = std::max(baseSpeed, settings.fMinAccelScaleSpeed);
+	const auto accel = accelMultiplier * scaleSpeed * move.groundNormal.z * deltaTime;
+	*velocity += moveVector * std::min(accel, maxSpeed - speed);
+
+	if (const auto newLength = Length(snapshot, *velocity); newLength > speedCap)
+		*velocity *= speedCap / newLength;
+}
+
+vec3 GetInputVector(uint32_t moveFlags)
+{
+	auto result = vec3(0, 0, 0);
+
+	if (moveFlags & kMoveFlag_Forward)
+		result.x = 1.f;
+	else if (moveFlags & kMoveFlag_Backward)
+		result.x = -1.f;
+
+	if (moveFlags & kMoveFlag_Left)
+		result.y = -1.f;
+	else if (moveFlags & kMoveFlag_Right)
+		result.y = 1.f;
+
+	return result;
+}
+
+vec3 GetMoveVector(const ini::Settings &snapshot, const MoveParams &move, const vec3 &input)
+{
+	const auto &forward = move.forward;
+	const auto &up = move.up;
+	const auto right = vec3::cross(forward, up);
+	const auto moveVectorRaw = forward * -input.x + right * input.y + up * input.z;
+	const auto moveVector = Normalized(snapshot, moveVectorRaw);
+	const auto &normal = move.groundNormal;
+
+	if (normal.z <= 1e-4f || normal.z >= 1.f - 1e-4f)
+		return moveVector;
+
+	const auto dot = vec3::dot(moveVector, normal);
+	return Normalized(snapshot, vec3(moveVector.x, moveVector.y, -dot / normal.z));
+}
+
+template<typename Profile>
+void UpdateVelocity(
+	const ini::Settings &snapshot,
+	const MoveParams &move,
+	const MoveInput &input,
+	vec3 *velocity,
+	float deltaTime,
+	Integrator integrator)
+{
+	const auto hasInput = (input.moveFlags & kMoveMask) != 0;
+
+	// In the air, capped acceleration alone is already exact as an Euler step
+	if (integrator == Integrator::Exact && !input.inAir) {
+		if (!hasInput) {
+			ApplyFrictionExact<Profile>(snapshot, move, velocity, deltaTime);
+		} else {
+			const auto moveVector = GetMoveVector(snapshot, move, GetInputVector(input.moveFlags));
+			ApplyGroundMoveExact<Profile>(snapshot, move, velocity, moveVector, input.moveSpeed, deltaTime);
+		}
+		return;
+	}
+
+	if (!input.inAir)
+		ApplyFriction<Profile>(snapshot, move, velocity, deltaTime);
+
+	if (hasInput) {
+		const auto inputVector = GetInputVector(input.moveFlags);
+		const auto moveVector = GetMoveVector(snapshot, move, inputVector);
+		ApplyAcceleration<Profile>(
+			snapshot, move, velocity, moveVector, input.inAir, input.moveSpeed, deltaTime);
+	}
+}
+
+template<typename Profile>
+void UpdateVelocityFixed(
+	const ini::Settings &snapshot,
+	const MoveParams &move,
+	const MoveInput &input,
+	FixedStepState *state,
+	vec3 *velocity,
+	float deltaTime,
+	float tickTime,
+	int maxSubsteps,
+	Integrator integrator)
+{
+	// Ticks of another length don't carry over
+	if (state->tickTime != tickTime)
+		*state = {.tickTime = tickTime};
+
+	// Carry over collisions etc. applied since the last output
+	const auto offset = *velocity - state->output;
+	state->previous += offset;
+	state->current += offset;
+
+	state->accumulator = std::min(state->accumulator + deltaTime, tickTime * maxSubsteps);
+
+	while (state->accumulator >= tickTime) {
+		state->previous = state->current;
+		UpdateVelocity<Profile>(snapshot, move, input, &state->current, tickTime, integrator);
+		state->accumulator -= tickTime;
+	}
+
+	const auto alpha = state->accumulator / tickTime;
+	state->output = vec3::lerp(state->previous, state->current, alpha);
+	*velocity = state->output;
+}
+
+template<typename Profile>
+vec3 GetThrowbackImpulse(const ini::Settings &snapshot, float throwbackTimer, const vec3 &throwbackVelocity)
+{
+	// Scale based on total distance moved in vanilla
+	const auto scale = throwbackTimer * throwbackTimer * .5f;
+	return throwbackVelocity * (scale * Profile::Get(snapshot).fKnockbackScale);
+}
+
+template<typename Profile>
+float GetLandingPenalty(const ini::Settings &snapshot, const vec3 &velocity, const vec3 &airVelocity)
+{
+	const auto &settings = Profile::Get(snapshot);
+	const auto delta = Length(snapshot, velocity - airVelocity);
+	const auto exponent = -delta / settings.fLandingPenaltyImpactSpeed50;
+	return snapshot.bFastMath ? fast_math::exp2(exponent) : exp2f(exponent);
+}
+
+#define INSTANTIATE_MOVEMENT(Profile) \
+	template void ApplyFriction<Profile>(const ini::Settings&, const MoveParams&, vec3*, float); \
+	template void ApplyAcceleration<Profile>( \
+		const ini::Settings&, const MoveParams&, vec3*, const vec3&, bool, float, float); \
+	template void UpdateVelocity<Profile>( \
+		const ini::Settings&, const MoveParams&, const MoveInput&, vec3*, float, Integrator); \
+	template void UpdateVelocityFixed<Profile>( \
+		const ini::Settings&, const MoveParams&, const MoveInput&, FixedStepState*, vec3*, \
+		float, float, int, Integrator); \
+	template vec3 GetThrowbackImpulse<Profile>(const ini::Settings&, float, const vec3&); \
+	template float GetLandingPenalty<Profile>(const ini::Settings&, const vec3&, const vec3&);
+
+#define INSTANTIATE_MOVEMENT_CONSTANT(name) INSTANTIATE_MOVEMENT(ConstantProfile<profiles::name>)
+
+INSTANTIATE_MOVEMENT(RuntimeProfile)
+MOVEMENT_PROFILES(INSTANTIATE_MOVEMENT_CONSTANT)
+
+} // namespace movement
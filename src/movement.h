@@ -0,0 +1,134 @@
+#pragma once
+
+#include "ini.h"
+#include "util/vector.h"
+#include <cstdint>
+
+// Game-independent movement model. Everything here operates on plain vectors
+// in Havok units so it can be driven outside of the game.
+namespace movement {
+
+// Mirrors ActorMover::MovementFlags
+enum MoveFlags : uint32_t {
+	kMoveFlag_Forward  = 1 << 0,
+	kMoveFlag_Backward = 1 << 1,
+	kMoveFlag_Left     = 1 << 2,
+	kMoveFlag_Right    = 1 << 3,
+	kMoveMask          = kMoveFlag_Forward | kMoveFlag_Backward |
+	                     kMoveFlag_Left    | kMoveFlag_Right
+};
+
+// The parts of the game's CharacterMoveParams used by the model
+struct MoveParams {
+	vec3 forward;
+	vec3 up;
+	vec3 groundNormal;
+};
+
+struct MoveInput {
+	uint32_t moveFlags;
+	float moveSpeed;
+	bool inAir;
+};
+
+enum class Integrator {
+	// Explicit Euler step, matching the original model at small time steps
+	Euler,
+	// Closed form solution, independent of step length
+	Exact
+};
+
+// Tunables from the snapshot passed to the kernel
+struct RuntimeProfile {
+	static const ini::Settings &Get(const ini::Settings &snapshot) { return snapshot; }
+};
+
+// Tunables fixed at compile time, folded into the instantiated kernel
+template<const ini::Settings &Settings>
+struct ConstantProfile {
+	static constexpr const ini::Settings &Get(const ini::Settings&) { return Settings; }
+};
+
+// Accumulated time and the last two ticks of a fixed timestep update
+struct FixedStepState {
+	// Tick length the state was built up with
+	float tickTime = 0.f;
+	float accumulator = 0.f;
+	vec3 previous;
+	vec3 current;
+	vec3 output;
+};
+
+// Everything below takes the caller's INI snapshot, loaded once per step.
+// Movement tunables come from Profile::Get(snapshot) and bFastMath from the
+// snapshot itself (see iProfile in ini.h). Templates are instantiated for
+// RuntimeProfile and each profile in movement_profiles.h, so the constant
+// profiles' tunables fold into every building block.
+
+template<typename Profile = RuntimeProfile>
+void ApplyFriction(const ini::Settings &snapshot, const MoveParams &move, vec3 *velocity, float deltaTime);
+
+template<typename Profile = RuntimeProfile>
+void ApplyAcceleration(
+	const ini::Settings &snapshot,
+	const MoveParams &move,
+	vec3 *velocity,
+	const vec3 &moveVector,
+	bool inAir,
+	float baseSpeed,
+	float deltaTime);
+
+vec3 GetInputVector(uint32_t moveFlags);
+
+vec3 GetMoveVector(const ini::Settings &snapshot, const MoveParams &move, const vec3 &input);
+
+// Friction over deltaTime solved exactly: exponential decay above the stop
+// speed, constant deceleration below it
+template<typename Profile = RuntimeProfile>
+void ApplyFrictionExact(const ini::Settings &snapshot, const MoveParams &move, vec3 *velocity, float deltaTime);
+
+// Simultaneous ground friction and capped acceleration solved exactly
+template<typename Profile = RuntimeProfile>
+void ApplyGroundMoveExact(
+	const ini::Settings &snapshot,
+	const MoveParams &move,
+	vec3 *velocity,
+	const vec3 &moveVector,
+	float baseSpeed,
+	float deltaTime);
+
+template<typename Profile = RuntimeProfile>
+void UpdateVelocity(
+	const ini::Settings &snapshot,
+	const MoveParams &move,
+	const MoveInput &input,
+	vec3 *velocity,
+	float deltaTime,
+	Integrator integrator = Integrator::Euler);
+
+// Runs UpdateVelocity in fixed ticks of tickTime, outputting the velocity
+// interpolated between the last two ticks. At most maxSubsteps ticks are run
+// per call, dropping time beyond that. tickTime must be positive and
+// maxSubsteps at least 1. Changing tickTime starts the state over, and it
+// should be reset when switching in from variable steps.
+template<typename Profile = RuntimeProfile>
+void UpdateVelocityFixed(
+	const ini::Settings &snapshot,
+	const MoveParams &move,
+	const MoveInput &input,
+	FixedStepState *state,
+	vec3 *velocity,
+	float deltaTime,
+	float tickTime,
+	int maxSubsteps,
+	Integrator integrator = Integrator::Euler);
+
+// Velocity to add for a pending throwback
+template<typename Profile = RuntimeProfile>
+vec3 GetThrowbackImpulse(const ini::Settings &snapshot, float throwbackTimer, const vec3 &throwbackVelocity);
+
+// Velocity scale to apply on landing
+template<typename Profile = RuntimeProfile>
+float GetLandingPenalty(const ini::Settings &snapshot, const vec3 &velocity, const vec3 &airVelocity);
+
+} // namespace movement
@@ -0,0 +1,305 @@
+#include "movement_batch.h"
+#include "movement.h"
+#include "ini.h"
+#include <cfloat>
+#include <cstddef>
+#include <immintrin.h>
+
+namespace {
+
+struct f32x4 {
+	static constexpr size_t width = 4;
+
+	__m128 v;
+
+	f32x4(__m128 v) : v(v) {}
+	f32x4(float value) : v(_mm_set1_ps(value)) {}
+
+	static f32x4 load(const float *p) { return _mm_loadu_ps(p); }
+	void store(float *p) const { _mm_storeu_ps(p, v); }
+
+	static f32x4 mask(const bool *p)
+	{
+		return _mm_castsi128_ps(_mm_set_epi32(-p[3], -p[2], -p[1], -p[0]));
+	}
+
+	// Lanes whose flags have bit set
+	static f32x4 mask(const uint32_t *flags, uint32_t bit)
+	{
+		const auto bits = _mm_set1_epi32((int)bit);
+		const auto masked = _mm_and_si128(_mm_loadu_si128((const __m128i*)flags), bits);
+		return _mm_castsi128_ps(_mm_cmpeq_epi32(masked, bits));
+	}
+
+	friend f32x4 operator+(f32x4 a, f32x4 b) { return _mm_add_ps(a.v, b.v); }
+	friend f32x4 operator-(f32x4 a, f32x4 b) { return _mm_sub_ps(a.v, b.v); }
+	friend f32x4 operator*(f32x4 a, f32x4 b) { return _mm_mul_ps(a.v, b.v); }
+	friend f32x4 operator/(f32x4 a, f32x4 b) { return _mm_div_ps(a.v, b.v); }
+	friend f32x4 operator&(f32x4 a, f32x4 b) { return _mm_and_ps(a.v, b.v); }
+	friend f32x4 operator|(f32x4 a, f32x4 b) { return _mm_or_ps(a.v, b.v); }
+	friend f32x4 operator<(f32x4 a, f32x4 b) { return _mm_cmplt_ps(a.v, b.v); }
+	friend f32x4 operator>(f32x4 a, f32x4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+	friend f32x4 operator>=(f32x4 a, f32x4 b) { return _mm_cmpge_ps(a.v, b.v); }
+	friend f32x4 operator!=(f32x4 a, f32x4 b) { return _mm_cmpneq_ps(a.v, b.v); }
+
+	friend f32x4 min(f32x4 a, f32x4 b) { return _mm_min_ps(a.v, b.v); }
+	friend f32x4 max(f32x4 a, f32x4 b) { return _mm_max_ps(a.v, b.v); }
+	friend f32x4 sqrt(f32x4 a) { return _mm_sqrt_ps(a.v); }
+	friend f32x4 rsqrt_estimate(f32x4 a) { return _mm_rsqrt_ps(a.v); }
+
+	// mask ? a : b
+	friend f32x4 select(f32x4 mask, f32x4 a, f32x4 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+	}
+
+	friend bool none(f32x4 mask) { return _mm_movemask_ps(mask.v) == 0; }
+};
+
+#ifdef __AVX__
+struct f32x8 {
+	static constexpr size_t width = 8;
+
+	__m256 v;
+
+	f32x8(__m256 v) : v(v) {}
+	f32x8(float value) : v(_mm256_set1_ps(value)) {}
+
+	static f32x8 load(const float *p) { return _mm256_loadu_ps(p); }
+	void store(float *p) const { _mm256_storeu_ps(p, v); }
+
+	static f32x8 mask(const bool *p)
+	{
+		return _mm256_castsi256_ps(_mm256_set_epi32(
+			-p[7], -p[6], -p[5], -p[4], -p[3], -p[2], -p[1], -p[0]));
+	}
+
+	// Lanes whose flags have bit set. AVX has no 256 bit integer compare.
+	static f32x8 mask(const uint32_t *flags, uint32_t bit)
+	{
+		return _mm256_set_m128(f32x4::mask(flags + 4, bit).v, f32x4::mask(flags, bit).v);
+	}
+
+	friend f32x8 operator+(f32x8 a, f32x8 b) { return _mm256_add_ps(a.v, b.v); }
+	friend f32x8 operator-(f32x8 a, f32x8 b) { return _mm256_sub_ps(a.v, b.v); }
+	friend f32x8 operator*(f32x8 a, f32x8 b) { return _mm256_mul_ps(a.v, b.v); }
+	friend f32x8 operator/(f32x8 a, f32x8 b) { return _mm256_div_ps(a.v, b.v); }
+	friend f32x8 operator&(f32x8 a, f32x8 b) { return _mm256_and_ps(a.v, b.v); }
+	friend f32x8 operator|(f32x8 a, f32x8 b) { return _mm256_or_ps(a.v, b.v); }
+	friend f32x8 operator<(f32x8 a, f32x8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+	friend f32x8 operator>(f32x8 a, f32x8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+	friend f32x8 operator>=(f32x8 a, f32x8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+	friend f32x8 operator!=(f32x8 a, f32x8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ); }
+
+	friend f32x8 min(f32x8 a, f32x8 b) { return _mm256_min_ps(a.v, b.v); }
+	friend f32x8 max(f32x8 a, f32x8 b) { return _mm256_max_ps(a.v, b.v); }
+	friend f32x8 sqrt(f32x8 a) { return _mm256_sqrt_ps(a.v); }
+	friend f32x8 rsqrt_estimate(f32x8 a) { return _mm256_rsqrt_ps(a.v); }
+
+	// mask ? a : b
+	friend f32x8 select(f32x8 mask, f32x8 a, f32x8 b)
+	{
+		return _mm256_blendv_ps(b.v, a.v, mask.v);
+	}
+
+	friend bool none(f32x8 mask) { return _mm256_movemask_ps(mask.v) == 0; }
+};
+
+using f32xN = f32x8;
+#else
+using f32xN = f32x4;
+#endif
+
+template<typename T>
+struct vec3xN {
+	T x, y, z;
+
+	static vec3xN load(const auto &soa, size_t i)
+	{
+		return { T::load(soa.x + i), T::load(soa.y + i), T::load(soa.z + i) };
+	}
+
+	void store(const auto &soa, size_t i) const
+	{
+		x.store(soa.x + i);
+		y.store(soa.y + i);
+		z.store(soa.z + i);
+	}
+
+	friend vec3xN operator+(const vec3xN &a, const vec3xN &b)
+	{
+		return { a.x + b.x, a.y + b.y, a.z + b.z };
+	}
+
+	friend vec3xN operator*(const vec3xN &a, T b)
+	{
+		return { a.x * b, a.y * b, a.z * b };
+	}
+
+	friend T dot(const vec3xN &a, const vec3xN &b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	friend vec3xN cross(const vec3xN &a, const vec3xN &b)
+	{
+		return {
+			a.y * b.z - a.z * b.y,
+			a.z * b.x - a.x * b.z,
+			a.x * b.y - a.y * b.x
+		};
+	}
+
+	friend vec3xN select(T mask, const vec3xN &a, const vec3xN &b)
+	{
+		return { select(mask, a.x, b.x), select(mask, a.y, b.y), select(mask, a.z, b.z) };
+	}
+
+	// fast_math's refined estimate where it's accurate, as with bFastMath
+	T length(bool fast) const
+	{
+		const auto len_sqr = dot(*this, *this);
+		const auto exact = sqrt(len_sqr);
+		return fast ? select(in_fast_range(len_sqr), len_sqr * rsqrt(len_sqr), exact) : exact;
+	}
+
+	vec3xN normalized(bool fast) const
+	{
+		const auto len_sqr = dot(*this, *this);
+		const auto exact = select(len_sqr != 0.f, *this * (T(1.f) / sqrt(len_sqr)), *this);
+		return fast ? select(in_fast_range(len_sqr), *this * rsqrt(len_sqr), exact) : exact;
+	}
+
+private:
+	static T in_fast_range(T len_sqr)
+	{
+		return (len_sqr >= T(FLT_MIN)) & (T(FLT_MAX) >= len_sqr);
+	}
+
+	static T rsqrt(T x)
+	{
+		const auto estimate = rsqrt_estimate(x);
+		return estimate * (T(1.5f) - T(.5f) * x * estimate * estimate);
+	}
+};
+
+// GetInputVector for each lane
+template<typename T>
+vec3xN<T> GetInputLanes(const uint32_t *moveFlags)
+{
+	using namespace movement;
+
+	const auto forward = T::mask(moveFlags, kMoveFlag_Forward);
+	const auto backward = T::mask(moveFlags, kMoveFlag_Backward);
+	const auto left = T::mask(moveFlags, kMoveFlag_Left);
+	const auto right = T::mask(moveFlags, kMoveFlag_Right);
+
+	return {
+		select(forward, T(1.f), select(backward, T(-1.f), T(0.f))),
+		select(left, T(-1.f), select(right, T(1.f), T(0.f))),
+		T(0.f)
+	};
+}
+
+template<typename T>
+void UpdateVelocityLanes(
+	const movement::MoveBatch &batch,
+	size_t i,
+	const ini::Settings &snapshot,
+	const ini::Settings &settings,
+	float deltaTime)
+{
+	using V = vec3xN<T>;
+
+	auto velocity = V::load(batch.velocity, i);
+	const auto normal = V::load(batch.groundNormal, i);
+	const auto baseSpeed = T::load(batch.moveSpeed + i);
+	const auto inAir = T::mask(batch.inAir + i);
+	const auto dt = T(deltaTime);
+	const auto fast = snapshot.bFastMath != 0;
+
+	// Friction
+	{
+		const auto speed = velocity.length(fast);
+		const auto scaleSpeed = max(speed, T(settings.fStopSpeed));
+		const auto friction = T(settings.fFriction) * scaleSpeed * normal.z * dt;
+		const auto scale = select(friction >= speed, T(0.f), T(1.f) - friction / speed);
+		velocity = select(inAir, velocity, velocity * scale);
+	}
+
+	const auto input = GetInputLanes<T>(batch.moveFlags + i);
+	const auto hasInput = (input.x != 0.f) | (input.y != 0.f);
+
+	if (none(hasInput)) {
+		velocity.store(batch.velocity, i);
+		return;
+	}
+
+	// Move vector with slope projection
+	const auto forward = V::load(batch.forward, i);
+	const auto up = V::load(batch.up, i);
+	const auto right = cross(forward, up);
+	const auto moveRaw = forward * (T(0.f) - input.x) + right * input.y + up * input.z;
+	auto moveVector = moveRaw.normalized(fast);
+
+	const auto onSlope = (normal.z > 1e-4f) & (normal.z < 1.f - 1e-4f);
+	const auto slopeZ = (T(0.f) - dot(moveVector, normal)) / normal.z;
+	const auto projected = V { moveVector.x, moveVector.y, slopeZ }.normalized(fast);
+	moveVector = select(onSlope, projected, moveVector);
+
+	// Acceleration
+	const auto speed = dot(velocity, moveVector);
+	const auto maxSpeed = select(inAir, baseSpeed * T(settings.fAirSpeed), baseSpeed);
+	const auto speedCap = max(baseSpeed, velocity.length(fast));
+	const auto accelerate = hasInput & (speed < maxSpeed);
+
+	const auto accelMultiplier = select(inAir, T(settings.fAirAcceleration), T(settings.fAcceleration));
+	const auto scaleSpeed = max(baseSpeed, T(settings.fMinAccelScaleSpeed));
+	const auto accel = accelMultiplier * scaleSpeed * normal.z * dt;
+	auto accelerated = velocity + moveVector * min(accel, maxSpeed - speed);
+
+	const auto newLength = accelerated.length(fast);
+	const auto capped = accelerated * (speedCap / newLength);
+	accelerated = select(newLength > speedCap, capped, accelerated);
+
+	select(accelerate, accelerated, velocity).store(batch.velocity, i);
+}
+
+} // namespace
+
+namespace movement {
+
+void UpdateVelocityBatch(
+	const ini::Settings &snapshot, const MoveBatch &batch, const ProfileKernels &kernels, float deltaTime)
+{
+	constexpr auto width = f32xN::width;
+
+	const auto &settings = kernels.getSettings(snapshot);
+	size_t i = 0;
+
+	for (; i + width <= batch.count; i += width)
+		UpdateVelocityLanes<f32xN>(batch, i, snapshot, settings, deltaTime);
+
+	for (; i < batch.count; i++) {
+		const auto move = MoveParams {
+			.forward      = vec3(batch.forward.x[i], batch.forward.y[i], batch.forward.z[i]),
+			.up           = vec3(batch.up.x[i], batch.up.y[i], batch.up.z[i]),
+			.groundNormal = vec3(batch.groundNormal.x[i], batch.groundNormal.y[i],
+			                     batch.groundNormal.z[i])
+		};
+
+		const auto input = MoveInput {
+			.moveFlags = batch.moveFlags[i],
+			.moveSpeed = batch.moveSpeed[i],
+			.inAir     = batch.inAir[i]
+		};
+
+		auto velocity = vec3(batch.velocity.x[i], batch.velocity.y[i], batch.velocity.z[i]);
+		kernels.updateVelocity(snapshot, move, input, &velocity, deltaTime, Integrator::Euler);
+		batch.velocity.x[i] = velocity.x;
+		batch.velocity.y[i] = velocity.y;
+		batch.velocity.z[i] = velocity.z;
+	}
+}
+
+} // namespace movement
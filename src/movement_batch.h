@@ -0,0 +1,35 @@
+#pragma once
+
+#include "movement_profiles.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace movement {
+
+// Structure-of-arrays view of a vector component set
+template<typename T>
+struct soa_vec3 {
+	T *x, *y, *z;
+};
+
+// Batched equivalent of UpdateVelocity for many character controllers. Each
+// array holds one element per controller.
+struct MoveBatch {
+	size_t count;
+	soa_vec3<float> velocity;
+	soa_vec3<const float> forward;
+	soa_vec3<const float> up;
+	soa_vec3<const float> groundNormal;
+	const uint32_t *moveFlags;
+	const float *moveSpeed;
+	const bool *inAir;
+};
+
+// Runs friction, acceleration and slope projection for 4 (SSE) or 8 (AVX)
+// controllers per instruction with the tunables of kernels' profile, and the
+// rest through kernels.updateVelocity. Always takes Euler steps. Results match
+// UpdateVelocity within rounding.
+void UpdateVelocityBatch(
+	const ini::Settings &snapshot, const MoveBatch &batch, const ProfileKernels &kernels, float deltaTime);
+
+} // namespace movement
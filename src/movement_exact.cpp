@@ -0,0 +1,620 @@
+#include "movement.h"
+#include "movement_profiles.h"
+#include "ini.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr auto kMaxSegments = 16;
+constexpr auto kNone = std::numeric_limits<float>::infinity();
+
+// Roots of a*x^2 + b*x + c in ascending order, NaN if none
+std::pair<float, float> SolveQuadratic(float a, float b, float c)
+{
+	constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+
+	if (a == 0.f)
+		return b != 0.f ? std::make_pair(-c / b, -c / b) : std::make_pair(nan, nan);
+
+	const auto discriminant = b * b - 4.f * a * c;
+
+	if (discriminant < 0.f)
+		return {nan, nan};
+
+	const auto root = std::sqrt(discriminant);
+	const auto x0 = (-b - root) / (2.f * a);
+	const auto x1 = (-b + root) / (2.f * a);
+	return {std::min(x0, x1), std::max(x0, x1)};
+}
+
+// First t in (0, limit] where f(t) >= 0 given f(0) < 0, or kNone
+float FindCrossing(auto &&f, float limit)
+{
+	if (f(limit) < 0.f)
+		return kNone;
+
+	auto lo = 0.f;
+	auto hi = limit;
+
+	for (auto i = 0; i < 24; i++) {
+		const auto mid = (lo + hi) * .5f;
+		(f(mid) < 0.f ? lo : hi) = mid;
+	}
+
+	return hi;
+}
+
+// Root of f in [lo, hi], where f changes sign, starting from x. f returns its
+// value and slope, and Newton steps that leave the shrinking bracket fall back
+// to bisection.
+double FindRoot(auto &&f, double lo, double hi, double x)
+{
+	constexpr auto kIterations = 64;
+	constexpr auto kTolerance = 1e-9;
+
+	const auto loSign = f(lo).first < 0.;
+
+	for (auto i = 0; i < kIterations; i++) {
+		const auto [value, slope] = f(x);
+
+		if (value == 0.)
+			return x;
+
+		((value < 0.) == loSign ? lo : hi) = x;
+
+		auto next = x - value / slope;
+		if (!(next > lo && next < hi))
+			next = (lo + hi) * .5;
+
+		if (std::abs(next - x) <= kTolerance * std::max(1., std::abs(x)))
+			return next;
+
+		x = next;
+	}
+
+	return x;
+}
+
+// Simultaneous ground friction and capped acceleration:
+//
+//   dv/dt = -k * max(|v|, stop) * v/|v| + accel * moveVector
+//
+// where acceleration only tops the speed along moveVector up to maxSpeed, and
+// may not take |v| past max(maxSpeed, |v|) so beyond that it only rotates v.
+// v is split into p along moveVector and q perpendicular to it, and the step
+// is solved in segments between regime changes, each of which has a closed
+// form.
+class GroundMoveSolver {
+	enum class Regime {
+		// Below maxSpeed, or above it along moveVector with no acceleration
+		Free,
+		// Above maxSpeed, friction slows v while acceleration rotates it
+		Capped,
+		// Above maxSpeed with p held at maxSpeed
+		Sliding,
+		// Held at maxSpeed, acceleration rotates v
+		Rim
+	};
+
+	float k;
+	float accel;
+	float stopSpeed;
+	float maxSpeed;
+	float p;
+	float q;
+	Regime regime;
+	// Below stopSpeed friction has constant magnitude
+	bool lowSpeed;
+
+	float Speed() const
+	{
+		return std::sqrt(p * p + q * q);
+	}
+
+	float Friction() const
+	{
+		return lowSpeed ? k * stopSpeed : k * maxSpeed;
+	}
+
+	// Time for friction alone to slow from speed to target
+	float DecayTime(float speed, float target) const
+	{
+		if (target <= 0.f || target > speed)
+			return kNone;
+
+		return lowSpeed ? (speed - target) / (k * stopSpeed) : std::log(speed / target) / k;
+	}
+
+	float SpeedAfter(float speed, float t) const
+	{
+		return lowSpeed ? speed - k * stopSpeed * t : speed * std::exp(-k * t);
+	}
+
+	// Slowest speed at which acceleration can hold p at maxSpeed, where
+	// accel * sin^2(theta) >= friction along moveVector
+	float SlidingMinSpeed() const
+	{
+		if (!lowSpeed) {
+			const auto ratio = 1.f - k * maxSpeed / accel;
+			return ratio > 0.f ? maxSpeed / std::sqrt(ratio) : kNone;
+		}
+
+		const auto friction = k * stopSpeed;
+		const auto b = friction * maxSpeed;
+		return (b + std::sqrt(b * b + 4.f * accel * accel * maxSpeed * maxSpeed)) / (2.f * accel);
+	}
+
+	Regime Classify()
+	{
+		const auto tolerance = 1e-5f * std::max(maxSpeed, 1.f);
+		const auto speed = Speed();
+
+		if (p > maxSpeed + tolerance)
+			return Regime::Free;
+
+		if (p >= maxSpeed - tolerance) {
+			p = maxSpeed;
+			if (q > tolerance)
+				return speed >= SlidingMinSpeed() ? Regime::Sliding : Regime::Capped;
+		}
+
+		if (std::abs(speed - maxSpeed) <= tolerance && p >= 0.f) {
+			// Stays at maxSpeed if acceleration along v beats friction
+			return accel * p / speed >= Friction() ? Regime::Rim : Regime::Free;
+		}
+
+		return speed > maxSpeed && p >= 0.f ? Regime::Capped : Regime::Free;
+	}
+
+	// Rescale v to the given speed, for snapping to a crossed boundary
+	void SetSpeed(float speed)
+	{
+		if (const auto current = Speed(); current > 0.f) {
+			p *= speed / current;
+			q *= speed / current;
+		}
+	}
+
+	float StepFree(float time);
+	float StepPursuit(float time);
+	float StepCapped(float time);
+	float StepSliding(float time);
+	float StepRim(float time);
+
+public:
+	GroundMoveSolver(float k, float accel, float stopSpeed, float maxSpeed, float p, float q) :
+		k(k), accel(accel), stopSpeed(stopSpeed), maxSpeed(maxSpeed), p(p), q(q)
+	{
+		lowSpeed = Speed() < stopSpeed;
+		regime = Classify();
+	}
+
+	float GetP() const { return p; }
+	float GetQ() const { return q; }
+
+	void Solve(float time)
+	{
+		for (auto i = 0; i < kMaxSegments && time > 0.f; i++) {
+			switch (regime) {
+			case Regime::Free:    time -= StepFree(time);    break;
+			case Regime::Capped:  time -= StepCapped(time);  break;
+			case Regime::Sliding: time -= StepSliding(time); break;
+			case Regime::Rim:     time -= StepRim(time);     break;
+			}
+		}
+	}
+};
+
+float GroundMoveSolver::StepFree(float time)
+{
+	if (lowSpeed && p < maxSpeed && q > 0.f)
+		return StepPursuit(time);
+
+	enum Event { kNoEvent, kReachMax, kZeroP, kZeroQ, kReachMaxSpeed, kStopSpeed };
+
+	auto t = time;
+	auto event = kNoEvent;
+
+	const auto earliest = [&](float eventTime, Event type) {
+		if (eventTime >= 0.f && eventTime <= t) {
+			t = eventTime;
+			event = type;
+		}
+	};
+
+	if (lowSpeed) {
+		// Constant friction magnitude along v, and v is either along
+		// moveVector or not accelerating, so its direction is fixed
+		const auto speed = Speed();
+		const auto friction = k * stopSpeed;
+		const auto ratioP = speed > 0.f ? p / speed : 1.f;
+		const auto ratioQ = speed > 0.f ? q / speed : 0.f;
+		const auto dp = (p < maxSpeed ? accel : 0.f) - friction * ratioP;
+		const auto dq = -friction * ratioQ;
+
+		if (dp <= 0.f && p <= 0.f && q == 0.f) {
+			// Static friction holds v at rest
+			p = 0.f;
+			return time;
+		}
+
+		// Speed rising through a threshold, quadratic in t
+		const auto crossing = [&](float threshold) {
+			const auto [t0, t1] = SolveQuadratic(
+				dp * dp + dq * dq,
+				2.f * (p * dp + q * dq),
+				p * p + q * q - threshold * threshold);
+
+			for (const auto root : {t0, t1}) {
+				if (root >= 0.f && (p + dp * root) * dp + (q + dq * root) * dq > 0.f)
+					return root;
+			}
+
+			return kNone;
+		};
+
+		if (p > maxSpeed && dp < 0.f)
+			earliest((maxSpeed - p) / dp, kReachMax);
+		if (dp != 0.f && p * dp < 0.f)
+			earliest(-p / dp, kZeroP);
+		if (dq < 0.f)
+			earliest(q / -dq, kZeroQ);
+		if (const auto root = crossing(maxSpeed); p + dp * root >= 0.f)
+			earliest(root, kReachMaxSpeed);
+
+		earliest(crossing(stopSpeed), kStopSpeed);
+
+		p += dp * t;
+		q = std::max(q + dq * t, 0.f);
+	} else {
+		// Exponential relaxation of p towards target and q towards zero
+		const auto target = p < maxSpeed ? accel / k : 0.f;
+		const auto u = p - target;
+
+		const auto atDecay = [&](float x) {
+			return x > 0.f && x <= 1.f ? -std::log(x) / k : kNone;
+		};
+
+		// Speed crossing a threshold in the given direction, quadratic in
+		// x = e^-kt. Roots are checked in time order, largest x first.
+		const auto crossing = [&](float threshold, bool rising) {
+			const auto [x0, x1] = SolveQuadratic(
+				u * u + q * q,
+				2.f * target * u,
+				target * target - threshold * threshold);
+
+			for (const auto x : {x1, x0}) {
+				// Speed rises over time where |v|^2 falls with x. A root
+				// where speed only touches the threshold isn't a crossing,
+				// e.g. starting at rest with a stop speed of 0.
+				const auto slope = u * (target + u * x) + q * q * x;
+				if (x > 0.f && x <= 1.f && (rising ? slope < 0.f : slope > 0.f))
+					return atDecay(x);
+			}
+
+			return kNone;
+		};
+
+		if (p > maxSpeed)
+			earliest(atDecay(maxSpeed / p), kReachMax);
+		if (p < 0.f && target > 0.f)
+			earliest(atDecay(-target / u), kZeroP);
+		if (const auto root = crossing(maxSpeed, true); root < kNone) {
+			// Only caps with v facing along moveVector
+			if (target + u * std::exp(-k * root) >= 0.f)
+				earliest(root, kReachMaxSpeed);
+		}
+
+		// Nothing is below a stop speed of 0
+		if (stopSpeed > 0.f)
+			earliest(crossing(stopSpeed, false), kStopSpeed);
+
+		const auto decay = std::exp(-k * t);
+		p = target + u * decay;
+		q *= decay;
+	}
+
+	// Snap to whichever boundary was hit
+	switch (event) {
+	case kReachMax:      p = maxSpeed;       break;
+	case kZeroP:         p = 0.f;            break;
+	case kZeroQ:         q = 0.f;            break;
+	case kReachMaxSpeed: SetSpeed(maxSpeed); break;
+	case kStopSpeed:     lowSpeed = !lowSpeed; break;
+	default:             break;
+	}
+
+	if (event != kNoEvent)
+		regime = Classify();
+
+	return t;
+}
+
+float GroundMoveSolver::StepPursuit(float time)
+{
+	// Constant acceleration along moveVector against constant friction along
+	// v traces a pursuit curve. With u = tan(theta/2) and r = friction/accel:
+	//
+	//   |v|  = K * u^(r-1) * (1 + u^2) / 2
+	//   t(u) = K / (2 * accel) * (F(u0) - F(u)), F(u) = I(u, r-1) + I(u, r+1)
+	//
+	// where I(u, e) = u^e / e, or ln(u) for e = 0. u only falls over time,
+	// and |v| falls until cos(theta) = r then rises. The end of the segment
+	// and any threshold crossing are found with Newton steps on w = ln(u),
+	// where dt/dw = -|v| / accel.
+	enum Event { kNoEvent, kReachMaxSpeed, kStopSpeed, kPerpendicular, kAligned };
+
+	constexpr auto kLogRange = 40.;
+
+	const double a = accel;
+	const double r = k * stopSpeed / accel;
+	const double w0 = std::log(std::tan(std::atan2((double)q, (double)p) * .5));
+	const double c0 = std::exp((r - 1.) * w0);
+	const double c1 = c0 * std::exp(2. * w0);
+	const double K = 2. * Speed() / (c0 + c1);
+
+	struct Point {
+		double time;
+		double speed;
+		double speedSlope;
+	};
+
+	const auto at = [&](double w) {
+		const auto d = w - w0;
+		const auto e0 = std::expm1((r - 1.) * d);
+		const auto e1 = std::expm1((r + 1.) * d);
+		return Point {
+			.time       = -K / (2. * a) * (c0 * (r == 1. ? d : e0 / (r - 1.)) + c1 * e1 / (r + 1.)),
+			.speed      = K * .5 * (c0 * (e0 + 1.) + c1 * (e1 + 1.)),
+			.speedSlope = K * .5 * (c0 * (r - 1.) * (e0 + 1.) + c1 * (r + 1.) * (e1 + 1.))
+		};
+	};
+
+	const auto wMin = w0 - kLogRange;
+	auto w = wMin;
+	auto event = kAligned;
+
+	if (at(wMin).time > time) {
+		w = FindRoot([&](double w) {
+			const auto point = at(w);
+			return std::make_pair(point.time - time, -point.speed / a);
+		}, wMin, w0, w0);
+		event = kNoEvent;
+	}
+
+	if (w0 > 0. && w < 0. && at(0.).speed > maxSpeed) {
+		// Turning past perpendicular above maxSpeed, from where acceleration
+		// is capped at |v|
+		w = 0.;
+		event = kPerpendicular;
+	} else if (r < 1.) {
+		// |v| rises once cos(theta) = r, possibly through a threshold
+		const auto wTurn = std::min(.5 * std::log((1. - r) / (1. + r)), w0);
+		const auto threshold = std::min(maxSpeed, stopSpeed);
+
+		if (w < wTurn && at(w).speed >= threshold) {
+			w = FindRoot([&](double w) {
+				const auto point = at(w);
+				return std::make_pair(point.speed - threshold, point.speedSlope);
+			}, w, wTurn, w);
+			event = threshold == maxSpeed ? kReachMaxSpeed : kStopSpeed;
+		}
+	}
+
+	const auto end = at(w);
+	const auto elapsed = std::min((float)end.time, time);
+	const auto speed = (float)end.speed;
+
+	// cos and sin of theta from u = tan(theta/2)
+	const auto u = std::exp(w);
+	p = speed * (float)((1. - u * u) / (1. + u * u));
+	q = speed * (float)(2. * u / (1. + u * u));
+
+	switch (event) {
+	case kReachMaxSpeed:
+		SetSpeed(maxSpeed);
+		break;
+	case kStopSpeed:
+		SetSpeed(stopSpeed);
+		lowSpeed = false;
+		break;
+	case kPerpendicular:
+		p = 0.f;
+		break;
+	case kAligned:
+		// Along moveVector, or brought to rest if friction wins
+		p = r < 1. ? speed : 0.f;
+		q = 0.f;
+		break;
+	default:
+		return time;
+	}
+
+	regime = Classify();
+	return elapsed;
+}
+
+float GroundMoveSolver::StepCapped(float time)
+{
+	// |v| follows friction alone while acceleration rotates v towards
+	// moveVector at a rate of accel * sin(theta) / |v|, which separates to
+	// tan(theta/2) = tan(theta0/2) * g(t).
+	const auto speed = Speed();
+	const auto halfTan = std::tan(std::atan2(q, p) * .5f);
+	const auto friction = k * stopSpeed;
+
+	const auto halfTanAt = [&](float t) {
+		if (lowSpeed)
+			return halfTan * std::pow(SpeedAfter(speed, t) / speed, accel / friction);
+		else
+			return halfTan * std::exp(-accel / (k * speed) * (std::exp(k * t) - 1.f));
+	};
+
+	const auto componentsAt = [&](float t) {
+		const auto theta = 2.f * std::atan(halfTanAt(t));
+		const auto s = SpeedAfter(speed, t);
+		return std::make_pair(s * std::cos(theta), s * std::sin(theta));
+	};
+
+	auto t = time;
+	const auto toMaxSpeed = DecayTime(speed, maxSpeed);
+	const auto toStopSpeed = lowSpeed ? kNone : DecayTime(speed, stopSpeed);
+
+	t = std::min({t, toMaxSpeed, toStopSpeed});
+
+	// p rises while turning v outpaces friction along moveVector, and can
+	// peak past maxSpeed before falling back within the step
+	const auto slopeAt = [&](float t) {
+		const auto [p, q] = componentsAt(t);
+		const auto s = SpeedAfter(speed, t);
+		return (accel * q * q / s - (lowSpeed ? friction : k * s) * p) / s;
+	};
+
+	// Classify only leaves p at maxSpeed here when it's falling
+	const auto peak = p < maxSpeed && slopeAt(0.f) > 0.f
+		? std::min(FindCrossing([&](float t) { return -slopeAt(t); }, t), t)
+		: 0.f;
+
+	// p reaching maxSpeed
+	const auto toMax = peak > 0.f ? FindCrossing([&](float t) {
+		return componentsAt(t).first - maxSpeed;
+	}, peak) : kNone;
+
+	t = std::min(t, toMax);
+
+	std::tie(p, q) = componentsAt(t);
+
+	if (t == toMax) {
+		p = maxSpeed;
+	} else if (t == toMaxSpeed) {
+		SetSpeed(maxSpeed);
+	} else if (t == toStopSpeed) {
+		lowSpeed = true;
+		return t;
+	} else {
+		return t;
+	}
+
+	regime = Classify();
+	return t;
+}
+
+float GroundMoveSolver::StepSliding(float time)
+{
+	// Acceleration tops p back up to maxSpeed as fast as friction slows v,
+	// so only q shrinks, with |v| following friction alone
+	const auto speed = Speed();
+	const auto toMaxSpeed = DecayTime(speed, maxSpeed);
+	const auto toStopSpeed = lowSpeed ? kNone : DecayTime(speed, stopSpeed);
+	const auto toRelease = DecayTime(speed, SlidingMinSpeed());
+	const auto t = std::min({time, toMaxSpeed, toStopSpeed, toRelease});
+	const auto newSpeed = SpeedAfter(speed, t);
+
+	q = std::sqrt(std::max(newSpeed * newSpeed - maxSpeed * maxSpeed, 0.f));
+
+	if (t == toMaxSpeed) {
+		q = 0.f;
+		regime = Classify();
+	} else if (t == toStopSpeed) {
+		lowSpeed = true;
+		regime = Classify();
+	} else if (t == toRelease) {
+		regime = Regime::Capped;
+	}
+
+	return t;
+}
+
+float GroundMoveSolver::StepRim(float time)
+{
+	// |v| stays at maxSpeed and v rotates towards moveVector, with
+	// tan(theta/2) = tan(theta0/2) * e^(-accel * t / maxSpeed)
+	const auto halfTan = std::tan(std::atan2(q, p) * .5f);
+	const auto theta = 2.f * std::atan(halfTan * std::exp(-accel * time / maxSpeed));
+	p = maxSpeed * std::cos(theta);
+	q = maxSpeed * std::sin(theta);
+	return time;
+}
+
+} // namespace
+
+namespace movement {
+
+template<typename Profile>
+void ApplyFrictionExact(const ini::Settings &snapshot, const MoveParams &move, vec3 *velocity, float deltaTime)
+{
+	const auto &settings = Profile::Get(snapshot);
+	const auto k = settings.fFriction * move.groundNormal.z;
+	const auto speed = velocity->length();
+
+	if (k <= 0.f || speed == 0.f)
+		return;
+
+	auto newSpeed = speed;
+	auto time = deltaTime;
+
+	if (newSpeed > settings.fStopSpeed) {
+		const auto timeToStop = std::log(newSpeed / settings.fStopSpeed) / k;
+
+		if (timeToStop >= time) {
+			*velocity *= std::exp(-k * time);
+			return;
+		}
+
+		newSpeed = settings.fStopSpeed;
+		time -= timeToStop;
+	}
+
+	newSpeed = std::max(newSpeed - k * settings.fStopSpeed * time, 0.f);
+	*velocity *= newSpeed / speed;
+}
+
+template<typename Profile>
+void ApplyGroundMoveExact(
+	const ini::Settings &snapshot,
+	const MoveParams &move,
+	vec3 *velocity,
+	const vec3 &moveVector,
+	float baseSpeed,
+	float deltaTime)
+{
+	const auto &settings = Profile::Get(snapshot);
+	const auto nz = move.groundNormal.z;
+	const auto k = settings.fFriction * nz;
+	const auto scaleSpeed = std::max(baseSpeed, settings.fMinAccelScaleSpeed);
+	const auto accel = settings.fAcceleration * scaleSpeed * nz;
+
+	// With either term missing the other is exact on its own
+	if (k <= 0.f || accel <= 0.f || baseSpeed <= 0.f) {
+		ApplyFrictionExact<Profile>(snapshot, move, velocity, deltaTime);
+		ApplyAcceleration<Profile>(snapshot, move, velocity, moveVector, false, baseSpeed, deltaTime);
+		return;
+	}
+
+	const auto p = vec3::dot(*velocity, moveVector);
+	const auto perpendicular = *velocity - moveVector * p;
+	const auto q = perpendicular.length();
+
+	auto solver = GroundMoveSolver(k, accel, settings.fStopSpeed, baseSpeed, p, q);
+	solver.Solve(deltaTime);
+
+	*velocity = moveVector * solver.GetP();
+
+	if (q > 0.f)
+		*velocity += perpendicular * (solver.GetQ() / q);
+}
+
+#define INSTANTIATE_EXACT(Profile) \
+	template void ApplyFrictionExact<Profile>(const ini::Settings&, const MoveParams&, vec3*, float); \
+	template void ApplyGroundMoveExact<Profile>( \
+		const ini::Settings&, const MoveParams&, vec3*, const vec3&, float, float);
+
+#define INSTANTIATE_EXACT_CONSTANT(name) INSTANTIATE_EXACT(ConstantProfile<profiles::name>)
+
+INSTANTIATE_EXACT(RuntimeProfile)
+MOVEMENT_PROFILES(INSTANTIATE_EXACT_CONSTANT)
+
+} // namespace movement
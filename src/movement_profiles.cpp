@@ -0,0 +1,33 @@
+#include "movement_profiles.h"
+#include <iterator>
+
+namespace movement {
+
+template<typename Profile>
+static constexpr auto MakeKernels()
+{
+	return ProfileKernels {
+		.getSettings         = &Profile::Get,
+		.updateVelocity      = &UpdateVelocity<Profile>,
+		.updateVelocityFixed = &UpdateVelocityFixed<Profile>,
+		.getThrowbackImpulse = &GetThrowbackImpulse<Profile>,
+		.getLandingPenalty   = &GetLandingPenalty<Profile>
+	};
+}
+
+static constexpr ProfileKernels kProfileKernels[] = {
+	MakeKernels<RuntimeProfile>(),
+#define PROFILE_KERNELS(name) MakeKernels<ConstantProfile<profiles::name>>(),
+	MOVEMENT_PROFILES(PROFILE_KERNELS)
+#undef PROFILE_KERNELS
+};
+
+const ProfileKernels &GetProfileKernels(int index)
+{
+	if (index < 0 || index >= (int)std::size(kProfileKernels))
+		return kProfileKernels[0];
+
+	return kProfileKernels[index];
+}
+
+} // namespace movement
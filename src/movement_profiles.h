@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ini.h"
+#include "movement.h"
+
+// Built in movement feels. Each gets its own instantiation of the movement
+// functions with its tunables folded in. Only the tunables iProfile in ini.h
+// lists are read from a profile, so its other fields are left at their
+// defaults.
+#define MOVEMENT_PROFILES(X) \
+	X(Default) \
+	X(Quake) \
+	X(HeavyArmor)
+
+namespace movement::profiles {
+
+// The INI defaults
+inline constexpr auto Default = ini::Settings {};
+
+// Snappy ground movement, air control through fast acceleration towards a
+// small air speed cap
+inline constexpr auto Quake = ini::Settings {
+	.fFriction        = 4.f,
+	.fAcceleration    = 10.f,
+	.fAirAcceleration = 10.f,
+	.fAirSpeed        = .1f
+};
+
+// Slow to start and stop, little air control, heavier landings
+inline constexpr auto HeavyArmor = ini::Settings {
+	.fFriction                    = 6.f,
+	.fAcceleration                = 3.5f,
+	.fAirAcceleration             = .5f,
+	.fKnockbackScale              = 5.f,
+	.fLandingPenaltyImpactSpeed50 = 60.f
+};
+
+} // namespace movement::profiles
+
+namespace movement {
+
+// Instantiations of the profile dependent functions for one profile
+struct ProfileKernels {
+	decltype(&RuntimeProfile::Get) getSettings;
+	decltype(&UpdateVelocity<>) updateVelocity;
+	decltype(&UpdateVelocityFixed<>) updateVelocityFixed;
+	decltype(&GetThrowbackImpulse<>) getThrowbackImpulse;
+	decltype(&GetLandingPenalty<>) getLandingPenalty;
+};
+
+// 0 for the INI values, followed by MOVEMENT_PROFILES in order. Out of range
+// indices fall back to the INI values.
+const ProfileKernels &GetProfileKernels(int index);
+
+} // namespace movement
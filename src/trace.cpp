@@ -0,0 +1,111 @@
+#include "trace.h"
+#include "trace_file.h"
+#include "util/mpsc_ring.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace {
+
+// ~1MB, several seconds of steps for a handful of controllers
+constexpr uint32_t kRingSize = 8192;
+constexpr auto kFlushInterval = std::chrono::milliseconds(5);
+
+mpsc_ring<trace::TraceRecord, kRingSize> g_ring;
+std::atomic<uint32_t> g_dropped;
+
+struct TraceOutput {
+	trace::TraceFile file;
+	trace::TraceHeader *header = nullptr;
+	trace::TraceRecord *records = nullptr;
+	size_t capacity = 0;
+};
+
+TraceOutput g_file;
+std::thread g_flushThread;
+std::atomic<bool> g_stopFlush;
+
+// Move everything published so far from the ring buffer to the file
+void Drain()
+{
+	auto count = (size_t)g_file.header->recordCount;
+
+	g_ring.consume([&](const trace::TraceRecord &record) {
+		if (count < g_file.capacity)
+			g_file.records[count++] = record;
+		else
+			g_dropped.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	});
+
+	g_file.header->recordCount = (uint32_t)count;
+	g_file.header->droppedCount = g_dropped.load(std::memory_order_relaxed);
+}
+
+void FlushLoop()
+{
+	while (!g_stopFlush.load(std::memory_order_relaxed)) {
+		std::this_thread::sleep_for(kFlushInterval);
+		Drain();
+	}
+}
+
+} // namespace
+
+namespace trace {
+
+bool Start(const char *path, size_t maxRecords)
+{
+	if (IsRecording() || maxRecords == 0)
+		return false;
+
+	const auto size = sizeof(TraceHeader) + maxRecords * sizeof(TraceRecord);
+
+	if (!g_file.file.Open(path, size))
+		return false;
+
+	g_file.header = (TraceHeader*)g_file.file.GetView();
+	*g_file.header = {
+		.magic      = kTraceMagic,
+		.version    = kTraceVersion,
+		.recordSize = sizeof(TraceRecord)
+	};
+
+	g_file.records = (TraceRecord*)(g_file.header + 1);
+	g_file.capacity = maxRecords;
+
+	g_ring.clear();
+	g_dropped = 0;
+	g_stopFlush = false;
+	g_flushThread = std::thread(FlushLoop);
+	detail::recording.store(true, std::memory_order_release);
+	return true;
+}
+
+void Stop()
+{
+	if (!IsRecording())
+		return;
+
+	detail::recording.store(false, std::memory_order_relaxed);
+	g_stopFlush = true;
+	g_flushThread.join();
+	Drain();
+
+	g_file.file.Close(sizeof(TraceHeader) + g_file.header->recordCount * sizeof(TraceRecord));
+	g_file = {};
+}
+
+void Record(const TraceRecord &record)
+{
+	const auto pushed = g_ring.push([&](TraceRecord &slot, uint32_t index) {
+		slot = record;
+		slot.sequence = index;
+	});
+
+	if (!pushed)
+		g_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace trace
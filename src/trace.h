@@ -0,0 +1,32 @@
+#pragma once
+
+#include "trace_format.h"
+#include <atomic>
+#include <cstddef>
+
+// Movement step recorder. Record copies into a preallocated ring buffer that a
+// background thread drains into a memory mapped trace file.
+namespace trace {
+
+namespace detail {
+inline std::atomic<bool> recording;
+}
+
+inline bool IsRecording()
+{
+	return detail::recording.load(std::memory_order_relaxed);
+}
+
+// Create the file at path with room for maxRecords records and start the
+// flush thread
+bool Start(const char *path, size_t maxRecords);
+
+// Flush outstanding records and truncate the file to its contents
+void Stop();
+
+// Safe from any thread, as hooks record from wherever the game steps a
+// controller. The sequence field is assigned here in ring order. Drops the
+// record if the buffer is full.
+void Record(const TraceRecord &record);
+
+} // namespace trace
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace trace {
+
+// Trace output file mapped into memory, implemented with file mappings on
+// Windows and mmap elsewhere
+class TraceFile {
+	// File and mapping handles on Windows, a descriptor elsewhere
+	uintptr_t file = 0;
+	uintptr_t mapping = 0;
+	void *view = nullptr;
+	size_t size = 0;
+
+public:
+	// Create or overwrite path with size bytes mapped writable
+	bool Open(const char *path, size_t size);
+
+	// Flush and unmap the file and trim it to length bytes
+	void Close(size_t length);
+
+	void *GetView() const { return view; }
+};
+
+} // namespace trace
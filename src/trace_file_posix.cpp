@@ -0,0 +1,47 @@
+#include "trace_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace trace {
+
+bool TraceFile::Open(const char *path, size_t size)
+{
+	const auto fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+	if (fd == -1)
+		return false;
+
+	void *mapped = MAP_FAILED;
+
+	if (ftruncate(fd, (off_t)size) == 0)
+		mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	if (mapped == MAP_FAILED) {
+		close(fd);
+		return false;
+	}
+
+	file = (uintptr_t)fd;
+	view = mapped;
+	this->size = size;
+	return true;
+}
+
+void TraceFile::Close(size_t length)
+{
+	if (view == nullptr)
+		return;
+
+	msync(view, size, MS_SYNC);
+	munmap(view, size);
+
+	// Trim the unused tail of the preallocated file. If that fails it stays
+	// at full size, with the header still counting the records.
+	[[maybe_unused]] const auto trimmed = ftruncate((int)file, (off_t)length);
+
+	close((int)file);
+	*this = {};
+}
+
+} // namespace trace
@@ -0,0 +1,57 @@
+#include "trace_file.h"
+#include <Windows.h>
+
+namespace trace {
+
+bool TraceFile::Open(const char *path, size_t size)
+{
+	const auto handle = CreateFileA(
+		path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+
+	const auto mappingHandle = CreateFileMappingA(
+		handle, nullptr, PAGE_READWRITE,
+		(DWORD)((uint64_t)size >> 32), (DWORD)size, nullptr);
+
+	void *mapped = nullptr;
+
+	if (mappingHandle != nullptr)
+		mapped = MapViewOfFile(mappingHandle, FILE_MAP_WRITE, 0, 0, size);
+
+	if (mapped == nullptr) {
+		if (mappingHandle != nullptr)
+			CloseHandle(mappingHandle);
+
+		CloseHandle(handle);
+		return false;
+	}
+
+	file = (uintptr_t)handle;
+	mapping = (uintptr_t)mappingHandle;
+	view = mapped;
+	this->size = size;
+	return true;
+}
+
+void TraceFile::Close(size_t length)
+{
+	if (view == nullptr)
+		return;
+
+	FlushViewOfFile(view, 0);
+	UnmapViewOfFile(view);
+	CloseHandle((HANDLE)mapping);
+
+	// Trim the unused tail of the preallocated file
+	auto end = LARGE_INTEGER { .QuadPart = (LONGLONG)length };
+	SetFilePointerEx((HANDLE)file, end, nullptr, FILE_BEGIN);
+	SetEndOfFile((HANDLE)file);
+	CloseHandle((HANDLE)file);
+
+	*this = {};
+}
+
+} // namespace trace
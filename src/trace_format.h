@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// On disk format of movement traces, shared with tools/trace_dump. The file is
+// a TraceHeader followed by recordCount fixed size TraceRecords, little endian
+// and laid out without padding.
+namespace trace {
+
+// "PPTR"
+constexpr uint32_t kTraceMagic = 0x52545050;
+constexpr uint32_t kTraceVersion = 1;
+
+enum TraceKind : uint8_t {
+	kTraceKind_MoveCharacter,
+	kTraceKind_Jumping,
+	kTraceKind_OnGround,
+	kTraceKind_InAir
+};
+
+enum TraceFlags : uint8_t {
+	// The custom movement model handled this step
+	kTraceFlag_UsedPhysics = 1 << 0,
+	// params holds the step's CharacterMoveParams
+	kTraceFlag_HasParams   = 1 << 1
+};
+
+struct TraceVec3 {
+	float x, y, z;
+};
+
+// CharacterMoveParams without the alignment padding
+struct TraceMoveParams {
+	float multiplier;
+	TraceVec3 forward;
+	TraceVec3 up;
+	TraceVec3 groundNormal;
+	TraceVec3 velocity;
+	TraceVec3 input;
+	float maxSpeed;
+	TraceVec3 surfaceVelocity;
+};
+
+struct TraceRecord {
+	uint32_t sequence;
+	// Truncated bhkCharacterController address
+	uint32_t controller;
+	TraceKind kind;
+	uint8_t flags;
+	uint8_t hkState;
+	uint8_t wantState;
+	uint32_t moveFlags;
+	float deltaTime;
+	TraceVec3 velocityIn;
+	TraceVec3 velocityOut;
+	TraceMoveParams params;
+	uint32_t reserved;
+};
+
+struct TraceHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t recordSize;
+	// Written after the records it counts
+	uint32_t recordCount;
+	// Records lost to a full ring buffer or file
+	uint32_t droppedCount;
+	uint32_t reserved[3];
+};
+
+static_assert(sizeof(TraceRecord) == 128);
+static_assert(sizeof(TraceHeader) == 32);
+
+} // namespace trace
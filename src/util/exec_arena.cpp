@@ -0,0 +1,185 @@
+#include "util/exec_arena.h"
+#include "util/platform.h"
+#include "util/virtual_memory.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Allocation granularity, the smallest reservation VirtualAlloc makes on Windows
+constexpr size_t BLOCK_SIZE = 0x10000;
+// Keep whole stubs comfortably inside rel32 range
+constexpr int64_t REL32_REACH = INT32_MAX - (int64_t)BLOCK_SIZE;
+
+struct block {
+	std::byte *base;
+	size_t used;
+	size_t committed;
+	stub_heat heat;
+};
+
+struct free_chunk {
+	std::byte *ptr;
+	size_t size;
+	stub_heat heat;
+};
+
+std::mutex arena_mutex;
+std::vector<block> blocks;
+std::vector<free_chunk> free_chunks;
+size_t used_bytes;
+
+bool in_reach(const void *ptr, size_t size, const void *near)
+{
+	if (near == nullptr)
+		return true;
+
+	const auto start = (int64_t)(uintptr_t)ptr - (int64_t)(uintptr_t)near;
+	return start >= -REL32_REACH && start + (int64_t)size <= REL32_REACH;
+}
+
+std::byte *try_reserve(uintptr_t address)
+{
+	return (std::byte*)vm_reserve((void*)address, BLOCK_SIZE);
+}
+
+// Reserve a block as close to near as possible, searching outwards
+std::byte *reserve_block(const void *near)
+{
+	if (near == nullptr)
+		return (std::byte*)vm_reserve(nullptr, BLOCK_SIZE);
+
+	const auto [min_address, max_address] = vm_address_range();
+	const auto origin = (uintptr_t)near & ~(BLOCK_SIZE - 1);
+
+	for (uintptr_t offset = 0; offset < (uintptr_t)REL32_REACH; offset += BLOCK_SIZE) {
+		if (origin + offset >= origin && origin + offset + BLOCK_SIZE <= max_address) {
+			if (auto *base = try_reserve(origin + offset); base != nullptr)
+				return base;
+		}
+
+		if (offset != 0 && origin - offset <= origin && origin - offset >= min_address) {
+			if (auto *base = try_reserve(origin - offset); base != nullptr)
+				return base;
+		}
+	}
+
+	return nullptr;
+}
+
+void *allocate_from(block *from, size_t size)
+{
+	const auto end = from->used + size;
+
+	if (end > from->committed) {
+		const auto commit_end = (end + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+		const auto committed = vm_commit(
+			from->base + from->committed, commit_end - from->committed,
+			page_access::read_write_execute);
+
+		if (!committed)
+			return nullptr;
+
+		from->committed = commit_end;
+	}
+
+	auto *result = from->base + from->used;
+	from->used = end;
+	return result;
+}
+
+} // namespace
+
+void *exec_alloc(size_t size, const void *near, stub_heat heat)
+{
+	size = (size + STUB_ALIGN - 1) & ~(STUB_ALIGN - 1);
+
+	if (size == 0 || size > BLOCK_SIZE)
+		return nullptr;
+
+	const auto lock = std::scoped_lock(arena_mutex);
+
+	// Reuse freed stubs first
+	for (auto it = free_chunks.begin(); it != free_chunks.end(); ++it) {
+		if (it->heat != heat || it->size < size || !in_reach(it->ptr, size, near))
+			continue;
+
+		auto *result = it->ptr;
+
+		if (it->size == size) {
+			free_chunks.erase(it);
+		} else {
+			it->ptr += size;
+			it->size -= size;
+		}
+
+		used_bytes += size;
+		return result;
+	}
+
+	for (auto &existing : blocks) {
+		if (existing.heat != heat || existing.used + size > BLOCK_SIZE)
+			continue;
+
+		if (!in_reach(existing.base + existing.used, size, near))
+			continue;
+
+		if (auto *result = allocate_from(&existing, size); result != nullptr) {
+			used_bytes += size;
+			return result;
+		}
+	}
+
+	auto *base = reserve_block(near);
+
+	if (base == nullptr)
+		return nullptr;
+
+	auto &added = blocks.emplace_back(block { .base = base, .heat = heat });
+	auto *result = allocate_from(&added, size);
+
+	if (result != nullptr)
+		used_bytes += size;
+
+	return result;
+}
+
+void exec_free(void *ptr, size_t size)
+{
+	if (ptr == nullptr)
+		return;
+
+	size = (size + STUB_ALIGN - 1) & ~(STUB_ALIGN - 1);
+
+	const auto lock = std::scoped_lock(arena_mutex);
+
+	const auto owner = std::ranges::find_if(blocks, [&](const block &b) {
+		return ptr >= b.base && ptr < b.base + BLOCK_SIZE;
+	});
+
+	if (owner == blocks.end())
+		return;
+
+	// Leave a trap behind for anything still jumping into the stub
+	memset(ptr, 0xCC, size);
+
+	free_chunks.push_back({(std::byte*)ptr, size, owner->heat});
+	used_bytes -= size;
+}
+
+exec_stats get_exec_stats()
+{
+	const auto lock = std::scoped_lock(arena_mutex);
+
+	auto stats = exec_stats { .used = used_bytes };
+
+	for (const auto &b : blocks) {
+		stats.reserved += BLOCK_SIZE;
+		stats.committed += b.committed;
+	}
+
+	return stats;
+}
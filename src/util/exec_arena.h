@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+// Executable memory for hook stubs. Stubs are packed into shared blocks
+// reserved within rel32 reach of the address they're allocated near, with
+// hot and cold stubs kept apart so hot ones share cache lines.
+enum class stub_heat {
+	// Run on every call of a hooked function
+	hot,
+	// Rarely run
+	cold
+};
+
+constexpr size_t STUB_ALIGN = 16;
+
+// nullptr if no block in reach could be reserved or size exceeds a block
+void *exec_alloc(size_t size, const void *near = nullptr, stub_heat heat = stub_heat::hot);
+
+void exec_free(void *ptr, size_t size);
+
+struct exec_stats {
+	size_t reserved;
+	size_t committed;
+	// Allocated to live stubs, including alignment
+	size_t used;
+};
+
+exec_stats get_exec_stats();
+
+struct exec_deleter {
+	size_t size;
+
+	void operator()(std::byte *ptr) const
+	{
+		exec_free(ptr, size);
+	}
+};
+
+using exec_ptr = std::unique_ptr<std::byte[], exec_deleter>;
+
+inline exec_ptr make_exec(size_t size, const void *near = nullptr, stub_heat heat = stub_heat::hot)
+{
+	return exec_ptr((std::byte*)exec_alloc(size, near, heat), exec_deleter { size });
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#include <xmmintrin.h>
+#define FAST_MATH_SSE
+#endif
+
+// Approximations for hot paths that can give up the last few bits
+namespace fast_math {
+
+// Hardware reciprocal square root estimate refined with one Newton-Raphson
+// step, within ~5e-7 relative error. x must be normal, as the estimate is
+// infinite for denormals and the refinement turns that and x = inf into NaN.
+inline float rsqrt(float x)
+{
+#ifdef FAST_MATH_SSE
+	const auto estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+	return estimate * (1.5f - .5f * x * estimate * estimate);
+#else
+	return 1.f / std::sqrt(x);
+#endif
+}
+
+// 2^x from a degree 5 minimax polynomial on the fractional part, within
+// ~1e-7 relative error. Results that would be denormal flush to zero.
+inline float exp2(float x)
+{
+	constexpr float c[] = {
+		.99999992507f, .69315307314f, .24015361739f,
+		.05582631703f, .00898934131f, .00187757620f
+	};
+
+	if (x < -126.f)
+		return 0.f;
+	if (x > 127.f)
+		return INFINITY;
+
+	const auto whole = std::floor(x);
+	const auto f = x - whole;
+	const auto poly = c[0] + f * (c[1] + f * (c[2] + f * (c[3] + f * (c[4] + f * c[5]))));
+	const auto scale = std::bit_cast<float>((uint32_t)((int32_t)whole + 127) << 23);
+	return poly * scale;
+}
+
+// Squared lengths rsqrt handles, others take the exact path
+inline bool in_rsqrt_range(float len_sqr)
+{
+	return len_sqr >= FLT_MIN && len_sqr <= FLT_MAX;
+}
+
+inline float length(const auto &vector)
+{
+	const auto len_sqr = vector.length_sqr();
+	return in_rsqrt_range(len_sqr) ? len_sqr * rsqrt(len_sqr) : vector.length();
+}
+
+inline auto normalized(const auto &vector)
+{
+	const auto len_sqr = vector.length_sqr();
+	return in_rsqrt_range(len_sqr) ? vector * rsqrt(len_sqr) : vector.normalized();
+}
+
+} // namespace fast_math
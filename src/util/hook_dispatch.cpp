@@ -0,0 +1,310 @@
+#include "util/hook_dispatch.h"
+#include "util/memory.h"
+#include "util/thread_freeze.h"
+#include "util/virtual_memory.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <TlHelp32.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace {
+
+constexpr auto EXPORT_NAME = "HookDispatch_GetRegistry";
+
+struct handler {
+	uintptr_t handle;
+	const void *entry;
+	const void **original;
+	int32_t priority;
+};
+
+struct site {
+	hook_site kind;
+	uintptr_t address;
+	// What the site called before the first handler joined
+	const void *original;
+	// What the site calls now, unless something else patched over it
+	const void *head;
+	std::vector<handler> chain;
+};
+
+struct registry_state {
+	std::mutex mutex;
+	std::vector<site> sites;
+	// Every slot ever linked. Removed handlers keep their last value for
+	// calls still running, but the slot is free to reuse.
+	std::vector<const void**> slots;
+	uintptr_t next_handle = 1;
+};
+
+// Set between begin_batch and end_batch
+thread_local bool batch_writes;
+
+registry_state &get_state()
+{
+	static registry_state instance;
+	return instance;
+}
+
+const void *read_site(hook_site kind, uintptr_t address)
+{
+	if (kind == hook_site::call_rel32)
+		return read_rel32(address);
+
+	return *(const void**)address;
+}
+
+// One store where possible, as the site may be running. Only the operand
+// changes, so no thread can be partway into it.
+void write_site(hook_site kind, uintptr_t address, const void *target)
+{
+	const auto is_call = kind == hook_site::call_rel32;
+	auto *dest = (void*)(is_call ? address + 1 : address);
+	const auto rel32 = make_rel32(address, target);
+	const auto *value = is_call ? (const void*)&rel32 : (const void*)&target;
+	const auto size = is_call ? sizeof(rel32) : sizeof(target);
+
+	const auto store = [&] {
+		if (!write_atomic(dest, value, size)) {
+			const auto freeze = thread_freeze();
+			memcpy(dest, value, size);
+		}
+	};
+
+	if (batch_writes) {
+		store();
+		return;
+	}
+
+	page_access old_access;
+	vm_protect(dest, size, is_call ? page_access::read_write_execute : page_access::read_write, &old_access);
+	store();
+	vm_protect(dest, size, old_access);
+
+	if (is_call)
+		vm_flush_icache((void*)address, 5);
+}
+
+site *find_site(registry_state &state, hook_site kind, uintptr_t address)
+{
+	for (auto &s : state.sites) {
+		if (s.kind == kind && s.address == address)
+			return &s;
+	}
+
+	return nullptr;
+}
+
+const void *next_in_chain(const site &s, const std::vector<handler> &chain, size_t index)
+{
+	return index + 1 < chain.size() ? chain[index + 1].entry : s.original;
+}
+
+// A slot serves one site, whatever its neighbours are hooked with
+bool can_bind(registry_state &state, const site &s, const void **slot, const void *next)
+{
+	for (const auto &other : state.sites) {
+		if (&other == &s)
+			continue;
+
+		for (const auto &h : other.chain) {
+			if (h.original == slot)
+				return false;
+		}
+	}
+
+	if (std::ranges::find(state.slots, slot) != state.slots.end())
+		return true;
+
+	// Bound outside the registry
+	return *slot == nullptr || *slot == next;
+}
+
+// Point each handler at the next, last to first so nothing is reachable
+// before it's linked, then point the site at the first
+bool link(registry_state &state, site &s, std::vector<handler> chain)
+{
+	for (size_t i = 0; i < chain.size(); i++) {
+		if (!can_bind(state, s, chain[i].original, next_in_chain(s, chain, i)))
+			return false;
+	}
+
+	const auto *head = chain.empty() ? s.original : chain[0].entry;
+
+	if (head != s.head) {
+		// Don't unhook whoever patched over us
+		if (read_site(s.kind, s.address) != s.head)
+			return false;
+
+		if (s.kind == hook_site::call_rel32 && !in_rel32_reach(s.address, head))
+			return false;
+	}
+
+	for (size_t i = chain.size(); i-- > 0;) {
+		*chain[i].original = next_in_chain(s, chain, i);
+
+		if (std::ranges::find(state.slots, chain[i].original) == state.slots.end())
+			state.slots.push_back(chain[i].original);
+	}
+
+	if (head != s.head) {
+		write_site(s.kind, s.address, head);
+		s.head = head;
+	}
+
+	s.chain = std::move(chain);
+	return true;
+}
+
+uintptr_t add_handler(hook_site kind, uintptr_t address, const void *entry, const void **original, int32_t priority)
+{
+	if (entry == nullptr || original == nullptr)
+		return 0;
+
+	if (kind == hook_site::call_rel32 && *(uint8_t*)address != 0xE8)
+		return 0;
+
+	auto &state = get_state();
+	const auto lock = std::scoped_lock(state.mutex);
+	auto *s = find_site(state, kind, address);
+	const auto created = s == nullptr;
+
+	if (created) {
+		const auto *current = read_site(kind, address);
+		s = &state.sites.emplace_back(site {kind, address, current, current});
+	}
+
+	const auto handle = state.next_handle;
+	auto chain = s->chain;
+	const auto position = std::ranges::upper_bound(chain, priority, {}, &handler::priority);
+	chain.insert(position, {handle, entry, original, priority});
+
+	if (!link(state, *s, std::move(chain))) {
+		if (created)
+			state.sites.pop_back();
+
+		return 0;
+	}
+
+	state.next_handle++;
+	return handle;
+}
+
+bool remove_handler(uintptr_t handle)
+{
+	auto &state = get_state();
+	const auto lock = std::scoped_lock(state.mutex);
+
+	for (auto it = state.sites.begin(); it != state.sites.end(); ++it) {
+		auto chain = it->chain;
+		const auto count = std::erase_if(chain, [&](const handler &h) { return h.handle == handle; });
+
+		if (count == 0)
+			continue;
+
+		if (!link(state, *it, std::move(chain)))
+			return false;
+
+		// The site is back to its original
+		if (it->chain.empty())
+			state.sites.erase(it);
+
+		return true;
+	}
+
+	return false;
+}
+
+size_t count_handlers(hook_site kind, uintptr_t address)
+{
+	auto &state = get_state();
+	const auto lock = std::scoped_lock(state.mutex);
+	const auto *s = find_site(state, kind, address);
+	return s != nullptr ? s->chain.size() : 0;
+}
+
+void begin_batch()
+{
+	batch_writes = true;
+}
+
+void end_batch()
+{
+	batch_writes = false;
+}
+
+using get_registry_function = hook_dispatch_registry *(*)();
+
+hook_dispatch_registry *check_registry(get_registry_function get_registry)
+{
+	auto *registry = get_registry != nullptr ? get_registry() : nullptr;
+
+	if (registry == nullptr || registry->version != HOOK_DISPATCH_VERSION || registry->size < HOOK_DISPATCH_MIN_SIZE)
+		return nullptr;
+
+	return registry;
+}
+
+// Another module's registry, if one was created first
+hook_dispatch_registry *find_shared_registry()
+{
+#ifdef _WIN32
+	HMODULE self;
+	GetModuleHandleExA(
+		GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+		(LPCSTR)&get_local_hook_dispatch_registry, &self);
+
+	const auto snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE, GetCurrentProcessId());
+
+	if (snapshot == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	auto entry = MODULEENTRY32 { .dwSize = sizeof(MODULEENTRY32) };
+	hook_dispatch_registry *result = nullptr;
+
+	for (auto more = Module32First(snapshot, &entry); more && result == nullptr; more = Module32Next(snapshot, &entry)) {
+		if (entry.hModule != self)
+			result = check_registry((get_registry_function)GetProcAddress(entry.hModule, EXPORT_NAME));
+	}
+
+	CloseHandle(snapshot);
+	return result;
+#else
+	// The first definition in load order, which may be this module's
+	return check_registry((get_registry_function)dlsym(RTLD_DEFAULT, EXPORT_NAME));
+#endif
+}
+
+} // namespace
+
+hook_dispatch_registry *get_local_hook_dispatch_registry()
+{
+	static auto registry = hook_dispatch_registry {
+		.version       = HOOK_DISPATCH_VERSION,
+		.size          = sizeof(hook_dispatch_registry),
+		.add           = add_handler,
+		.remove        = remove_handler,
+		.handler_count = count_handlers,
+		.begin_batch   = begin_batch,
+		.end_batch     = end_batch
+	};
+
+	return &registry;
+}
+
+hook_dispatch_registry *get_hook_dispatch_registry()
+{
+	static auto *registry = [] {
+		auto *shared = find_shared_registry();
+		return shared != nullptr ? shared : get_local_hook_dispatch_registry();
+	}();
+
+	return registry;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Lets hooks from any number of modules share a call site or vtable entry.
+// Each site keeps a chain of handlers ordered by priority. There's no
+// dispatching trampoline: the site calls the first handler and each handler's
+// original slot holds the next, ending at whatever the site called when the
+// first handler joined. n handlers cost n nested direct calls with no TLS
+// stores, and a handler that doesn't call through its slot ends the chain.
+//
+// Modules share one registry, found through the HookDispatch_GetRegistry
+// export of whichever module created it first.
+
+constexpr uint32_t HOOK_DISPATCH_VERSION = 1;
+
+enum class hook_site : uint32_t {
+	// Target of the call rel32 at address
+	call_rel32,
+	// Function pointer at address, such as a vtable entry
+	vtable
+};
+
+// Plain C layout, as it's shared between modules
+struct hook_dispatch_registry {
+	uint32_t version;
+	uint32_t size;
+	// Insert handler ahead of any with a higher priority. The handler calls
+	// through *original, which changes as handlers join and leave. Each site
+	// needs its own slot, as the next handler differs between sites once
+	// anything else hooks one of them. Returns 0 on failure.
+	uintptr_t (*add)(hook_site site, uintptr_t address, const void *handler,
+	                 const void **original, int32_t priority);
+	// False if the handler was first and a hook outside the registry has
+	// since patched over the site
+	bool (*remove)(uintptr_t handle);
+	size_t (*handler_count)(hook_site site, uintptr_t address);
+	// Optional, present when size covers them. Between the two, sites written
+	// on this thread are left for the caller to make writable beforehand and
+	// flush from the instruction cache afterwards, so a batch of them changes
+	// each page once.
+	void (*begin_batch)();
+	void (*end_batch)();
+};
+
+// Registries from modules built before the batch functions were added
+constexpr uint32_t HOOK_DISPATCH_MIN_SIZE = offsetof(hook_dispatch_registry, begin_batch);
+
+inline bool hook_dispatch_has_batch(const hook_dispatch_registry *registry)
+{
+	return registry->size >= sizeof(hook_dispatch_registry);
+}
+
+// The registry shared by every module in the process
+hook_dispatch_registry *get_hook_dispatch_registry();
+
+// This module's registry, exported as HookDispatch_GetRegistry
+hook_dispatch_registry *get_local_hook_dispatch_registry();
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// Counts threads running hooks. After the patches leading to the hooks are
+// reverted, drain waits for the hooks already entered to return, so their
+// state can be handed off or torn down.
+//
+// A thread can be past a reverted patch but not yet in its hook, so drain
+// closes the gate first. A hook entering a closed gate must act as if it
+// weren't hooked, without touching the state being handed off. Either the
+// hook sees the gate closed or drain sees the hook, never neither.
+class hook_gate {
+	std::atomic<uint32_t> active = 0;
+	std::atomic<bool> closed = false;
+
+public:
+	class scope {
+		hook_gate &gate;
+		bool open;
+
+	public:
+		explicit scope(hook_gate &gate) : gate(gate)
+		{
+			// Ordered against drain's store to closed and load of active
+			gate.active.fetch_add(1, std::memory_order_seq_cst);
+			open = !gate.closed.load(std::memory_order_seq_cst);
+		}
+
+		~scope()
+		{
+			gate.active.fetch_sub(1, std::memory_order_release);
+		}
+
+		scope(const scope&) = delete;
+		scope &operator=(const scope&) = delete;
+
+		// False if the gate was closed, so the hook should pass through
+		explicit operator bool() const { return open; }
+	};
+
+	scope enter() { return scope(*this); }
+
+	// Close the gate, then wait for hooks already entered to return. False if
+	// hooks were still running at the timeout. The gate stays closed either
+	// way until reopened.
+	bool drain(std::chrono::milliseconds timeout)
+	{
+		closed.store(true, std::memory_order_seq_cst);
+
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+		while (active.load(std::memory_order_seq_cst) != 0) {
+			if (std::chrono::steady_clock::now() >= deadline)
+				return false;
+
+			std::this_thread::yield();
+		}
+
+		return true;
+	}
+
+	// Let hooks run again, such as when patches are recommitted after a
+	// failed drain or reload
+	void reopen()
+	{
+		closed.store(false, std::memory_order_release);
+	}
+};
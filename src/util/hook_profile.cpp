@@ -0,0 +1,162 @@
+#include "util/hook_profile.h"
+
+#ifdef HOOK_PROFILING
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+// Written only by the owning thread, so updates are plain loads and stores
+struct thread_counters {
+	std::atomic<uint64_t> calls[HOOK_PROFILE_MAX_HOOKS];
+	std::atomic<uint64_t> cycles[HOOK_PROFILE_MAX_HOOKS];
+	std::atomic<uint64_t> buckets[HOOK_PROFILE_MAX_HOOKS][HOOK_PROFILE_BUCKETS];
+};
+
+struct registry {
+	std::mutex mutex;
+	std::vector<std::string_view> names;
+	// Kept after their threads exit so totals don't go backwards
+	std::vector<std::unique_ptr<thread_counters>> threads;
+	// Totals at the last reset
+	std::vector<hook_profile> baseline;
+};
+
+registry &get_registry()
+{
+	static registry instance;
+	return instance;
+}
+
+thread_counters *create_thread_counters()
+{
+	auto &reg = get_registry();
+	const auto lock = std::scoped_lock(reg.mutex);
+	return reg.threads.emplace_back(std::make_unique<thread_counters>()).get();
+}
+
+void increment(std::atomic<uint64_t> &counter, uint64_t amount)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+std::vector<hook_profile> sum_threads(registry &reg)
+{
+	std::vector<hook_profile> result(reg.names.size());
+
+	for (size_t id = 0; id < reg.names.size(); id++) {
+		auto &profile = result[id];
+		profile.name = reg.names[id];
+
+		for (const auto &counters : reg.threads) {
+			profile.calls += counters->calls[id].load(std::memory_order_relaxed);
+			profile.cycles += counters->cycles[id].load(std::memory_order_relaxed);
+
+			for (size_t bucket = 0; bucket < HOOK_PROFILE_BUCKETS; bucket++)
+				profile.buckets[bucket] += counters->buckets[id][bucket].load(std::memory_order_relaxed);
+		}
+	}
+
+	return result;
+}
+
+} // namespace
+
+namespace detail::hook_profile {
+
+size_t register_hook(std::string_view name)
+{
+	auto &reg = get_registry();
+	const auto lock = std::scoped_lock(reg.mutex);
+
+	// Hooks past the limit share the last slot
+	if (reg.names.size() == HOOK_PROFILE_MAX_HOOKS)
+		return HOOK_PROFILE_MAX_HOOKS - 1;
+
+	reg.names.push_back(name);
+	return reg.names.size() - 1;
+}
+
+void record(size_t id, uint64_t cycles)
+{
+	static thread_local auto *counters = create_thread_counters();
+
+	const auto bucket = std::min((size_t)std::bit_width(cycles), HOOK_PROFILE_BUCKETS) - (cycles != 0);
+	increment(counters->calls[id], 1);
+	increment(counters->cycles[id], cycles);
+	increment(counters->buckets[id][bucket], 1);
+}
+
+std::string_view parse_name(std::string_view signature)
+{
+	// MSVC: class std::basic_string_view<...> __cdecl ...::hook_name<&hook_X>(void)
+	// GCC and Clang: ... [with auto Hook = hook_X; ...]
+	// The return type has its own template arguments, so MSVC's are found by
+	// the function's name.
+	constexpr auto gnu = std::string_view("Hook = ");
+	constexpr auto msvc = std::string_view("hook_name<");
+
+	auto start = signature.find(gnu);
+
+	if (start != signature.npos)
+		start += gnu.size();
+	else if (start = signature.find(msvc); start != signature.npos)
+		start += msvc.size();
+	else
+		return signature;
+
+	if (start < signature.size() && signature[start] == '&')
+		start++;
+
+	// Up to the end of the argument, past any template arguments of the hook's
+	auto end = start;
+
+	for (auto depth = 0; end < signature.size(); end++) {
+		const auto c = signature[end];
+
+		if (c == '<')
+			depth++;
+		else if (c == '>' && depth-- == 0)
+			break;
+		else if ((c == ';' || c == ']') && depth == 0)
+			break;
+	}
+
+	while (end > start && signature[end - 1] == ' ')
+		end--;
+
+	return signature.substr(start, end - start);
+}
+
+} // namespace detail::hook_profile
+
+std::vector<hook_profile> get_hook_profiles()
+{
+	auto &reg = get_registry();
+	const auto lock = std::scoped_lock(reg.mutex);
+	auto result = sum_threads(reg);
+
+	for (size_t id = 0; id < reg.baseline.size(); id++) {
+		const auto &base = reg.baseline[id];
+		result[id].calls -= base.calls;
+		result[id].cycles -= base.cycles;
+
+		for (size_t bucket = 0; bucket < HOOK_PROFILE_BUCKETS; bucket++)
+			result[id].buckets[bucket] -= base.buckets[bucket];
+	}
+
+	return result;
+}
+
+void reset_hook_profiles()
+{
+	auto &reg = get_registry();
+	const auto lock = std::scoped_lock(reg.mutex);
+	reg.baseline = sum_threads(reg);
+}
+
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "util/platform.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// rdtsc timing of hooks, compiled in with HOOK_PROFILING. instrumented<Hook>
+// is a drop in replacement for Hook that counts calls and buckets their
+// latency, and is Hook itself when compiled out. Naked hooks can't be wrapped.
+#ifdef HOOK_PROFILING
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+constexpr size_t HOOK_PROFILE_MAX_HOOKS = 64;
+// Bucket n holds calls taking [2^n, 2^(n+1)) cycles
+constexpr size_t HOOK_PROFILE_BUCKETS = 32;
+
+struct hook_profile {
+	std::string_view name;
+	uint64_t calls;
+	uint64_t cycles;
+	uint64_t buckets[HOOK_PROFILE_BUCKETS];
+};
+
+namespace detail::hook_profile {
+
+size_t register_hook(std::string_view name);
+
+// Counters owned by the calling thread
+void record(size_t id, uint64_t cycles);
+
+// Hook name from the compiler's signature for hook_name<Hook>
+std::string_view parse_name(std::string_view signature);
+
+template<auto Hook>
+std::string_view hook_name()
+{
+#ifdef _MSC_VER
+	return parse_name(__FUNCSIG__);
+#else
+	return parse_name(__PRETTY_FUNCTION__);
+#endif
+}
+
+template<auto Hook>
+inline const auto id = register_hook(hook_name<Hook>());
+
+class scope {
+	size_t id;
+	uint64_t start;
+
+public:
+	explicit scope(size_t id) : id(id), start(__rdtsc()) {}
+	~scope() { record(id, __rdtsc() - start); }
+};
+
+template<auto Hook, typename T = decltype(Hook)>
+struct wrapper;
+
+#define HOOK_PROFILE_WRAPPER(convention)                                      \
+	template<auto Hook, typename ReturnType, typename ...ArgTypes>            \
+	struct wrapper<Hook, ReturnType(convention*)(ArgTypes...)> {              \
+		static ReturnType convention call(ArgTypes ...args)                   \
+		{                                                                     \
+			const auto timer = scope(id<Hook>);                               \
+			return Hook(args...);                                             \
+		}                                                                     \
+	}
+
+HOOK_PROFILE_WRAPPER(__cdecl);
+#if defined(_M_IX86) || defined(__i386__)
+HOOK_PROFILE_WRAPPER(__stdcall);
+HOOK_PROFILE_WRAPPER(__fastcall);
+#endif
+
+#undef HOOK_PROFILE_WRAPPER
+
+} // namespace detail::hook_profile
+
+template<auto Hook>
+constexpr auto instrumented = &detail::hook_profile::wrapper<Hook>::call;
+
+// Totals summed over every thread that has called a hook
+std::vector<hook_profile> get_hook_profiles();
+
+void reset_hook_profiles();
+
+#else
+
+template<auto Hook>
+constexpr auto instrumented = Hook;
+
+#endif
@@ -1,45 +1,152 @@
 #include "util/hooks.h"
 #include "util/memory.h"
 #include "util/platform.h"
-#include <udis86.h>
+#include "util/x86_decode.h"
 #include <cstddef>
+#include <cstring>
 #include <memory>
-#include <Windows.h>
 
-static ud_t *get_udis86()
+// Instructions that end the function, or at least its fall through path
+static bool is_terminator(const x86_instruction &insn)
 {
-	static thread_local auto ud = [] {
-		ud_t ud;
-		ud_init(&ud);
-		ud_set_mode(&ud, 32);
-		return ud;
-	}();
-	return &ud;
+	if (insn.map != 0)
+		return false;
+
+	switch (insn.opcode) {
+	case 0xC2: case 0xC3: case 0xCA: case 0xCB: // ret, retf
+	case 0xCC:                                  // int3
+	case 0xE9: case 0xEA: case 0xEB:            // jmp
+		return true;
+	case 0xFF:
+		// jmp r/m, jmp far m
+		return insn.reg() == 4 || insn.reg() == 5;
+	default:
+		return false;
+	}
 }
 
-static size_t get_original_code(
-	const void *address,
-	size_t minimum_size = 1,
-	void *buffer = nullptr,
-	size_t buffer_size = -1)
+const char *relocate_error_string(relocate_error error)
 {
-	auto *ud = get_udis86();
-	ud_set_pc(ud, (uint64_t)address);
-	ud_set_input_buffer(ud, (uint8_t*)address, -1);
+	switch (error) {
+	case relocate_error::none:                return "none";
+	case relocate_error::invalid_instruction: return "undecodable instruction in prologue";
+	case relocate_error::unsupported_branch:  return "loop, jcxz or prefixed branch in prologue";
+	case relocate_error::branch_into_patch:   return "branch into the bytes replaced by the hook jmp";
+	case relocate_error::function_too_short:  return "function ends before the hook jmp fits";
+	case relocate_error::out_of_reach:        return "relocated operand can't reach its target";
+	case relocate_error::no_memory:           return "no executable memory near the target";
+	default:                                  return "unknown";
+	}
+}
+
+relocate_result relocate_code(const void *source, size_t minimum_size, void *dest)
+{
+	const auto *start = (const std::byte*)source;
+	auto *out = (std::byte*)dest;
+	auto result = relocate_result {};
+
+	const auto fail = [&](relocate_error error) {
+		result.error = error;
+		return result;
+	};
+
+	// Branches landing between the start and the end of the hook jmp would
+	// execute a partial instruction
+	const auto into_patch = [&](const std::byte *to) {
+		return to > start && to < start + minimum_size;
+	};
+
+	while (result.source_size < minimum_size) {
+		const auto *insn = start + result.source_size;
+		const auto decoded = decode_x86((const uint8_t*)insn);
+		const auto length = (size_t)decoded.length;
+
+		if (length == 0)
+			return fail(relocate_error::invalid_instruction);
+
+		auto *at = out != nullptr ? out + result.code_size : nullptr;
+
+		result.source_size += length;
+
+		if (result.source_size < minimum_size && is_terminator(decoded))
+			return fail(relocate_error::function_too_short);
+
+		if (decoded.relative) {
+			// Prefixed branches change their operand size. Branches are only in
+			// the one byte and 0F maps, so the opcode follows its escape.
+			if (decoded.opcode_offset != decoded.map)
+				return fail(relocate_error::unsupported_branch);
+
+			const auto op = (uint8_t)insn[0];
+			auto rel = (int32_t)(int8_t)insn[decoded.imm_offset];
+
+			if (decoded.imm_size == sizeof(rel))
+				memcpy(&rel, insn + decoded.imm_offset, sizeof(rel));
+
+			const auto *to = insn + length + rel;
+
+			if (into_patch(to))
+				return fail(relocate_error::branch_into_patch);
+
+			// Widen short jmp and jcc to rel32
+			size_t opcode_size;
+			uint8_t opcode[2];
+
+			if (op == 0xEB || op == 0xE8 || op == 0xE9) {
+				opcode_size = 1;
+				opcode[0] = op == 0xEB ? 0xE9 : op;
+			} else if (op >= 0x70 && op <= 0x7F) {
+				opcode_size = 2;
+				opcode[0] = 0x0F;
+				opcode[1] = 0x80 | (op & 0xF);
+			} else if (op == 0x0F && length == 6) {
+				opcode_size = 2;
+				opcode[0] = 0x0F;
+				opcode[1] = (uint8_t)insn[1];
+			} else {
+				return fail(relocate_error::unsupported_branch);
+			}
+
+			const auto size = opcode_size + sizeof(int32_t);
 
-	size_t size = 0;
-	while (size < minimum_size)
-		size += ud_disassemble(ud);
+			if (at != nullptr) {
+				if (!in_rel32_reach(at, to, size))
+					return fail(relocate_error::out_of_reach);
 
-	if (buffer != nullptr)
-		memcpy(buffer, address, std::min(size, buffer_size));
+				const auto rel32 = make_rel32(at, to, size);
+				memcpy(at, opcode, opcode_size);
+				memcpy(at + opcode_size, &rel32, sizeof(rel32));
+			}
 
-	return size;
+			result.code_size += size;
+			continue;
+		}
+
+		if (at != nullptr)
+			memcpy(at, insn, length);
+
+		if (decoded.rip_relative) {
+			int32_t disp;
+			memcpy(&disp, insn + decoded.disp_offset, sizeof(disp));
+			const auto *to = insn + length + disp;
+
+			if (at != nullptr) {
+				if (!in_rel32_reach(at, to, length))
+					return fail(relocate_error::out_of_reach);
+
+				const auto new_disp = make_rel32(at, to, length);
+				memcpy(at + decoded.disp_offset, &new_disp, sizeof(new_disp));
+			}
+		}
+
+		result.code_size += length;
+	}
+
+	return result;
 }
 
 detail::JmpHookImpl::JmpHookImpl(std::byte *target, const void *hook) :
-	target(target),
-	original(std::make_unique<rwx_byte[]>(PAGE_SIZE))
+	target(target)
 {
 	PACKED (struct JmpInstruction {
 		uint8_t op = 0xE9;
@@ -51,16 +158,55 @@ detail::JmpHookImpl::JmpHookImpl(std::byte *target, const void *hook) :
 		}
 	});
 
-	constexpr auto JMP_SIZE = sizeof(JmpInstruction);
+	static_assert(sizeof(JmpInstruction) == JMP_SIZE);
 	constexpr auto FOOTER_SIZE = JMP_SIZE;
-	constexpr auto COPY_SIZE = PAGE_SIZE - FOOTER_SIZE;
 
-	const auto size = get_original_code(target, JMP_SIZE, original.get(), COPY_SIZE);
+	const auto measured = relocate_code(target, JMP_SIZE);
+
+	if (measured.error != relocate_error::none) {
+		error = measured.error;
+		return;
+	}
+
+	// Only run when the hook calls through to the original
+	original = make_exec(measured.code_size + FOOTER_SIZE, target, stub_heat::cold);
+
+	if (original == nullptr) {
+		error = relocate_error::no_memory;
+		return;
+	}
+
+	const auto relocated = relocate_code(target, JMP_SIZE, original.get());
+
+	if (relocated.error != relocate_error::none) {
+		original.reset();
+		error = relocated.error;
+		return;
+	}
 
 	// jmp to original after clobbered instructions
-	const auto jmpStub = JmpInstruction(original.get() + size, target + size);
-	memcpy(original.get() + size, &jmpStub, JMP_SIZE);
+	auto *footer = original.get() + relocated.code_size;
+	const auto jmpStub = JmpInstruction(footer, target + relocated.source_size);
+	memcpy(footer, &jmpStub, JMP_SIZE);
+
+#ifdef __x86_64__
+	// Relay to hooks out of rel32 reach of the target, run on every call
+	if (!in_rel32_reach(target, hook)) {
+		relay = make_exec(JMP_ABS_SIZE, target);
 
+		if (relay == nullptr) {
+			original.reset();
+			error = relocate_error::no_memory;
+			return;
+		}
+
+		write_jmp_abs(relay.get(), hook);
+		hook = relay.get();
+	}
+#endif
+
+	memcpy(saved, target, JMP_SIZE);
 	const auto jmpHook = JmpInstruction(target, hook);
 	patch_code(target, &jmpHook, JMP_SIZE);
-}
\ No newline at end of file
+	installed = true;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "util/exec_arena.h"
+#include "util/hook_profile.h"
 #include "util/memory.h"
 #include "util/meta.h"
 #include <concepts>
@@ -81,21 +83,58 @@ public:
 	StaticCodePatch() : CodePatch<Patch.size>(Target, Patch.value) {}
 };
 
+enum class relocate_error {
+	none,
+	invalid_instruction,
+	// loop, jcxz and prefixed branches can't be widened to rel32
+	unsupported_branch,
+	branch_into_patch,
+	// ret, jmp or int3 before enough bytes for the hook jmp
+	function_too_short,
+	out_of_reach,
+	no_memory
+};
+
+const char *relocate_error_string(relocate_error error);
+
+struct relocate_result {
+	// Whole instructions consumed from the source
+	size_t source_size;
+	// Bytes written to, or needed at, the destination
+	size_t code_size;
+	relocate_error error;
+};
+
+// Copy whole instructions covering at least minimum_size bytes of source to
+// dest, widening short branches and rewriting relative branches and RIP
+// relative operands for their new address. Only measures if dest is nullptr.
+relocate_result relocate_code(const void *source, size_t minimum_size, void *dest = nullptr);
+
 namespace detail {
 
 class JmpHookImpl {
-	size_t size = 0;
+	static constexpr size_t JMP_SIZE = 5;
+
 	std::byte *target;
+	std::byte saved[JMP_SIZE];
+	bool installed = false;
+	relocate_error error = relocate_error::none;
+	exec_ptr relay;
 protected:
-	std::unique_ptr<rwx_byte[]> original;
+	exec_ptr original;
 
 public:
+	// Leaves the target untouched if its prologue can't be relocated
 	JmpHookImpl(std::byte *target, const void *hook);
 
 	~JmpHookImpl()
 	{
-		patch_code(target, original.get(), size);
+		if (installed)
+			patch_code(target, saved, JMP_SIZE);
 	}
+
+	bool is_installed() const { return installed; }
+	relocate_error get_error() const { return error; }
 };
 
 } // namespace detail
@@ -127,6 +166,8 @@ template<typename ReturnType, typename ...ArgTypes>
 JmpHook(auto, ReturnType(__cdecl *hook)(ArgTypes..., ...))
 	-> JmpHook<decltype(hook), decltype(hook), ArgTypes...>;
 
+// Other calling conventions are all __cdecl outside of 32 bit x86
+#if defined(_M_IX86) || defined(__i386__)
 template<typename ReturnType, typename ...ArgTypes>
 JmpHook(auto, ReturnType(__stdcall *hook)(ArgTypes...))
 	-> JmpHook<decltype(hook), decltype(hook), ArgTypes...>;
@@ -145,12 +186,14 @@ JmpHook(auto, ReturnType(__fastcall *hook)(ThisType*))
 	-> JmpHook<decltype(hook),
 	           ReturnType(__thiscall*)(ThisType*),
 	           ThisType*>;
+#endif
 
-// Used to avoid explicit template args in class declarations
+// Used to avoid explicit template args in class declarations. Hook is
+// profiled under HOOK_PROFILING.
 template<auto Target, auto Hook>
 	requires requires { JmpHook(Target, Hook); }
 class StaticJmpHook : public decltype(JmpHook(Target, Hook)) {
 	using super = decltype(JmpHook(Target, Hook));
 public:
-	StaticJmpHook() : super(Target, Hook) {}
+	StaticJmpHook() : super(Target, instrumented<Hook>) {}
 };
@@ -1,13 +1,26 @@
 #pragma once
 
 #include "util/meta.h"
+#include "util/vector.h"
 #include "operators.h"
 #include <algorithm>
+#include <optional>
+#include <span>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
+// Specialized for element types with an SSE implementation, which matrix uses
+// outside constant evaluation
+template<typename T>
+struct matrix_simd {
+	static constexpr bool enabled = false;
+};
+
 template<typename T, size_t N, size_t M>
 class matrix {
+	using simd = matrix_simd<T>;
+
 public:
 	using array_type = float(*)[M];
 
@@ -109,9 +122,28 @@ public:
 		});
 	}
 
+	constexpr auto transposed() const
+	{
+		if constexpr (simd::enabled && N == 4 && M == 4) {
+			if (!std::is_constant_evaluated())
+				return simd::transpose(*this);
+		}
+
+		return for_range_product<M, N>([&]<typename... Pairs> {
+			return matrix<T, M, N> {
+				get(tuple_constant<1, Pairs>, tuple_constant<0, Pairs>)...
+			};
+		});
+	}
+
 	template<size_t OtherM>
 	constexpr auto operator*(const matrix<T, M, OtherM> &other) const
 	{
+		if constexpr (simd::enabled && M == 4 && OtherM == 4) {
+			if (!std::is_constant_evaluated())
+				return simd::multiply(*this, other);
+		}
+
 		return for_range_product<N, OtherM>([&]<typename... Pairs> {
 			return matrix<T, N, OtherM> { [&] {
 				constexpr auto i = tuple_constant<0, Pairs>;
@@ -138,6 +170,366 @@ using matrix3x3 = matrix<float, 3, 3>;
 using matrix3x4 = matrix<float, 3, 4>;
 using matrix4x4 = matrix<float, 4, 4>;
 
+// Affine matrices are 3x4, with an implied bottom row of 0 0 0 1
+template<typename T>
+constexpr matrix<T, 4, 4> affine_extend(const matrix<T, 3, 4> &m)
+{
+	return for_range<12>([&]<size_t ...I> {
+		return matrix<T, 4, 4> { m.elems[I]..., T{0}, T{0}, T{0}, T{1} };
+	});
+}
+
+// Product of two affine transforms, applying b first
+template<typename T>
+constexpr matrix<T, 3, 4> affine_multiply(const matrix<T, 3, 4> &a, const matrix<T, 3, 4> &b)
+{
+	return a * affine_extend(b);
+}
+
+namespace detail::matrix_inverse {
+
+// For row i of a 4x4 inverse, the columns of the source matrix and the pairs
+// of columns whose 2x2 determinants make up each of its three terms
+constexpr size_t COFACTOR_COLS[4][3] = { {1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2} };
+constexpr size_t COFACTOR_PAIRS[4][3] = { {5, 4, 3}, {5, 2, 1}, {4, 2, 0}, {3, 1, 0} };
+constexpr size_t PAIR_COLS[6][2] = { {0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3} };
+
+} // namespace detail::matrix_inverse
+
+#ifdef VECTOR_SSE
+// SSE implementations for float matrices with rows of 4, one __m128 per row.
+// Every lane sums its products in the generic path's order, so results match
+// it bit for bit, up to which NaN payload wins.
+template<>
+struct matrix_simd<float> {
+	static constexpr bool enabled = true;
+
+	static __m128 row(const auto &m, size_t i)
+	{
+		return _mm_loadu_ps(&m.elems[i * 4]);
+	}
+
+	static void store_row(auto &m, size_t i, __m128 value)
+	{
+		_mm_storeu_ps(&m.elems[i * 4], value);
+	}
+
+	template<int lane>
+	static __m128 splat(__m128 value)
+	{
+		return _mm_shuffle_ps(value, value, _MM_SHUFFLE(lane, lane, lane, lane));
+	}
+
+	// Row i of a product is the sum of b's rows scaled by a's row i, added
+	// right to left like sum_tuple
+	template<size_t N>
+	static matrix<float, N, 4> multiply(const matrix<float, N, 4> &a, const matrix4x4 &b)
+	{
+		const __m128 b_rows[] = { row(b, 0), row(b, 1), row(b, 2), row(b, 3) };
+		matrix<float, N, 4> result;
+
+		for (size_t i = 0; i < N; i++) {
+			const auto a_row = row(a, i);
+			auto sum = _mm_mul_ps(splat<3>(a_row), b_rows[3]);
+			sum = _mm_add_ps(_mm_mul_ps(splat<2>(a_row), b_rows[2]), sum);
+			sum = _mm_add_ps(_mm_mul_ps(splat<1>(a_row), b_rows[1]), sum);
+			sum = _mm_add_ps(_mm_mul_ps(splat<0>(a_row), b_rows[0]), sum);
+			store_row(result, i, sum);
+		}
+
+		return result;
+	}
+
+	static matrix4x4 transpose(const matrix4x4 &m)
+	{
+		auto r0 = row(m, 0), r1 = row(m, 1), r2 = row(m, 2), r3 = row(m, 3);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		matrix4x4 result;
+		store_row(result, 0, r0);
+		store_row(result, 1, r1);
+		store_row(result, 2, r2);
+		store_row(result, 3, r3);
+		return result;
+	}
+
+	// (c, c, s, s) for the 2x2 determinants of columns a and b in the bottom
+	// (c) and top (s) pairs of rows
+	static __m128 pair_determinants(__m128 col_a, __m128 col_b)
+	{
+		const auto a_hi = _mm_shuffle_ps(col_a, col_a, _MM_SHUFFLE(0, 0, 2, 2));
+		const auto a_lo = _mm_shuffle_ps(col_a, col_a, _MM_SHUFFLE(1, 1, 3, 3));
+		const auto b_hi = _mm_shuffle_ps(col_b, col_b, _MM_SHUFFLE(0, 0, 2, 2));
+		const auto b_lo = _mm_shuffle_ps(col_b, col_b, _MM_SHUFFLE(1, 1, 3, 3));
+		return _mm_sub_ps(_mm_mul_ps(a_hi, b_lo), _mm_mul_ps(a_lo, b_hi));
+	}
+
+	static std::optional<matrix4x4> inverse(const matrix4x4 &m)
+	{
+		auto c0 = row(m, 0), c1 = row(m, 1), c2 = row(m, 2), c3 = row(m, 3);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+		const __m128 pairs[] = {
+			pair_determinants(c0, c1), pair_determinants(c0, c2), pair_determinants(c0, c3),
+			pair_determinants(c1, c2), pair_determinants(c1, c3), pair_determinants(c2, c3)
+		};
+
+		const auto c = [&](int p) { return _mm_cvtss_f32(pairs[p]); };
+		const auto s = [&](int p) { return _mm_cvtss_f32(_mm_movehl_ps(pairs[p], pairs[p])); };
+		const auto det = s(0) * c(5) - s(1) * c(4) + s(2) * c(3) + s(3) * c(2) - s(4) * c(1) + s(5) * c(0);
+
+		if (det == 0.f)
+			return std::nullopt;
+
+		// Each column with its pairs of rows swapped, as row j of the result
+		// takes its terms from row j^1
+		const __m128 cols[] = {
+			_mm_shuffle_ps(c0, c0, _MM_SHUFFLE(2, 3, 0, 1)),
+			_mm_shuffle_ps(c1, c1, _MM_SHUFFLE(2, 3, 0, 1)),
+			_mm_shuffle_ps(c2, c2, _MM_SHUFFLE(2, 3, 0, 1)),
+			_mm_shuffle_ps(c3, c3, _MM_SHUFFLE(2, 3, 0, 1))
+		};
+
+		const auto inv_det = _mm_set1_ps(1.f / det);
+		const auto odd_lanes = _mm_setr_ps(0.f, -0.f, 0.f, -0.f);
+		const auto even_lanes = _mm_setr_ps(-0.f, 0.f, -0.f, 0.f);
+		matrix4x4 result;
+
+		for (size_t i = 0; i < 4; i++) {
+			const auto &[x, y, z] = detail::matrix_inverse::COFACTOR_COLS[i];
+			const auto &[px, py, pz] = detail::matrix_inverse::COFACTOR_PAIRS[i];
+			auto sum = _mm_sub_ps(_mm_mul_ps(cols[x], pairs[px]), _mm_mul_ps(cols[y], pairs[py]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(cols[z], pairs[pz]));
+			sum = _mm_xor_ps(sum, i % 2 == 0 ? odd_lanes : even_lanes);
+			store_row(result, i, _mm_mul_ps(sum, inv_det));
+		}
+
+		return result;
+	}
+
+	static __m128 cross(__m128 a, __m128 b)
+	{
+		const auto a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		const auto a_zxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+		const auto b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		const auto b_zxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+		return _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+	}
+
+	// The inverse's 3x3 part is the adjugate over the determinant, whose
+	// columns are cross products of the rows
+	static std::optional<matrix3x4> affine_inverse(const matrix3x4 &m)
+	{
+		const auto xyz = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+		const auto r0 = _mm_and_ps(row(m, 0), xyz);
+		const auto r1 = _mm_and_ps(row(m, 1), xyz);
+		const auto r2 = _mm_and_ps(row(m, 2), xyz);
+		const auto adj0 = cross(r1, r2);
+
+		const auto det = m.get(0, 0) * _mm_cvtss_f32(adj0) +
+		                 (m.get(0, 1) * _mm_cvtss_f32(splat<1>(adj0)) +
+		                  m.get(0, 2) * _mm_cvtss_f32(splat<2>(adj0)));
+
+		if (det == 0.f)
+			return std::nullopt;
+
+		const auto inv_det = _mm_set1_ps(1.f / det);
+		auto col0 = _mm_mul_ps(adj0, inv_det);
+		auto col1 = _mm_mul_ps(cross(r2, r0), inv_det);
+		auto col2 = _mm_mul_ps(cross(r0, r1), inv_det);
+
+		auto translation = _mm_mul_ps(col2, _mm_set1_ps(m.get(2, 3)));
+		translation = _mm_add_ps(_mm_mul_ps(col1, _mm_set1_ps(m.get(1, 3))), translation);
+		translation = _mm_add_ps(_mm_mul_ps(col0, _mm_set1_ps(m.get(0, 3))), translation);
+		translation = _mm_xor_ps(translation, _mm_set1_ps(-0.f));
+
+		_MM_TRANSPOSE4_PS(col0, col1, col2, translation);
+
+		matrix3x4 result;
+		store_row(result, 0, col0);
+		store_row(result, 1, col1);
+		store_row(result, 2, col2);
+		return result;
+	}
+
+	// Four points at once, deinterleaved into x, y and z vectors
+	template<bool IsPoint>
+	static void transform(const matrix3x4 &m, const vec3 *in, vec3 *out, size_t count)
+	{
+		static_assert(sizeof(vec3) == sizeof(float) * 3);
+
+		__m128 elems[12];
+
+		for (size_t i = 0; i < 12; i++)
+			elems[i] = _mm_set1_ps(m.elems[i]);
+
+		for (size_t i = 0; i < count; i += 4) {
+			const auto *src = (const float*)&in[i];
+			const auto a = _mm_loadu_ps(src + 0);
+			const auto b = _mm_loadu_ps(src + 4);
+			const auto c = _mm_loadu_ps(src + 8);
+
+			const auto xy_hi = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+			const auto yz_lo = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+			const auto x = _mm_shuffle_ps(a, xy_hi, _MM_SHUFFLE(2, 0, 3, 0));
+			const auto y = _mm_shuffle_ps(yz_lo, xy_hi, _MM_SHUFFLE(3, 1, 2, 0));
+			const auto z = _mm_shuffle_ps(yz_lo, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+			__m128 results[3];
+
+			for (size_t j = 0; j < 3; j++) {
+				auto sum = _mm_mul_ps(elems[j * 4 + 2], z);
+
+				if constexpr (IsPoint)
+					sum = _mm_add_ps(sum, elems[j * 4 + 3]);
+
+				sum = _mm_add_ps(_mm_mul_ps(elems[j * 4 + 1], y), sum);
+				results[j] = _mm_add_ps(_mm_mul_ps(elems[j * 4 + 0], x), sum);
+			}
+
+			const auto xy_lo = _mm_unpacklo_ps(results[0], results[1]);
+			const auto xy_hi_out = _mm_unpackhi_ps(results[0], results[1]);
+			const auto zx_lo = _mm_shuffle_ps(results[2], results[0], _MM_SHUFFLE(1, 1, 0, 0));
+			const auto yz_lo_out = _mm_shuffle_ps(results[1], results[2], _MM_SHUFFLE(1, 1, 1, 1));
+			const auto zx_hi = _mm_shuffle_ps(results[2], results[0], _MM_SHUFFLE(3, 3, 2, 2));
+			const auto yz_hi = _mm_shuffle_ps(results[1], results[2], _MM_SHUFFLE(3, 3, 3, 3));
+
+			auto *dst = (float*)&out[i];
+			_mm_storeu_ps(dst + 0, _mm_shuffle_ps(xy_lo, zx_lo, _MM_SHUFFLE(2, 0, 1, 0)));
+			_mm_storeu_ps(dst + 4, _mm_shuffle_ps(yz_lo_out, xy_hi_out, _MM_SHUFFLE(1, 0, 2, 0)));
+			_mm_storeu_ps(dst + 8, _mm_shuffle_ps(zx_hi, yz_hi, _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+	}
+};
+#endif
+
+// Inverse by cofactors of 2x2 determinants, or nothing if m is singular
+template<typename T>
+constexpr std::optional<matrix<T, 4, 4>> inverse(const matrix<T, 4, 4> &m)
+{
+	if constexpr (matrix_simd<T>::enabled) {
+		if (!std::is_constant_evaluated())
+			return matrix_simd<T>::inverse(m);
+	}
+
+	T s[6], c[6];
+
+	for (size_t p = 0; p < 6; p++) {
+		const auto [a, b] = detail::matrix_inverse::PAIR_COLS[p];
+		s[p] = m.get(0, a) * m.get(1, b) - m.get(1, a) * m.get(0, b);
+		c[p] = m.get(2, a) * m.get(3, b) - m.get(3, a) * m.get(2, b);
+	}
+
+	const auto det = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+
+	if (det == T{0})
+		return std::nullopt;
+
+	const auto inv_det = T{1} / det;
+	matrix<T, 4, 4> result;
+
+	for (size_t i = 0; i < 4; i++) {
+		const auto &[x, y, z] = detail::matrix_inverse::COFACTOR_COLS[i];
+		const auto &[px, py, pz] = detail::matrix_inverse::COFACTOR_PAIRS[i];
+
+		for (size_t j = 0; j < 4; j++) {
+			// Bottom pairs of rows for the top half of the row, and vice versa
+			const auto *pairs = j < 2 ? c : s;
+			const auto k = j ^ 1;
+			const auto sum = m.get(k, x) * pairs[px] - m.get(k, y) * pairs[py] + m.get(k, z) * pairs[pz];
+			result.get(i, j) = ((i + j) % 2 == 0 ? sum : -sum) * inv_det;
+		}
+	}
+
+	return result;
+}
+
+// Inverse of an affine transform, or nothing if its 3x3 part is singular
+template<typename T>
+constexpr std::optional<matrix<T, 3, 4>> affine_inverse(const matrix<T, 3, 4> &m)
+{
+	if constexpr (matrix_simd<T>::enabled) {
+		if (!std::is_constant_evaluated())
+			return matrix_simd<T>::affine_inverse(m);
+	}
+
+	// Column j of the adjugate is the cross product of rows j+1 and j+2
+	T adj[3][3];
+
+	for (size_t j = 0; j < 3; j++) {
+		const auto a = (j + 1) % 3;
+		const auto b = (j + 2) % 3;
+
+		for (size_t i = 0; i < 3; i++) {
+			const auto y = (i + 1) % 3;
+			const auto z = (i + 2) % 3;
+			adj[i][j] = m.get(a, y) * m.get(b, z) - m.get(a, z) * m.get(b, y);
+		}
+	}
+
+	const auto det = m.get(0, 0) * adj[0][0] + (m.get(0, 1) * adj[1][0] + m.get(0, 2) * adj[2][0]);
+
+	if (det == T{0})
+		return std::nullopt;
+
+	const auto inv_det = T{1} / det;
+	matrix<T, 3, 4> result;
+
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++)
+			result.get(i, j) = adj[i][j] * inv_det;
+	}
+
+	for (size_t i = 0; i < 3; i++) {
+		result.get(i, 3) = -(result.get(i, 0) * m.get(0, 3) +
+		                     (result.get(i, 1) * m.get(1, 3) + result.get(i, 2) * m.get(2, 3)));
+	}
+
+	return result;
+}
+
+constexpr vec3 transform_point(const matrix3x4 &m, const vec3 &point)
+{
+	const auto &[x, y, z] = point.elems();
+	return vec3(
+		m.get(0, 0) * x + (m.get(0, 1) * y + (m.get(0, 2) * z + m.get(0, 3))),
+		m.get(1, 0) * x + (m.get(1, 1) * y + (m.get(1, 2) * z + m.get(1, 3))),
+		m.get(2, 0) * x + (m.get(2, 1) * y + (m.get(2, 2) * z + m.get(2, 3))));
+}
+
+constexpr vec3 transform_direction(const matrix3x4 &m, const vec3 &direction)
+{
+	const auto &[x, y, z] = direction.elems();
+	return vec3(
+		m.get(0, 0) * x + (m.get(0, 1) * y + m.get(0, 2) * z),
+		m.get(1, 0) * x + (m.get(1, 1) * y + m.get(1, 2) * z),
+		m.get(2, 0) * x + (m.get(2, 1) * y + m.get(2, 2) * z));
+}
+
+// Transform arrays in one pass, which may be the same array. out must be at
+// least as long as in.
+inline void transform_points(const matrix3x4 &m, std::span<const vec3> in, std::span<vec3> out)
+{
+	size_t i = 0;
+#ifdef VECTOR_SSE
+	i = in.size() & ~(size_t)3;
+	matrix_simd<float>::transform<true>(m, in.data(), out.data(), i);
+#endif
+	for (; i < in.size(); i++)
+		out[i] = transform_point(m, in[i]);
+}
+
+inline void transform_directions(const matrix3x4 &m, std::span<const vec3> in, std::span<vec3> out)
+{
+	size_t i = 0;
+#ifdef VECTOR_SSE
+	i = in.size() & ~(size_t)3;
+	matrix_simd<float>::transform<false>(m, in.data(), out.data(), i);
+#endif
+	for (; i < in.size(); i++)
+		out[i] = transform_direction(m, in[i]);
+}
+
 constexpr matrix4x4 ortho_projection(
 	float t, float b,
 	float l, float r,
@@ -1,10 +1,15 @@
 #include "util/memory.h"
-#include <Windows.h>
-
-extern "C" extern int _tls_index;
+#include "util/exec_arena.h"
+#include "util/virtual_memory.h"
+#include <atomic>
+#include <cstring>
 
 namespace detail::hook {
 
+#ifdef _WIN32
+
+extern "C" extern int _tls_index;
+
 static __declspec(naked) void __stdcall set_original(void *value)
 {
 	__asm {
@@ -20,57 +25,185 @@ static __declspec(naked) void __stdcall set_original(void *value)
 	}
 }
 
-static rwx_byte *create_trampoline(const void *hook, const void *original)
+// The trampoline's own rel32s reach the plugin from anywhere in a 32 bit
+// process, so it only needs placing near whatever jumps to it
+std::byte *create_trampoline(const void *hook, const void *original, const void *near)
 {
-	auto *trampoline = new rwx_byte[15];
+	auto *trampoline = (std::byte*)exec_alloc(TRAMPOLINE_SIZE, near);
+
+	if (trampoline == nullptr)
+		return nullptr;
+
 	write_push(trampoline +  0, original);
 	write_call(trampoline +  5, detail::hook::set_original);
 	write_jmp (trampoline + 10, hook);
 	return trampoline;
 }
 
-} // namespace detail::hook
+#else
+
+static std::byte *thread_pointer()
+{
+	std::byte *result;
+#ifdef __x86_64__
+	asm("mov %%fs:0, %0" : "=r"(result));
+#else
+	asm("mov %%gs:0, %0" : "=r"(result));
+#endif
+	return result;
+}
 
-void *rwx_byte::operator new[](size_t size)
+// The TLS slot is a fixed offset from the thread pointer on every thread as
+// long as it lives in static TLS, as it does in executables and libraries
+// loaded at startup, so the trampoline stores to it directly:
+// push ax; mov ax, original; mov [seg:offset], ax; pop ax; jmp hook
+std::byte *create_trampoline(const void *hook, const void *original, const void *near)
 {
-	return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+	const auto offset = (std::byte*)&detail::hook::original - thread_pointer();
+
+	if (offset < INT32_MIN || offset > INT32_MAX)
+		return nullptr;
+
+	auto *trampoline = (std::byte*)exec_alloc(TRAMPOLINE_SIZE, near);
+
+	if (trampoline == nullptr)
+		return nullptr;
+
+	const auto disp = (int32_t)offset;
+	auto *code = trampoline;
+
+	const auto emit = [&](const void *bytes, size_t size) {
+		memcpy(code, bytes, size);
+		code += size;
+	};
+
+#ifdef __x86_64__
+	emit("\x50\x48\xB8", 3);
+	emit(&original, 8);
+	emit("\x64\x48\x89\x04\x25", 5);
+	emit(&disp, 4);
+	emit("\x58", 1);
+	write_jmp_abs(code, hook);
+#else
+	emit("\x50\xB8", 2);
+	emit(&original, 4);
+	emit("\x65\xA3", 2);
+	emit(&disp, 4);
+	emit("\x58", 1);
+	write_jmp(code, hook);
+#endif
+
+	return trampoline;
 }
 
-void rwx_byte::operator delete[](void *ptr)
+#endif
+
+bool bind_original(const void **slot, const void *original)
 {
-	if (ptr != nullptr)
-		VirtualFree(ptr, 0, MEM_RELEASE);
+	if (*slot != nullptr && *slot != original)
+		return false;
+
+	*slot = original;
+	return true;
 }
 
+} // namespace detail::hook
+
 void patch_code(void *target, const void *patch, size_t size)
 {
-	DWORD old_protect;
-	VirtualProtect(target, size, PAGE_EXECUTE_READWRITE, &old_protect);
+	page_access old_access;
+	vm_protect(target, size, page_access::read_write_execute, &old_access);
 	memcpy(target, patch, size);
-	VirtualProtect(target, size, old_protect, &old_protect);
+	vm_protect(target, size, old_access);
 }
 
-void patch_vtable(void *target, size_t index, const void *hook)
+bool write_atomic(void *target, const void *bytes, size_t size)
+{
+	const auto offset = (uintptr_t)target & 7;
+
+	if (size == 0 || offset + size > sizeof(uint64_t))
+		return false;
+
+	// Merge into the aligned word, which x86 stores whole
+	auto word = std::atomic_ref(*(uint64_t*)((uintptr_t)target - offset));
+	auto expected = word.load(std::memory_order_relaxed);
+	uint64_t desired;
+
+	do {
+		desired = expected;
+		memcpy((std::byte*)&desired + offset, bytes, size);
+	} while (!word.compare_exchange_weak(expected, desired));
+
+	return true;
+}
+
+bool patch_vtable(void *target, size_t index, const void *hook)
 {
 	auto **vtable = (const void**)target;
-	DWORD old_protect;
-	VirtualProtect(&vtable[index], sizeof(void*), PAGE_READWRITE, &old_protect);
-	vtable[index] = detail::hook::create_trampoline(hook, vtable[index]);
-	VirtualProtect(&vtable[index], sizeof(void*), old_protect, &old_protect);
+	const auto *trampoline = detail::hook::create_trampoline(hook, vtable[index], nullptr);
+
+	if (trampoline == nullptr)
+		return false;
+
+	page_access old_access;
+	vm_protect(&vtable[index], sizeof(void*), page_access::read_write, &old_access);
+	vtable[index] = trampoline;
+	vm_protect(&vtable[index], sizeof(void*), old_access);
+	return true;
 }
 
-void patch_call_rel32(const uintptr_t address, const void *hook)
+bool patch_call_rel32(const uintptr_t address, const void *hook)
 {
-	DWORD old_protect;
-	VirtualProtect((void*)address, 5, PAGE_EXECUTE_READWRITE, &old_protect);
-	write_call((void*)address, detail::hook::create_trampoline(hook, read_rel32(address)));
-	VirtualProtect((void*)address, 5, old_protect, &old_protect);
+	auto *trampoline = detail::hook::create_trampoline(hook, read_rel32(address), (void*)address);
+
+	if (trampoline == nullptr)
+		return false;
+
+	if (!in_rel32_reach(address, trampoline)) {
+		exec_free(trampoline, detail::hook::TRAMPOLINE_SIZE);
+		return false;
+	}
+
+	page_access old_access;
+	vm_protect((void*)address, 5, page_access::read_write_execute, &old_access);
+	write_call((void*)address, trampoline);
+	vm_protect((void*)address, 5, old_access);
+	return true;
+}
+
+bool patch_call_rel32(const uintptr_t address, const void *hook, const void **original)
+{
+	if (!in_rel32_reach(address, hook))
+		return false;
+
+	if (!detail::hook::bind_original(original, read_rel32(address)))
+		return false;
+
+	page_access old_access;
+	vm_protect((void*)address, 5, page_access::read_write_execute, &old_access);
+	write_call((void*)address, hook);
+	vm_protect((void*)address, 5, old_access);
+	return true;
+}
+
+bool patch_vtable(void *target, size_t index, const void *hook, const void **original)
+{
+	auto **vtable = (const void**)target;
+
+	if (!detail::hook::bind_original(original, vtable[index]))
+		return false;
+
+	page_access old_access;
+	vm_protect(&vtable[index], sizeof(void*), page_access::read_write, &old_access);
+	vtable[index] = hook;
+	vm_protect(&vtable[index], sizeof(void*), old_access);
+	return true;
 }
 
 void patch_jmp_rel32(const uintptr_t address, const void *hook)
 {
-	DWORD old_protect;
-	VirtualProtect((void*)address, 5, PAGE_EXECUTE_READWRITE, &old_protect);
+	page_access old_access;
+	vm_protect((void*)address, 5, page_access::read_write_execute, &old_access);
 	write_jmp((void*)address, hook);
-	VirtualProtect((void*)address, 5, old_protect, &old_protect);
+	vm_protect((void*)address, 5, old_access);
 }
@@ -1,17 +1,13 @@
 #pragma once
 
+#include "util/hook_profile.h"
 #include "util/platform.h"
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <utility>
 
-struct alignas(std::byte) rwx_byte {
-	std::byte value;
-	void *operator new[](size_t size);
-	void operator delete[](void *ptr);
-};
-
 void patch_code(void *target, const void *patch, size_t size);
 
 template<size_t N>
@@ -25,11 +21,17 @@ void patch_code(uintptr_t target, auto &&...args)
 	patch_code((void*)target, std::forward<decltype(args)>(args)...);
 }
 
-void patch_vtable(void *target, size_t index, const void *hook);
+// Write up to 8 bytes in one store, so other threads see all or none of them.
+// False if they don't fit in one aligned 8 bytes. The page must be writable.
+bool write_atomic(void *target, const void *bytes, size_t size);
 
-void patch_vtable(uintptr_t target, auto &&...args)
+// Point the vtable entry at a trampoline to hook. False, leaving the entry
+// alone, if the trampoline couldn't be allocated.
+bool patch_vtable(void *target, size_t index, const void *hook);
+
+bool patch_vtable(uintptr_t target, auto &&...args)
 {
-	patch_vtable((void*)target, std::forward<decltype(args)>(args)...);
+	return patch_vtable((void*)target, std::forward<decltype(args)>(args)...);
 }
 
 inline int32_t make_rel32(auto from, auto to, size_t instruction_size = 5)
@@ -37,6 +39,12 @@ inline int32_t make_rel32(auto from, auto to, size_t instruction_size = 5)
 	return (int32_t)((std::byte*)to - ((std::byte*)from + instruction_size));
 }
 
+inline bool in_rel32_reach(auto from, auto to, size_t instruction_size = 5)
+{
+	const auto rel = (intptr_t)to - ((intptr_t)from + (intptr_t)instruction_size);
+	return rel >= INT32_MIN && rel <= INT32_MAX;
+}
+
 inline void *read_rel32(auto address, size_t instruction_size = 5)
 {
 	const auto rel32 = *(int32_t*)((std::byte*)address + 1);
@@ -60,6 +68,17 @@ inline void write_jmp(void *address, const void *dest)
 	*(detail::op8_imm32*)address = {0xE9, make_rel32(address, dest)};
 }
 
+#ifdef __x86_64__
+constexpr size_t JMP_ABS_SIZE = 14;
+
+// jmp [rip]; dq dest, for destinations out of rel32 reach
+inline void write_jmp_abs(void *address, const void *dest)
+{
+	memcpy(address, "\xFF\x25\x00\x00\x00\x00", 6);
+	memcpy((std::byte*)address + 6, &dest, sizeof(dest));
+}
+#endif
+
 inline void write_push(void *address, auto value)
 {
 	*(detail::op8_imm32*)address = {0x68, std::bit_cast<int32_t>(value)};
@@ -100,14 +119,65 @@ inline auto call_virtual(auto *object, auto &&...args)
 }
 
 namespace detail::hook {
+
 inline thread_local void *original;
-}
+
+// Original for hooks patched without a trampoline, one slot per hook function.
+// Hooks patched at several sites are instantiated once per site, such as by
+// templating them on the address, as each site may have a different original.
+template<auto Hook>
+constinit inline const void *static_original = nullptr;
+
+#if defined(_WIN32)
+constexpr size_t TRAMPOLINE_SIZE = 15;
+#elif defined(__x86_64__)
+constexpr size_t TRAMPOLINE_SIZE = 21 + JMP_ABS_SIZE;
+#else
+constexpr size_t TRAMPOLINE_SIZE = 18;
+#endif
+
+// Stores original to detail::hook::original and jumps to hook
+std::byte *create_trampoline(const void *hook, const void *original, const void *near);
+
+// False if the slot is already bound to a different original
+bool bind_original(const void **slot, const void *original);
+
+} // namespace detail::hook
 
 inline uintptr_t HookGetOriginal()
 {
 	return (uintptr_t)detail::hook::original;
 }
 
-void patch_call_rel32(const uintptr_t address, const void *hook);
+// For hooks patched with patch_call_rel32<Hook> or patch_vtable<Hook>
+template<auto Hook>
+inline uintptr_t HookGetOriginal()
+{
+	return (uintptr_t)detail::hook::static_original<Hook>;
+}
+
+// Point the call at a trampoline to hook. False, leaving the call alone, if
+// the trampoline couldn't be allocated within reach.
+bool patch_call_rel32(const uintptr_t address, const void *hook);
 
 void patch_jmp_rel32(const uintptr_t address, const void *hook);
+
+// Point the call or vtable entry straight at the hook and store the original
+// in its static slot, skipping the trampoline's TLS store. A slot bound to a
+// different original is refused, so each site needs its own hook. The
+// templates profile the hook under HOOK_PROFILING, so Hook can't be naked.
+bool patch_call_rel32(const uintptr_t address, const void *hook, const void **original);
+
+bool patch_vtable(void *target, size_t index, const void *hook, const void **original);
+
+template<auto Hook>
+bool patch_call_rel32(const uintptr_t address)
+{
+	return patch_call_rel32(address, (const void*)instrumented<Hook>, &detail::hook::static_original<Hook>);
+}
+
+template<auto Hook>
+bool patch_vtable(auto target, size_t index)
+{
+	return patch_vtable((void*)target, index, (const void*)instrumented<Hook>, &detail::hook::static_original<Hook>);
+}
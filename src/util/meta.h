@@ -1,5 +1,6 @@
 #pragma once
 
+#include "util/platform.h"
 #include <algorithm>
 #include <array>
 #include <climits>
@@ -323,7 +324,7 @@ template<typename T, size_t N>
 struct string_literal;
 
 template<typename T>
-concept any_string_literal = requires(T t) { []<typename T, size_t N>(string_literal<T, N>){}(t); };
+concept any_string_literal = requires(T t) { []<typename U, size_t N>(string_literal<U, N>){}(t); };
 
 template<typename T, size_t N>
 struct string_literal {
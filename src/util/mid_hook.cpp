@@ -0,0 +1,295 @@
+#include "util/mid_hook.h"
+#include "util/memory.h"
+#include <cstring>
+#include <initializer_list>
+
+namespace {
+
+constexpr auto WORD = sizeof(uintptr_t);
+constexpr auto SP = 4;
+constexpr auto FLAGS_OFFSET = (int32_t)(MID_HOOK_REGISTERS * WORD);
+
+#ifdef __x86_64__
+constexpr uint8_t REX_W = 0x48;
+#ifdef _WIN64
+constexpr size_t RED_ZONE = 0;
+constexpr size_t SHADOW_SPACE = 32;
+#else
+constexpr size_t RED_ZONE = 128;
+constexpr size_t SHADOW_SPACE = 0;
+#endif
+#else
+constexpr uint8_t REX_W = 0;
+constexpr size_t RED_ZONE = 0;
+#endif
+
+// The context sits at the stack pointer, below anything the site owns
+constexpr auto FRAME = (int32_t)(sizeof(mid_hook_context) + RED_ZONE);
+
+// Emits to out, or only measures if out is nullptr
+class stub_writer {
+	std::byte *out;
+	size_t size = 0;
+
+public:
+	explicit stub_writer(std::byte *out) : out(out) {}
+
+	std::byte *here() const { return out != nullptr ? out + size : nullptr; }
+	size_t get_size() const { return size; }
+	void skip(size_t count) { size += count; }
+
+	void emit(const void *bytes, size_t count)
+	{
+		if (out != nullptr)
+			memcpy(out + size, bytes, count);
+
+		size += count;
+	}
+
+	void emit(std::initializer_list<uint8_t> bytes)
+	{
+		for (const auto byte : bytes)
+			emit(&byte, 1);
+	}
+
+	void emit_value(auto value)
+	{
+		emit(&value, sizeof(value));
+	}
+
+	// op with a ModRM operand of [sp+offset]
+	void stack_operand(uint8_t rex, uint8_t op, unsigned reg, int32_t offset)
+	{
+		if (rex != 0 || reg >= 8)
+			emit({(uint8_t)(rex | 0x40 | (reg >= 8 ? 0x04 : 0))});
+
+		const auto disp8 = offset >= INT8_MIN && offset <= INT8_MAX;
+		emit({op, (uint8_t)((disp8 ? 0x44 : 0x84) | (reg & 7) << 3), 0x24});
+
+		if (disp8)
+			emit_value((int8_t)offset);
+		else
+			emit_value(offset);
+	}
+
+	void store(unsigned reg, int32_t offset) { stack_operand(REX_W, 0x89, reg, offset); }
+	void load(unsigned reg, int32_t offset) { stack_operand(REX_W, 0x8B, reg, offset); }
+	void adjust_sp(int32_t amount) { stack_operand(REX_W, 0x8D, SP, amount); }
+
+	// jmp rel32, or an absolute jmp out of reach
+	void jmp(const void *to)
+	{
+#ifdef __x86_64__
+		if (out == nullptr || !in_rel32_reach(here(), to)) {
+			if (out != nullptr)
+				write_jmp_abs(here(), to);
+
+			skip(JMP_ABS_SIZE);
+			return;
+		}
+#endif
+		if (out != nullptr)
+			write_jmp(here(), to);
+
+		skip(5);
+	}
+};
+
+uint32_t saved_registers(const mid_hook &hook)
+{
+	auto saved = (hook.context | (MID_HOOK_VOLATILE & ~hook.dead)) & ~(1u << SP);
+#ifdef __x86_64__
+	// Holds the unaligned stack pointer across the call
+	saved |= MID_HOOK_BX;
+#endif
+	return saved;
+}
+
+void save(stub_writer &writer, uint32_t saved)
+{
+	writer.adjust_sp(-FRAME);
+
+	for (unsigned reg = 0; reg < MID_HOOK_REGISTERS; reg++) {
+		if (saved & (1u << reg))
+			writer.store(reg, (int32_t)(reg * WORD));
+	}
+
+	if (saved & MID_HOOK_FLAGS) {
+		// lahf and seto are far cheaper than pushf and popf, and the result
+		// is rearranged to match EFLAGS:
+		// lahf; seto al; shl al, 3; xchg al, ah; movzx eax, ax
+		writer.emit({0x9F, 0x0F, 0x90, 0xC0, 0xC0, 0xE0, 0x03, 0x86, 0xE0, 0x0F, 0xB7, 0xC0});
+		writer.store(0, FLAGS_OFFSET);
+	}
+
+	// lea ax, [sp+FRAME]; mov [sp+sp], ax
+	writer.stack_operand(REX_W, 0x8D, 0, FRAME);
+	writer.store(0, SP * WORD);
+}
+
+void restore(stub_writer &writer, uint32_t saved)
+{
+	if (saved & MID_HOOK_FLAGS) {
+		// Set OF by overflowing al if it was set, then load the rest:
+		// xchg al, ah; shr al, 3; add al, 0x7F; sahf
+		writer.load(0, FLAGS_OFFSET);
+		writer.emit({0x86, 0xE0, 0xC0, 0xE8, 0x03, 0x04, 0x7F, 0x9E});
+	}
+
+	for (unsigned reg = 0; reg < MID_HOOK_REGISTERS; reg++) {
+		if (saved & (1u << reg))
+			writer.load(reg, (int32_t)(reg * WORD));
+	}
+
+	writer.adjust_sp(FRAME);
+}
+
+void call_callback(stub_writer &writer, mid_hook_callback callback)
+{
+#ifdef __x86_64__
+	// mov rbx, rsp; and rsp, -16
+	writer.emit({0x48, 0x89, 0xE3, 0x48, 0x83, 0xE4, 0xF0});
+
+	if (SHADOW_SPACE != 0)
+		writer.emit({0x48, 0x83, 0xEC, (uint8_t)SHADOW_SPACE});
+
+#ifdef _WIN64
+	// mov rcx, rbx
+	writer.emit({0x48, 0x89, 0xD9});
+#else
+	// mov rdi, rbx
+	writer.emit({0x48, 0x89, 0xDF});
+#endif
+
+	// mov rax, callback; call rax; mov rsp, rbx
+	writer.emit({0x48, 0xB8});
+	writer.emit_value(callback);
+	writer.emit({0xFF, 0xD0, 0x48, 0x89, 0xDC});
+#else
+	// push esp; call callback; add esp, 4
+	writer.emit({0x54});
+
+	if (writer.here() != nullptr)
+		write_call(writer.here(), (const void*)callback);
+
+	writer.skip(5);
+	writer.emit({0x83, 0xC4, 0x04});
+#endif
+}
+
+// Emits everything up to the fall through path, returning where the jnz to
+// the taken path keeps its rel32
+size_t emit_entry(stub_writer &writer, const mid_hook &hook, uint32_t saved)
+{
+	save(writer, saved);
+	call_callback(writer, hook.callback);
+
+	// test al, al; jnz taken
+	writer.emit({0x84, 0xC0, 0x0F, 0x85});
+	const auto rel32_offset = writer.get_size();
+	writer.skip(sizeof(int32_t));
+	return rel32_offset;
+}
+
+void link_taken(stub_writer &writer, std::byte *code, size_t rel32_offset)
+{
+	if (code == nullptr)
+		return;
+
+	const auto rel32 = make_rel32(code + rel32_offset, writer.here(), sizeof(int32_t));
+	memcpy(code + rel32_offset, &rel32, sizeof(rel32));
+}
+
+struct site_emit_result {
+	size_t code_size;
+	size_t source_size;
+	relocate_error error;
+};
+
+site_emit_result emit_site_stub(const std::byte *site, const mid_hook &hook, std::byte *code)
+{
+	auto writer = stub_writer(code);
+	const auto saved = saved_registers(hook);
+	const auto rel32_offset = emit_entry(writer, hook, saved);
+
+	restore(writer, saved);
+
+	const auto relocated = relocate_code(site, 5, writer.here());
+
+	if (relocated.error != relocate_error::none)
+		return {0, 0, relocated.error};
+
+	writer.skip(relocated.code_size);
+	writer.jmp(site + relocated.source_size);
+
+	link_taken(writer, code, rel32_offset);
+	restore(writer, saved);
+	writer.jmp((const void*)hook.jump_target);
+
+	return {writer.get_size(), relocated.source_size, relocate_error::none};
+}
+
+size_t emit_call_stub(const mid_hook &hook, const void *const *original, std::byte *code)
+{
+	auto writer = stub_writer(code);
+	const auto saved = saved_registers(hook);
+	const auto rel32_offset = emit_entry(writer, hook, saved);
+
+	restore(writer, saved);
+
+#ifdef __x86_64__
+	if (code == nullptr || !in_rel32_reach(writer.here(), original, 6)) {
+		// push rax; mov rax, original; mov rax, [rax]; xchg [rsp], rax; ret
+		writer.emit({0x50, 0x48, 0xB8});
+		writer.emit_value(original);
+		writer.emit({0x48, 0x8B, 0x00, 0x48, 0x87, 0x04, 0x24, 0xC3});
+	} else {
+		// jmp [rip+original]
+		writer.emit({0xFF, 0x25});
+		writer.emit_value(make_rel32(writer.here() - 2, original, 6));
+	}
+#else
+	// jmp [original]
+	writer.emit({0xFF, 0x25});
+	writer.emit_value(original);
+#endif
+
+	link_taken(writer, code, rel32_offset);
+	restore(writer, saved);
+	writer.emit({0xC3});
+
+	return writer.get_size();
+}
+
+} // namespace
+
+mid_hook_stub create_mid_hook_stub(const void *site, const mid_hook &hook)
+{
+	const auto *source = (const std::byte*)site;
+	const auto measured = emit_site_stub(source, hook, nullptr);
+
+	if (measured.error != relocate_error::none)
+		return {nullptr, 0, measured.error};
+
+	auto code = make_exec(measured.code_size, site);
+
+	if (code == nullptr)
+		return {nullptr, 0, relocate_error::no_memory};
+
+	const auto emitted = emit_site_stub(source, hook, code.get());
+
+	if (emitted.error != relocate_error::none)
+		return {nullptr, 0, emitted.error};
+
+	return {std::move(code), emitted.source_size, relocate_error::none};
+}
+
+exec_ptr create_mid_call_stub(const mid_hook &hook, const void *const *original, const void *near)
+{
+	auto code = make_exec(emit_call_stub(hook, original, nullptr), near);
+
+	if (code != nullptr)
+		emit_call_stub(hook, original, code.get());
+
+	return code;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "util/exec_arena.h"
+#include "util/hooks.h"
+#include <cstddef>
+#include <cstdint>
+
+// Generated stubs that run a C++ callback from the middle of a function, or
+// from a call site, with the registers it names laid out in a context struct.
+// Only those registers and the caller saved ones still live at the site are
+// saved, and whatever the callback writes to the context is written back.
+//
+// Of the flags, only the arithmetic ones are saved. Vector and x87 registers
+// aren't saved at all, so none may be live at the site beyond what the
+// callback's ABI preserves.
+
+// Register bits, by ModRM number
+enum : uint32_t {
+	MID_HOOK_AX    = 1 << 0,
+	MID_HOOK_CX    = 1 << 1,
+	MID_HOOK_DX    = 1 << 2,
+	MID_HOOK_BX    = 1 << 3,
+	MID_HOOK_BP    = 1 << 5,
+	MID_HOOK_SI    = 1 << 6,
+	MID_HOOK_DI    = 1 << 7,
+#ifdef __x86_64__
+	MID_HOOK_R8    = 1 << 8,
+	MID_HOOK_R9    = 1 << 9,
+	MID_HOOK_R10   = 1 << 10,
+	MID_HOOK_R11   = 1 << 11,
+	MID_HOOK_R12   = 1 << 12,
+	MID_HOOK_R13   = 1 << 13,
+	MID_HOOK_R14   = 1 << 14,
+	MID_HOOK_R15   = 1 << 15,
+#endif
+	MID_HOOK_FLAGS = 1 << 16
+};
+
+#ifdef __x86_64__
+constexpr size_t MID_HOOK_REGISTERS = 16;
+#else
+constexpr size_t MID_HOOK_REGISTERS = 8;
+#endif
+
+// Caller saved registers, which the stub preserves unless they're dead
+#if defined(_WIN64)
+constexpr uint32_t MID_HOOK_VOLATILE = MID_HOOK_AX | MID_HOOK_CX | MID_HOOK_DX | MID_HOOK_R8 |
+                                       MID_HOOK_R9 | MID_HOOK_R10 | MID_HOOK_R11 | MID_HOOK_FLAGS;
+#elif defined(__x86_64__)
+constexpr uint32_t MID_HOOK_VOLATILE = MID_HOOK_AX | MID_HOOK_CX | MID_HOOK_DX | MID_HOOK_SI |
+                                       MID_HOOK_DI | MID_HOOK_R8 | MID_HOOK_R9 | MID_HOOK_R10 |
+                                       MID_HOOK_R11 | MID_HOOK_FLAGS;
+#else
+constexpr uint32_t MID_HOOK_VOLATILE = MID_HOOK_AX | MID_HOOK_CX | MID_HOOK_DX | MID_HOOK_FLAGS;
+#endif
+
+// Registers the callback didn't name hold garbage, and writes to them are
+// discarded
+struct mid_hook_context {
+	uintptr_t ax;
+	uintptr_t cx;
+	uintptr_t dx;
+	uintptr_t bx;
+	// Stack pointer at the site, always filled in and never written back
+	uintptr_t sp;
+	uintptr_t bp;
+	uintptr_t si;
+	uintptr_t di;
+#ifdef __x86_64__
+	uintptr_t r8;
+	uintptr_t r9;
+	uintptr_t r10;
+	uintptr_t r11;
+	uintptr_t r12;
+	uintptr_t r13;
+	uintptr_t r14;
+	uintptr_t r15;
+#endif
+	// OF, SF, ZF, AF, PF and CF, as laid out in EFLAGS
+	uintptr_t flags;
+
+	// Stack at the site, where a call stub finds its return address at 0
+	template<typename T>
+	T &stack(ptrdiff_t offset) const
+	{
+		return *(T*)(sp + offset);
+	}
+};
+
+static_assert(sizeof(mid_hook_context) == (MID_HOOK_REGISTERS + 1) * sizeof(uintptr_t));
+
+// True to take the hook's jump target, false to fall through
+using mid_hook_callback = bool(*)(mid_hook_context *context);
+
+struct mid_hook {
+	mid_hook_callback callback = nullptr;
+	// Registers the callback reads or writes through its context
+	uint32_t context = 0;
+	// Caller saved registers the site doesn't need preserved
+	uint32_t dead = 0;
+	// Where to continue when the callback returns true. Call stubs return to
+	// their caller instead.
+	uintptr_t jump_target = 0;
+
+	constexpr explicit operator bool() const { return callback != nullptr; }
+};
+
+struct mid_hook_stub {
+	exec_ptr code;
+	// Whole instructions at the site replayed by the stub
+	size_t source_size;
+	relocate_error error;
+};
+
+// Stub for a jmp rel32 at site. Falling through replays the instructions the
+// jmp replaces and jumps back after them.
+mid_hook_stub create_mid_hook_stub(const void *site, const mid_hook &hook);
+
+// Stub for a call to a function, which falls through to *original with the
+// caller's registers and stack untouched. Taking the jump returns to the
+// caller, with ax as the result if the callback names it.
+exec_ptr create_mid_call_stub(const mid_hook &hook, const void *const *original, const void *near);
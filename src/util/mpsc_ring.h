@@ -0,0 +1,86 @@
+#pragma once
+
+#include "util/platform.h"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed capacity ring buffer with any number of producer threads and one
+// consumer thread. Producers claim slots in order and publish each through its
+// own sequence number, so a slow producer only holds up the consumer at its
+// slot.
+template<typename T, size_t Capacity> requires (std::has_single_bit(Capacity))
+class mpsc_ring {
+	struct slot {
+		// Index + 1 once published, index + Capacity once consumed
+		std::atomic<uint32_t> sequence;
+		T item;
+	};
+
+	alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> head = 0;
+	alignas(CACHE_LINE_SIZE) uint32_t tail = 0;
+	alignas(CACHE_LINE_SIZE) slot slots[Capacity];
+
+public:
+	mpsc_ring()
+	{
+		for (uint32_t i = 0; i < Capacity; i++)
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	// Any thread, claim the next slot and pass it to write along with its
+	// index, which counts every item pushed. False if full.
+	bool push(auto &&write)
+	{
+		auto index = head.load(std::memory_order_relaxed);
+
+		for (;;) {
+			auto &slot = slots[index % Capacity];
+			const auto sequence = slot.sequence.load(std::memory_order_acquire);
+			const auto distance = (int32_t)(sequence - index);
+
+			if (distance < 0)
+				return false;
+
+			if (distance == 0) {
+				if (head.compare_exchange_weak(index, index + 1, std::memory_order_relaxed))
+					break;
+			} else {
+				index = head.load(std::memory_order_relaxed);
+			}
+		}
+
+		auto &slot = slots[index % Capacity];
+		write(slot.item, index);
+		slot.sequence.store(index + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only, pass each published item to callable until it returns
+	// false, leaving that item in place. Stops at the first slot still being
+	// written. Returns the number consumed.
+	size_t consume(auto &&callable)
+	{
+		const auto start = tail;
+
+		for (;; tail++) {
+			auto &slot = slots[tail % Capacity];
+
+			if (slot.sequence.load(std::memory_order_acquire) != tail + 1)
+				break;
+			if (!callable(slot.item))
+				break;
+
+			slot.sequence.store(tail + Capacity, std::memory_order_release);
+		}
+
+		return tail - start;
+	}
+
+	// Consumer only, discard everything published
+	void clear()
+	{
+		consume([](const T&) { return true; });
+	}
+};
@@ -0,0 +1,473 @@
+#include "util/patch_transaction.h"
+#include "util/exec_arena.h"
+#include "util/memory.h"
+#include "util/platform.h"
+#include "util/thread_freeze.h"
+#include "util/virtual_memory.h"
+#include "util/x86_decode.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+// Attempts at stopping every thread outside the code being patched
+constexpr auto FREEZE_ATTEMPTS = 20;
+constexpr auto FREEZE_RETRY_DELAY = std::chrono::milliseconds(1);
+
+patch_transaction::~patch_transaction()
+{
+	// Patched code may still jump to the trampolines and stubs
+	if (committed && !revert()) {
+		for (auto &stub : stubs)
+			stub.release();
+
+		return;
+	}
+
+	for (auto *trampoline : trampolines)
+		exec_free(trampoline, detail::hook::TRAMPOLINE_SIZE);
+}
+
+void patch_transaction::queue(
+	void *target, const void *patch, size_t size, std::string_view expected, bool is_code)
+{
+	auto *bytes = (std::byte*)target;
+
+	if (!expected.empty() && (expected.size() > size || memcmp(target, expected.data(), expected.size()) != 0)) {
+		failed = true;
+		return;
+	}
+
+	// No thread can be partway into a single instruction, so a write within
+	// the first instruction of both the original and the patch is seen whole
+	const auto fits_word = ((uintptr_t)target & 7) + size <= sizeof(uint64_t);
+	auto within_instruction = !is_code;
+
+	if (is_code && fits_word) {
+		uint8_t patched[sizeof(uint64_t) + detail::x86::MAX_LENGTH];
+		memcpy(patched, patch, size);
+		memcpy(patched + size, bytes + size, detail::x86::MAX_LENGTH);
+
+		within_instruction =
+			size <= decode_x86((const uint8_t*)target).length &&
+			size <= decode_x86(patched).length;
+	}
+
+	writes.push_back({
+		.target       = bytes,
+		.patch        = {(const std::byte*)patch, (const std::byte*)patch + size},
+		.original     = {bytes, bytes + size},
+		.single_store = fits_word && within_instruction
+	});
+}
+
+void patch_transaction::code(
+	uintptr_t address, std::string_view bytes, std::string_view expected, std::string_view expected_mask)
+{
+	if (expected_mask.empty()) {
+		queue((void*)address, bytes.data(), bytes.size(), expected);
+		return;
+	}
+
+	if (expected_mask.size() != expected.size() || expected.size() > bytes.size()) {
+		failed = true;
+		return;
+	}
+
+	for (size_t i = 0; i < expected.size(); i++) {
+		if ((((const char*)address)[i] ^ expected[i]) & expected_mask[i]) {
+			failed = true;
+			return;
+		}
+	}
+
+	queue((void*)address, bytes.data(), bytes.size());
+}
+
+const void *patch_transaction::redirect(
+	const void *hook, const void *original, const void **slot, const void *near)
+{
+	if (slot == nullptr) {
+		auto *trampoline = detail::hook::create_trampoline(hook, original, near);
+
+		if (trampoline != nullptr)
+			trampolines.push_back(trampoline);
+
+		return trampoline;
+	}
+
+	// A slot holds one original, whether bound earlier or in this transaction
+	if (*slot != nullptr && *slot != original)
+		return nullptr;
+
+	for (const auto &[bound, value] : bindings) {
+		if (bound == slot && value != original)
+			return nullptr;
+	}
+
+	bindings.push_back({slot, original});
+	return hook;
+}
+
+void patch_transaction::call_rel32(
+	uintptr_t address, const void *hook, std::string_view expected, const void **original)
+{
+	if (*(uint8_t*)address != 0xE8) {
+		failed = true;
+		return;
+	}
+
+	const auto *target = redirect(hook, read_rel32(address), original, (void*)address);
+
+	if (target == nullptr || !in_rel32_reach(address, target)) {
+		failed = true;
+		return;
+	}
+
+	const auto call = detail::op8_imm32 {0xE8, make_rel32(address, target)};
+	queue((void*)address, &call, sizeof(call), expected);
+}
+
+void patch_transaction::jmp_rel32(uintptr_t address, const void *hook, std::string_view expected)
+{
+	if (!in_rel32_reach(address, hook)) {
+		failed = true;
+		return;
+	}
+
+	const auto jmp = detail::op8_imm32 {0xE9, make_rel32(address, hook)};
+	queue((void*)address, &jmp, sizeof(jmp), expected);
+}
+
+void patch_transaction::mid(uintptr_t address, const mid_hook &hook, std::string_view expected)
+{
+	if (!hook || hook.jump_target == 0) {
+		failed = true;
+		return;
+	}
+
+	auto stub = create_mid_hook_stub((void*)address, hook);
+
+	if (stub.error != relocate_error::none || !in_rel32_reach(address, stub.code.get())) {
+		failed = true;
+		return;
+	}
+
+	const auto jmp = detail::op8_imm32 {0xE9, make_rel32(address, stub.code.get())};
+	queue((void*)address, &jmp, sizeof(jmp), expected);
+	stubs.push_back(std::move(stub.code));
+}
+
+const void *patch_transaction::mid_call_stub(const mid_hook &hook, const void **original, const void *near)
+{
+	if (original == nullptr)
+		return nullptr;
+
+	auto stub = create_mid_call_stub(hook, original, near);
+
+	if (stub == nullptr)
+		return nullptr;
+
+	return stubs.emplace_back(std::move(stub)).get();
+}
+
+void patch_transaction::vtable(uintptr_t address, size_t index, const void *hook, const void **original)
+{
+	auto *entry = &((const void**)address)[index];
+	const auto *patch = redirect(hook, *entry, original, nullptr);
+
+	if (patch == nullptr) {
+		failed = true;
+		return;
+	}
+
+	queue(entry, &patch, sizeof(patch), {}, false);
+}
+
+void patch_transaction::shared_call_rel32(uintptr_t address, const void *hook, const void **original)
+{
+	if (*(uint8_t*)address != 0xE8 || original == nullptr) {
+		failed = true;
+		return;
+	}
+
+	shared_hooks.push_back({hook_site::call_rel32, address, hook, original});
+}
+
+void patch_transaction::shared_vtable(uintptr_t address, size_t index, const void *hook, const void **original)
+{
+	if (original == nullptr) {
+		failed = true;
+		return;
+	}
+
+	shared_hooks.push_back({hook_site::vtable, (uintptr_t)&((const void**)address)[index], hook, original});
+}
+
+void patch_transaction::add(const patch_entry &entry)
+{
+	const void *hook = nullptr;
+
+	if (entry.kind == patch_kind::call_rel32 || entry.kind == patch_kind::vtable) {
+		const auto *near = entry.kind == patch_kind::call_rel32 ? (void*)entry.address : nullptr;
+		hook = entry.mid ? mid_call_stub(entry.mid, entry.original, near) : entry.hook();
+
+		if (hook == nullptr) {
+			failed = true;
+			return;
+		}
+	}
+
+	if (entry.shared) {
+		if (entry.kind == patch_kind::call_rel32)
+			shared_call_rel32(entry.address, hook, entry.original);
+		else if (entry.kind == patch_kind::vtable)
+			shared_vtable(entry.address, entry.index, hook, entry.original);
+		else
+			failed = true;
+
+		return;
+	}
+
+	switch (entry.kind) {
+	case patch_kind::call_rel32:
+		call_rel32(entry.address, hook, entry.expected, entry.original);
+		break;
+	case patch_kind::jmp_rel32:
+		jmp_rel32(entry.address, entry.hook(), entry.expected);
+		break;
+	case patch_kind::mid:
+		mid(entry.address, entry.mid, entry.expected);
+		break;
+	case patch_kind::vtable:
+		vtable(entry.address, entry.index, hook, entry.original);
+		break;
+	case patch_kind::code:
+		code(entry.address, entry.bytes, entry.expected, entry.expected_mask);
+		break;
+	}
+}
+
+void patch_transaction::add(std::span<const patch_entry> manifest)
+{
+	for (const auto &entry : manifest)
+		add(entry);
+}
+
+bool patch_transaction::write_all(bool patched)
+{
+	std::vector<uintptr_t> pages;
+	auto low = UINTPTR_MAX;
+	auto high = (uintptr_t)0;
+
+	const auto add_range = [&](uintptr_t start, size_t size) {
+		const auto end = start + size;
+		low = std::min(low, start);
+		high = std::max(high, end);
+
+		for (auto page = start & ~(PAGE_SIZE - 1); page < end; page += PAGE_SIZE)
+			pages.push_back(page);
+	};
+
+	for (const auto &write : writes)
+		add_range((uintptr_t)write.target, write.patch.size());
+
+	for (const auto &hook : shared_hooks)
+		add_range(hook.address, hook.site == hook_site::call_rel32 ? 5 : sizeof(void*));
+
+	std::ranges::sort(pages);
+	pages.erase(std::ranges::unique(pages).begin(), pages.end());
+
+	std::vector<page_access> old_access(pages.size());
+
+	const auto restore_protection = [&](size_t count) {
+		for (size_t i = 0; i < count; i++)
+			vm_protect((void*)pages[i], PAGE_SIZE, old_access[i]);
+	};
+
+	// Unprotect everything up front so no write can fail halfway
+	for (size_t i = 0; i < pages.size(); i++) {
+		if (!vm_protect((void*)pages[i], PAGE_SIZE, page_access::read_write_execute, &old_access[i])) {
+			restore_protection(i);
+			return false;
+		}
+	}
+
+	// Shared sites are written by the registry, which leaves the pages to
+	// this batch if it can
+	auto *registry = shared_hooks.empty() ? nullptr : get_hook_dispatch_registry();
+	const auto batched = registry != nullptr && hook_dispatch_has_batch(registry);
+
+	if (batched)
+		registry->begin_batch();
+
+	// Shared hooks join after the writes and leave before them
+	auto written = false;
+
+	if (patched) {
+		written = write_code(true);
+
+		if (written && !add_shared(0, shared_hooks.size())) {
+			write_code(false);
+			written = false;
+		}
+	} else {
+		written = remove_shared(0, shared_hooks.size());
+
+		if (written && !write_code(false)) {
+			add_shared(0, shared_hooks.size());
+			written = false;
+		}
+	}
+
+	if (batched)
+		registry->end_batch();
+
+	restore_protection(pages.size());
+
+	if (!pages.empty())
+		vm_flush_icache((void*)low, high - low);
+
+	if (written)
+		pages_touched = pages.size();
+
+	return written;
+}
+
+bool patch_transaction::write_code(bool patched)
+{
+	const auto needs_freeze = std::ranges::any_of(writes, [](const pending_write &write) {
+		return !write.single_store;
+	});
+
+	if (needs_freeze)
+		return write_frozen(patched);
+
+	write_pending(patched);
+	return true;
+}
+
+// Nothing here may allocate, as other threads may be stopped
+void patch_transaction::write_pending(bool patched)
+{
+	if (patched) {
+		// Hooks must see their originals as soon as they can be reached
+		for (const auto &[slot, original] : bindings)
+			*slot = original;
+	}
+
+	for (const auto &write : writes) {
+		const auto &bytes = patched ? write.patch : write.original;
+
+		if (!write.single_store || !write_atomic(write.target, bytes.data(), bytes.size()))
+			memcpy(write.target, bytes.data(), bytes.size());
+	}
+}
+
+// Retries until no stopped thread would resume partway into a write
+bool patch_transaction::write_frozen(bool patched)
+{
+	for (auto attempt = 0; attempt < FREEZE_ATTEMPTS; attempt++) {
+		if (attempt != 0)
+			std::this_thread::sleep_for(FREEZE_RETRY_DELAY);
+
+		const auto freeze = thread_freeze();
+
+		if (!freeze.is_complete())
+			continue;
+
+		const auto inside = std::ranges::any_of(writes, [&](const pending_write &write) {
+			return freeze.any_inside(write.target, write.patch.size());
+		});
+
+		if (!inside) {
+			write_pending(patched);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool patch_transaction::commit()
+{
+	if (failed)
+		return false;
+
+	if (committed)
+		return true;
+
+	// Overlapping writes would make the saved originals inconsistent
+	auto sorted = std::vector<const pending_write*>();
+	for (const auto &write : writes)
+		sorted.push_back(&write);
+
+	std::ranges::sort(sorted, {}, &pending_write::target);
+
+	for (size_t i = 1; i < sorted.size(); i++) {
+		if (sorted[i - 1]->target + sorted[i - 1]->patch.size() > sorted[i]->target)
+			return false;
+	}
+
+	// Don't overwrite someone else's patch made since add, such as while
+	// reverted
+	for (const auto &write : writes) {
+		if (memcmp(write.target, write.original.data(), write.original.size()) != 0)
+			return false;
+	}
+
+	if (!write_all(true))
+		return false;
+
+	committed = true;
+	return true;
+}
+
+bool patch_transaction::add_shared(size_t first, size_t last)
+{
+	auto *registry = get_hook_dispatch_registry();
+
+	for (auto i = first; i < last; i++) {
+		auto &hook = shared_hooks[i];
+		hook.handle = registry->add(hook.site, hook.address, hook.hook, hook.original, 0);
+
+		if (hook.handle == 0) {
+			remove_shared(first, i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool patch_transaction::remove_shared(size_t first, size_t last)
+{
+	auto *registry = get_hook_dispatch_registry();
+
+	for (auto i = last; i-- > first;) {
+		if (!registry->remove(shared_hooks[i].handle)) {
+			add_shared(i + 1, last);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool patch_transaction::revert()
+{
+	if (!committed)
+		return true;
+
+	// Don't undo someone else's patch on top of ours
+	for (const auto &write : writes) {
+		if (memcmp(write.target, write.patch.data(), write.patch.size()) != 0)
+			return false;
+	}
+
+	if (!write_all(false))
+		return false;
+
+	committed = false;
+	return true;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "util/exec_arena.h"
+#include "util/hook_dispatch.h"
+#include "util/mid_hook.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+enum class patch_kind {
+	// Redirect a call rel32 through a trampoline to hook
+	call_rel32,
+	// Overwrite the instruction at address with a jmp rel32 to hook
+	jmp_rel32,
+	// Overwrite the instructions at address with a jmp rel32 to a stub that
+	// calls mid.callback, then replays them or takes mid.jump_target
+	mid,
+	// Redirect a vtable entry through a trampoline to hook
+	vtable,
+	// Write raw bytes
+	code
+};
+
+// Constant expression address of a function, for use in manifests
+template<auto Function>
+const void *function_address()
+{
+	return (const void*)Function;
+}
+
+struct patch_entry {
+	patch_kind kind;
+	uintptr_t address;
+	// Entry index for patch_kind::vtable
+	size_t index = 0;
+	const void *(*hook)() = nullptr;
+	// Static original slot for call_rel32 and vtable, which skips the trampoline
+	const void **original = nullptr;
+	// Replacement for patch_kind::code
+	std::string_view bytes = {};
+	// Original bytes to verify before patching, if known
+	std::string_view expected = {};
+	// Bits of expected to verify for patch_kind::code, all if empty, for
+	// sites where only the instruction's form is known
+	std::string_view expected_mask = {};
+	// Join other modules' hooks on a call_rel32 or vtable site through the
+	// dispatch registry, which needs a static original slot
+	bool shared = false;
+	// Generated hook for patch_kind::mid, or in place of hook for call_rel32
+	// and vtable, which then need a static original slot
+	mid_hook mid = {};
+};
+
+// Collects patches and applies them together. Commit verifies every original
+// before writing anything, changes each page's protection once, flushes the
+// instruction cache once, and restores everything written if a write fails.
+//
+// Patching is safe while other threads run the code. A write replacing one
+// whole instruction or a vtable entry within an aligned 8 bytes is a single
+// store. Anything else is written with every other thread stopped, once none
+// would resume partway into it. Threads returning into a patch from a call it
+// replaced aren't detected.
+//
+// A committed transaction owns its patches and reverts them when destroyed.
+// Hooks must have returned before then, as their trampolines are freed.
+class patch_transaction {
+	struct pending_write {
+		std::byte *target;
+		std::vector<std::byte> patch;
+		std::vector<std::byte> original;
+		// Written with write_atomic rather than under a thread_freeze
+		bool single_store;
+	};
+
+	std::vector<pending_write> writes;
+	// Freed with the transaction
+	std::vector<std::byte*> trampolines;
+	std::vector<exec_ptr> stubs;
+	// Static original slots, bound on commit before anything is written
+	std::vector<std::pair<const void**, const void*>> bindings;
+
+	struct shared_hook {
+		hook_site site;
+		uintptr_t address;
+		const void *hook;
+		const void **original;
+		uintptr_t handle;
+	};
+
+	// Added to the dispatch registry after the writes
+	std::vector<shared_hook> shared_hooks;
+	size_t pages_touched = 0;
+	bool failed = false;
+	bool committed = false;
+
+	void queue(void *target, const void *patch, size_t size, std::string_view expected = {}, bool is_code = true);
+	// Trampoline or static binding for a hook, nullptr on failure
+	const void *redirect(const void *hook, const void *original, const void **slot, const void *near);
+	// Call stub for a generated hook, nullptr on failure
+	const void *mid_call_stub(const mid_hook &hook, const void **original, const void *near);
+	// Write each patch or each original and add or remove the shared hooks in
+	// one pass over the pages
+	bool write_all(bool patched);
+	bool write_code(bool patched);
+	void write_pending(bool patched);
+	bool write_frozen(bool patched);
+	// Add or remove shared hooks [first, last) in the registry, undoing the
+	// rest on failure
+	bool add_shared(size_t first, size_t last);
+	bool remove_shared(size_t first, size_t last);
+
+public:
+	~patch_transaction();
+
+	void code(uintptr_t address, std::string_view bytes,
+	          std::string_view expected = {}, std::string_view expected_mask = {});
+	void call_rel32(uintptr_t address, const void *hook,
+	                std::string_view expected = {}, const void **original = nullptr);
+	void jmp_rel32(uintptr_t address, const void *hook, std::string_view expected = {});
+	void mid(uintptr_t address, const mid_hook &hook, std::string_view expected = {});
+	void vtable(uintptr_t address, size_t index, const void *hook, const void **original = nullptr);
+	void shared_call_rel32(uintptr_t address, const void *hook, const void **original);
+	void shared_vtable(uintptr_t address, size_t index, const void *hook, const void **original);
+	void add(const patch_entry &entry);
+	void add(std::span<const patch_entry> manifest);
+
+	// False if any patch failed verification, any site no longer holds the
+	// bytes it had when added, or a write failed, in which case nothing is
+	// left patched
+	bool commit();
+
+	// Restore every original in one pass. False if something else has since
+	// overwritten a patch, in which case nothing is restored. Static original
+	// slots stay bound so a hook entered just before can still call through.
+	// Commit may be called again afterwards.
+	bool revert();
+
+	bool is_committed() const { return committed; }
+
+	size_t patch_count() const { return writes.size() + shared_hooks.size(); }
+	size_t page_count() const { return pages_touched; }
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "util/preprocessor.h"
+#include <cstddef>
 
 #define PRAGMA(x) _Pragma(#x)
 
@@ -8,4 +9,20 @@
 #define PACK(n) PRAGMA(pack(push, n)) PACK_BODY_
 #define PACKED PACK(1)
 
+#ifndef _MSC_VER
+// Calling convention keywords for non-MSVC toolchains
+#ifdef __i386__
+#define __cdecl __attribute__((cdecl))
+#define __stdcall __attribute__((stdcall))
+#define __fastcall __attribute__((fastcall))
+#define __thiscall __attribute__((thiscall))
+#else
+#define __cdecl
+#define __stdcall
+#define __fastcall
+#define __thiscall
+#endif
+#endif
+
 constexpr size_t PAGE_SIZE = 0x1000;
+constexpr size_t CACHE_LINE_SIZE = 64;
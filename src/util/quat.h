@@ -0,0 +1,204 @@
+#pragma once
+
+#include "util/matrix.h"
+#include "util/vector.h"
+#include <cmath>
+#include <type_traits>
+
+struct quat_base;
+
+using quat = vec_impl<quat_base>;
+
+// Rotation quaternion with its vector part in x, y and z and its scalar part
+// in w. Products apply the right operand first, like matrix products, and
+// rotations match multiplying by to_matrix's result.
+struct quat_base : vec4_base<float> {
+	static constexpr quat identity();
+
+	// axis must be normalized
+	static quat from_axis_angle(const vec3 &axis, float angle);
+
+	// m must be a rotation
+	static quat from_matrix(const matrix3x3 &m);
+
+	static constexpr matrix3x3 to_matrix(const quat &q);
+
+	static constexpr quat multiply(const quat &a, const quat &b);
+
+	// Inverse of a unit quaternion
+	static constexpr quat conjugate(const quat &q);
+
+	// q must be normalized
+	static constexpr vec3 rotate(const quat &q, const vec3 &v);
+
+	// Normalized lerp along the shorter arc, cheaper than slerp but not at a
+	// constant angular speed
+	static quat nlerp(const quat &a, const quat &b, float t);
+
+	static quat slerp(const quat &a, const quat &b, float t);
+};
+
+#ifdef VECTOR_SSE
+template<>
+struct vec_simd<quat_base> : vec_sse<quat_base> {
+	static __m128 cross(__m128 a, __m128 b)
+	{
+		const auto a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		const auto a_zxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+		const auto b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		const auto b_zxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+		return _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+	}
+
+	// Each of a's lanes times b reordered and negated per lane, summed in the
+	// scalar path's order
+	static quat multiply(const quat &a, const quat &b)
+	{
+		const auto va = load(a);
+		const auto vb = load(b);
+		const auto ax = _mm_shuffle_ps(va, va, _MM_SHUFFLE(0, 0, 0, 0));
+		const auto ay = _mm_shuffle_ps(va, va, _MM_SHUFFLE(1, 1, 1, 1));
+		const auto az = _mm_shuffle_ps(va, va, _MM_SHUFFLE(2, 2, 2, 2));
+		const auto aw = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 3, 3, 3));
+		const auto b_wzyx = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.f, -0.f, 0.f, -0.f));
+		const auto b_zwxy = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.f, 0.f, -0.f, -0.f));
+		const auto b_yxwz = _mm_xor_ps(_mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.f, 0.f, 0.f, -0.f));
+
+		auto sum = _mm_add_ps(_mm_mul_ps(aw, vb), _mm_mul_ps(ax, b_wzyx));
+		sum = _mm_add_ps(sum, _mm_mul_ps(ay, b_zwxy));
+		sum = _mm_add_ps(sum, _mm_mul_ps(az, b_yxwz));
+		return make(sum);
+	}
+
+	// vec3 has no SSE path of its own, so v goes in and out by lanes
+	static vec3 rotate(const quat &q, const vec3 &v)
+	{
+		const auto vq = load(q);
+		const auto vv = _mm_setr_ps(v.x, v.y, v.z, 0.f);
+		const auto w = _mm_shuffle_ps(vq, vq, _MM_SHUFFLE(3, 3, 3, 3));
+		const auto t = _mm_mul_ps(cross(vq, vv), _mm_set1_ps(2.f));
+		const auto result = _mm_add_ps(_mm_add_ps(vv, _mm_mul_ps(t, w)), cross(vq, t));
+
+		alignas(16) float lanes[4];
+		_mm_store_ps(lanes, result);
+		return vec3(lanes[0], lanes[1], lanes[2]);
+	}
+};
+#endif
+
+constexpr quat quat_base::identity()
+{
+	return quat(0.f, 0.f, 0.f, 1.f);
+}
+
+inline quat quat_base::from_axis_angle(const vec3 &axis, float angle)
+{
+	const auto s = std::sin(angle * .5f);
+	return quat(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * .5f));
+}
+
+// Solved from the largest of w, x, y and z, which keeps the division well
+// conditioned
+inline quat quat_base::from_matrix(const matrix3x3 &m)
+{
+	const auto m00 = m.get(0, 0), m01 = m.get(0, 1), m02 = m.get(0, 2);
+	const auto m10 = m.get(1, 0), m11 = m.get(1, 1), m12 = m.get(1, 2);
+	const auto m20 = m.get(2, 0), m21 = m.get(2, 1), m22 = m.get(2, 2);
+
+	if (const auto trace = m00 + m11 + m22; trace > 0.f) {
+		const auto s = std::sqrt(trace + 1.f) * 2.f;
+		return quat((m21 - m12) / s, (m02 - m20) / s, (m10 - m01) / s, s * .25f);
+	} else if (m00 > m11 && m00 > m22) {
+		const auto s = std::sqrt(1.f + m00 - m11 - m22) * 2.f;
+		return quat(s * .25f, (m01 + m10) / s, (m02 + m20) / s, (m21 - m12) / s);
+	} else if (m11 > m22) {
+		const auto s = std::sqrt(1.f + m11 - m00 - m22) * 2.f;
+		return quat((m01 + m10) / s, s * .25f, (m12 + m21) / s, (m02 - m20) / s);
+	} else {
+		const auto s = std::sqrt(1.f + m22 - m00 - m11) * 2.f;
+		return quat((m02 + m20) / s, (m12 + m21) / s, s * .25f, (m10 - m01) / s);
+	}
+}
+
+constexpr matrix3x3 quat_base::to_matrix(const quat &q)
+{
+	const auto &[x, y, z, w] = q.elems();
+	return matrix3x3 {
+		1.f - 2.f * (y * y + z * z), 2.f * (x * y - z * w),       2.f * (x * z + y * w),
+		2.f * (x * y + z * w),       1.f - 2.f * (x * x + z * z), 2.f * (y * z - x * w),
+		2.f * (x * z - y * w),       2.f * (y * z + x * w),       1.f - 2.f * (x * x + y * y)
+	};
+}
+
+// Scalar paths of multiply and rotate, for constant evaluation and builds
+// without SSE
+namespace detail::quat_scalar {
+
+constexpr quat multiply(const quat &a, const quat &b)
+{
+	return quat(
+		a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+		a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+}
+
+// v + 2w(u x v) + 2u x (u x v), with u as the vector part
+constexpr vec3 rotate(const quat &q, const vec3 &v)
+{
+	const auto u = vec3(q.x, q.y, q.z);
+	const auto t = vec3::cross(u, v) * 2.f;
+	return v + t * q.w + vec3::cross(u, t);
+}
+
+} // namespace detail::quat_scalar
+
+constexpr quat quat_base::multiply(const quat &a, const quat &b)
+{
+#ifdef VECTOR_SSE
+	if (!std::is_constant_evaluated())
+		return vec_simd<quat_base>::multiply(a, b);
+#endif
+
+	return detail::quat_scalar::multiply(a, b);
+}
+
+constexpr quat quat_base::conjugate(const quat &q)
+{
+	return quat(-q.x, -q.y, -q.z, q.w);
+}
+
+constexpr vec3 quat_base::rotate(const quat &q, const vec3 &v)
+{
+#ifdef VECTOR_SSE
+	if (!std::is_constant_evaluated())
+		return vec_simd<quat_base>::rotate(q, v);
+#endif
+
+	return detail::quat_scalar::rotate(q, v);
+}
+
+inline quat quat_base::nlerp(const quat &a, const quat &b, float t)
+{
+	const auto target = quat::dot(a, b) < 0.f ? -b : b;
+	return (a + (target - a) * t).normalized();
+}
+
+inline quat quat_base::slerp(const quat &a, const quat &b, float t)
+{
+	auto cos_theta = quat::dot(a, b);
+	auto target = b;
+
+	if (cos_theta < 0.f) {
+		cos_theta = -cos_theta;
+		target = -b;
+	}
+
+	// sin(theta) loses precision as theta approaches 0, where nlerp is as good
+	if (cos_theta > .9995f)
+		return (a + (target - a) * t).normalized();
+
+	const auto theta = std::acos(cos_theta);
+	const auto sin_theta = std::sin(theta);
+	return a * (std::sin((1.f - t) * theta) / sin_theta) + target * (std::sin(t * theta) / sin_theta);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "util/platform.h"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed capacity ring buffer with one producer thread and one consumer thread
+template<typename T, size_t Capacity> requires (std::has_single_bit(Capacity))
+class spsc_ring {
+	alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> head = 0;
+	alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> tail = 0;
+	alignas(CACHE_LINE_SIZE) T items[Capacity];
+
+public:
+	// Producer only, false if full
+	bool push(const T &item)
+	{
+		const auto index = head.load(std::memory_order_relaxed);
+
+		if (index - tail.load(std::memory_order_acquire) >= Capacity)
+			return false;
+
+		items[index % Capacity] = item;
+		head.store(index + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only, pass each available item to callable until it returns
+	// false, leaving that item in place. Returns the number consumed.
+	size_t consume(auto &&callable)
+	{
+		const auto end = head.load(std::memory_order_acquire);
+		auto index = tail.load(std::memory_order_relaxed);
+		const auto start = index;
+
+		for (; index != end; index++) {
+			if (!callable(items[index % Capacity]))
+				break;
+		}
+
+		tail.store(index, std::memory_order_release);
+		return index - start;
+	}
+
+	// Consumer only, discard everything available
+	void clear()
+	{
+		tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	// Total items pushed, usable as a sequence number by the producer
+	uint32_t pushed() const
+	{
+		return head.load(std::memory_order_relaxed);
+	}
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "util/platform.h"
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Fixed capacity open addressing table mapping object pointers to per-object
+// state. Entries are cache line aligned so threads updating different objects
+// never share a line, and lookups never allocate.
+//
+// Claiming a slot is atomic, so different keys may be inserted, erased and
+// looked up concurrently. A key is only published once its value is
+// constructed. Each key's value must only be accessed by one thread at a time.
+//
+// Erased slots become tombstones, which inserts reuse. Lookups stop at the
+// furthest any key has been placed from its hash, so misses stay short however
+// many objects have come and gone.
+template<typename Value, size_t Capacity>
+	requires (std::has_single_bit(Capacity))
+class state_table {
+	static constexpr uintptr_t EMPTY = 0;
+	static constexpr uintptr_t TOMBSTONE = 1;
+	// Claimed, with the value still being constructed
+	static constexpr uintptr_t BUSY = 2;
+
+	struct alignas(CACHE_LINE_SIZE) entry {
+		std::atomic<uintptr_t> key = EMPTY;
+		// Constructed when the slot is claimed, destroyed when it's erased
+		union { Value value; };
+
+		constexpr entry() {}
+
+		~entry()
+		{
+			if (key.load(std::memory_order_relaxed) > BUSY)
+				std::destroy_at(&value);
+		}
+	};
+
+	entry entries[Capacity];
+	// Furthest any key has been placed along its probe sequence
+	std::atomic<size_t> max_probe = 0;
+
+	static size_t hash(uintptr_t key)
+	{
+		// Fibonacci hashing, ignoring alignment bits
+		constexpr auto shift = sizeof(size_t) * CHAR_BIT - std::countr_zero(Capacity);
+		constexpr auto multiplier = sizeof(size_t) == 8
+			? (size_t)0x9E3779B97F4A7C15ull
+			: (size_t)0x9E3779B9u;
+		return ((size_t)(key >> 4) * multiplier) >> shift;
+	}
+
+	static size_t next(size_t index)
+	{
+		return (index + 1) & (Capacity - 1);
+	}
+
+	// Returns the index of the key's slot, or Capacity if absent
+	size_t find_index(uintptr_t key) const
+	{
+		if (key <= BUSY)
+			return Capacity;
+
+		auto index = hash(key);
+		const auto probes = max_probe.load(std::memory_order_acquire) + 1;
+
+		for (size_t i = 0; i < probes; i++, index = next(index)) {
+			const auto current = entries[index].key.load(std::memory_order_acquire);
+
+			if (current == key)
+				return index;
+
+			if (current == EMPTY)
+				break;
+		}
+
+		return Capacity;
+	}
+
+	void raise_max_probe(size_t probe)
+	{
+		auto current = max_probe.load(std::memory_order_relaxed);
+
+		while (current < probe && !max_probe.compare_exchange_weak(current, probe, std::memory_order_release))
+			;
+	}
+
+public:
+	static constexpr auto capacity = Capacity;
+
+	Value *find(const void *object)
+	{
+		const auto index = find_index((uintptr_t)object);
+		return index != Capacity ? &entries[index].value : nullptr;
+	}
+
+	// Returns nullptr if the table is full
+	Value *find_or_insert(const void *object)
+	{
+		const auto key = (uintptr_t)object;
+
+		if (key <= BUSY)
+			return nullptr;
+
+		if (auto *value = find(object); value != nullptr)
+			return value;
+
+		// Claim the first free slot in the probe sequence
+		auto index = hash(key);
+
+		for (size_t i = 0; i < Capacity; i++, index = next(index)) {
+			auto &slot = entries[index];
+			auto current = slot.key.load(std::memory_order_relaxed);
+
+			while (current == EMPTY || current == TOMBSTONE) {
+				if (slot.key.compare_exchange_weak(
+						current, BUSY,
+						std::memory_order_acquire,
+						std::memory_order_relaxed)) {
+					auto *value = std::construct_at(&slot.value);
+					raise_max_probe(i);
+					slot.key.store(key, std::memory_order_release);
+					return value;
+				}
+			}
+
+			if (current == key)
+				return &slot.value;
+		}
+
+		return nullptr;
+	}
+
+	void erase(const void *object)
+	{
+		const auto index = find_index((uintptr_t)object);
+
+		if (index == Capacity)
+			return;
+
+		auto &slot = entries[index];
+		std::destroy_at(&slot.value);
+		slot.key.store(TOMBSTONE, std::memory_order_release);
+	}
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Stops every other thread in the process while alive, so code they may be
+// running can be rewritten, implemented with SuspendThread on Windows and a
+// signal that parks each thread elsewhere. Threads started meanwhile aren't
+// stopped.
+//
+// Stopped threads may hold the heap lock, so nothing may allocate while a
+// freeze is alive.
+class thread_freeze {
+	// Thread handles on Windows, IDs elsewhere
+	std::vector<uintptr_t> threads;
+	std::vector<uintptr_t> instruction_pointers;
+	bool complete = true;
+
+public:
+	thread_freeze();
+	~thread_freeze();
+
+	thread_freeze(const thread_freeze&) = delete;
+	thread_freeze &operator=(const thread_freeze&) = delete;
+
+	// False if some thread couldn't be stopped or inspected
+	bool is_complete() const { return complete; }
+
+	// Where each stopped thread will resume
+	std::span<const uintptr_t> get_instruction_pointers() const { return instruction_pointers; }
+
+	// True if a stopped thread would resume partway into [address, address+size)
+	bool any_inside(const void *address, size_t size) const
+	{
+		for (const auto ip : instruction_pointers) {
+			if (ip > (uintptr_t)address && ip < (uintptr_t)address + size)
+				return true;
+		}
+
+		return false;
+	}
+};
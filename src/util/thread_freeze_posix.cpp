@@ -0,0 +1,175 @@
+#include "util/thread_freeze.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <dirent.h>
+#include <linux/futex.h>
+#include <mutex>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// Threads are parked in a signal handler until the freeze ends, each
+// reporting where it will resume. One freeze runs at a time, and each signal
+// carries its freeze's generation so a late arrival from a freeze that timed
+// out isn't counted in the next.
+static constexpr size_t MAX_THREADS = 1024;
+static constexpr auto STOP_TIMEOUT = std::chrono::milliseconds(100);
+
+static std::mutex freeze_mutex;
+static std::atomic<uint32_t> generation;
+static std::atomic<uint32_t> claimed;
+static std::atomic<uint32_t> arrived;
+// Last generation released
+static std::atomic<uint32_t> released;
+static uintptr_t parked_ips[MAX_THREADS];
+
+// Parked and waiting threads sleep rather than spin, as a spinning thread can
+// hold the CPU others need to reach the handler
+static void futex_wait(std::atomic<uint32_t> &word, uint32_t value, const timespec *timeout = nullptr)
+{
+	syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAIT_PRIVATE, value, timeout, nullptr, 0);
+}
+
+static void futex_wake(std::atomic<uint32_t> &word)
+{
+	syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+// Wait for word to reach count, false at the deadline
+static bool wait_for_count(std::atomic<uint32_t> &word, size_t count)
+{
+	const auto deadline = std::chrono::steady_clock::now() + STOP_TIMEOUT;
+
+	while (true) {
+		const auto value = word.load(std::memory_order_acquire);
+
+		if (value >= count)
+			return true;
+
+		const auto remaining = deadline - std::chrono::steady_clock::now();
+
+		if (remaining <= std::chrono::steady_clock::duration::zero())
+			return false;
+
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+		const auto timeout = timespec { .tv_sec = (time_t)(ns / 1'000'000'000), .tv_nsec = (long)(ns % 1'000'000'000) };
+		futex_wait(word, value, &timeout);
+	}
+}
+
+static uintptr_t get_ip(const void *context)
+{
+	const auto &mcontext = ((const ucontext_t*)context)->uc_mcontext;
+#ifdef __x86_64__
+	return (uintptr_t)mcontext.gregs[REG_RIP];
+#else
+	return (uintptr_t)mcontext.gregs[REG_EIP];
+#endif
+}
+
+static void on_freeze_signal(int, siginfo_t *info, void *context)
+{
+	const auto signalled = (uint32_t)info->si_value.sival_int;
+
+	if (signalled == generation.load(std::memory_order_acquire)) {
+		const auto slot = claimed.fetch_add(1, std::memory_order_relaxed);
+
+		if (slot < MAX_THREADS)
+			parked_ips[slot] = get_ip(context);
+
+		arrived.fetch_add(1, std::memory_order_release);
+		futex_wake(arrived);
+	}
+
+	// Wrapping compare, as generations count up forever
+	while (true) {
+		const auto last = released.load(std::memory_order_acquire);
+
+		if ((int32_t)(last - signalled) >= 0)
+			break;
+
+		futex_wait(released, last);
+	}
+}
+
+// sigqueue for one thread
+static bool send_freeze_signal(pid_t process, pid_t thread, int signal, uint32_t value)
+{
+	auto info = siginfo_t {};
+	info.si_signo = signal;
+	info.si_code = SI_QUEUE;
+	info.si_pid = process;
+	info.si_uid = getuid();
+	info.si_value.sival_int = (int)value;
+	return syscall(SYS_rt_tgsigqueueinfo, process, thread, signal, &info) == 0;
+}
+
+static int freeze_signal()
+{
+	static const auto signal = [] {
+		struct sigaction action = {};
+		action.sa_sigaction = on_freeze_signal;
+		action.sa_flags = SA_SIGINFO | SA_RESTART;
+		sigfillset(&action.sa_mask);
+		sigaction(SIGRTMIN, &action, nullptr);
+		return SIGRTMIN;
+	}();
+
+	return signal;
+}
+
+thread_freeze::thread_freeze()
+{
+	const auto signal = freeze_signal();
+	const auto process = getpid();
+	const auto self = (pid_t)syscall(SYS_gettid);
+	std::vector<pid_t> ids;
+
+	if (auto *dir = opendir("/proc/self/task"); dir != nullptr) {
+		while (const auto *entry = readdir(dir)) {
+			const auto id = (pid_t)atoi(entry->d_name);
+
+			if (id > 0 && id != self)
+				ids.push_back(id);
+		}
+
+		closedir(dir);
+	} else {
+		complete = false;
+	}
+
+	// Allocate up front, as stopped threads may hold the heap lock
+	threads.reserve(ids.size());
+	instruction_pointers.reserve(ids.size());
+
+	freeze_mutex.lock();
+	claimed = 0;
+	arrived = 0;
+	const auto current = generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+	for (const auto id : ids) {
+		// Fails if the thread exited since the listing
+		if (send_freeze_signal(process, id, signal, current))
+			threads.push_back((uintptr_t)id);
+	}
+
+	// Times out on threads blocking the signal, or exiting with it pending
+	if (!wait_for_count(arrived, threads.size()))
+		complete = false;
+
+	const auto count = std::min((size_t)arrived.load(std::memory_order_acquire), MAX_THREADS);
+	instruction_pointers.assign(parked_ips, parked_ips + count);
+	complete = complete && count == threads.size();
+}
+
+thread_freeze::~thread_freeze()
+{
+	// Threads still on their way out of the handler are signalled again by
+	// the next freeze, and can't leave the handler without stopping for it
+	released.store(generation.load(std::memory_order_relaxed), std::memory_order_release);
+	futex_wake(released);
+	freeze_mutex.unlock();
+}
@@ -0,0 +1,76 @@
+#include "util/thread_freeze.h"
+#include <Windows.h>
+#include <TlHelp32.h>
+
+thread_freeze::thread_freeze()
+{
+	const auto snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+
+	if (snapshot == INVALID_HANDLE_VALUE) {
+		complete = false;
+		return;
+	}
+
+	const auto process = GetCurrentProcessId();
+	const auto self = GetCurrentThreadId();
+	std::vector<DWORD> ids;
+	auto entry = THREADENTRY32 { .dwSize = sizeof(THREADENTRY32) };
+
+	for (auto more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+		if (entry.th32OwnerProcessID == process && entry.th32ThreadID != self)
+			ids.push_back(entry.th32ThreadID);
+	}
+
+	CloseHandle(snapshot);
+
+	// Allocate up front, as suspended threads may hold the heap lock
+	threads.reserve(ids.size());
+	instruction_pointers.reserve(ids.size());
+
+	for (const auto id : ids) {
+		const auto thread = OpenThread(
+			THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_LIMITED_INFORMATION, FALSE, id);
+
+		if (thread == nullptr) {
+			// Exited since the snapshot, otherwise left running
+			if (GetLastError() != ERROR_INVALID_PARAMETER)
+				complete = false;
+
+			continue;
+		}
+
+		if (SuspendThread(thread) == (DWORD)-1) {
+			auto exit_code = DWORD();
+
+			if (!GetExitCodeThread(thread, &exit_code) || exit_code == STILL_ACTIVE)
+				complete = false;
+
+			CloseHandle(thread);
+			continue;
+		}
+
+		threads.push_back((uintptr_t)thread);
+
+		// Waits for the suspension to take effect
+		auto context = CONTEXT { .ContextFlags = CONTEXT_CONTROL };
+
+		if (!GetThreadContext(thread, &context)) {
+			complete = false;
+			continue;
+		}
+
+#ifdef _WIN64
+		instruction_pointers.push_back((uintptr_t)context.Rip);
+#else
+		instruction_pointers.push_back((uintptr_t)context.Eip);
+#endif
+	}
+}
+
+thread_freeze::~thread_freeze()
+{
+	for (const auto thread : threads) {
+		ResumeThread((HANDLE)thread);
+		CloseHandle((HANDLE)thread);
+	}
+}
@@ -8,9 +8,21 @@
 #include <tuple>
 #include <type_traits>
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define VECTOR_SSE
+#endif
+
 template<typename Base>
 class vec_impl;
 
+// Specialized for bases with an SSE implementation, which vec_impl uses
+// outside constant evaluation
+template<typename Base>
+struct vec_simd {
+	static constexpr bool enabled = false;
+};
+
 template<typename T>
 concept VecImpl = requires(T t) { []<typename U>(vec_impl<U>){}(t); };
 
@@ -24,23 +36,40 @@ class vec_impl : public Base {
 
 	static constexpr auto elem_count = sizeof_tuple<elem_tuple>;
 
+	using simd = vec_simd<Base>;
+
 public:
 	using Base::elems;
 
 	static constexpr elem_type dot(const vec_impl &a, const vec_impl &b)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::dot(a, b);
+		}
+
 		return sum_tuple(a.foreach(operators::mul, b.elems()));
 	}
 
 	// Component-wise min of two vectors
 	static constexpr vec_impl min(const vec_impl &a, const vec_impl &b)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::min(a, b);
+		}
+
 		return a.map(operators::min, b.elems());
 	}
 
 	// Component-wise max of two vectors
 	static constexpr vec_impl max(const vec_impl &a, const vec_impl &b)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::max(a, b);
+		}
+
 		return a.map(operators::max, b.elems());
 	}
 
@@ -50,14 +79,22 @@ public:
 		return std::make_pair(min(a, b), max(a, b));
 	}
 
-	// Component-wise lerp of two vectors
+	// Component-wise lerp of two vectors. Always scalar, as std::lerp's exact
+	// results are up to the library.
 	static constexpr vec_impl lerp(const vec_impl &a, const vec_impl &b, auto t)
 	{
-		return a.map(::bind_back(std::lerp, t), b.elems());
+		return a.map([t](auto x, auto y) { return std::lerp(x, y, t); }, b.elems());
 	}
 
 	constexpr vec_impl()
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated()) {
+				simd::zero(*this);
+				return;
+			}
+		}
+
 		foreach(::bind_back(operators::eq, elem_type{}));
 	}
 
@@ -120,6 +157,11 @@ public:
 
 	constexpr auto normalized() const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::normalized(*this);
+		}
+
 		const auto len = length();
 		if (len != 0)
 			return *this * (decltype(len) { 1 } / len);
@@ -137,88 +179,168 @@ public:
 	// Component-wise absolute value
 	constexpr vec_impl abs() const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::abs(*this);
+		}
+
 		return map(operators::abs);
 	}
 
 	constexpr vec_impl &operator=(const vec_impl &other)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::assign(*this, other);
+		}
+
 		elems() = other.elems();
 		return *this;
 	}
 
 	constexpr vec_impl &operator+=(const vec_impl &other)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::assign(*this, simd::add(*this, other));
+		}
+
 		foreach(operators::add_eq, other.elems());
 		return *this;
 	}
 
 	constexpr vec_impl operator+(const vec_impl &other) const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::add(*this, other);
+		}
+
 		return map(operators::add, other.elems());
 	}
 
 	constexpr vec_impl &operator-=(const vec_impl &other)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::assign(*this, simd::sub(*this, other));
+		}
+
 		foreach(operators::sub_eq, other.elems());
 		return *this;
 	}
 
 	constexpr vec_impl operator-(const vec_impl &other) const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::sub(*this, other);
+		}
+
 		return map(operators::sub, other.elems());
 	}
 
 	constexpr vec_impl &operator*=(const vec_impl &other)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::assign(*this, simd::mul(*this, other));
+		}
+
 		foreach(operators::mul_eq, other.elems());
 		return *this;
 	}
 
 	constexpr vec_impl &operator*=(elem_type value)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::assign(*this, simd::mul(*this, value));
+		}
+
 		foreach(::bind_back(operators::mul_eq, value));
 		return *this;
 	}
 
 	constexpr vec_impl operator*(const vec_impl &other) const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::mul(*this, other);
+		}
+
 		return map(operators::mul, other.elems());
 	}
 
 	constexpr vec_impl operator*(elem_type value) const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::mul(*this, value);
+		}
+
 		return map(::bind_back(operators::mul, value));
 	}
 
 	constexpr vec_impl &operator/=(const vec_impl &other)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::assign(*this, simd::div(*this, other));
+		}
+
 		foreach(operators::div_eq, other.elems());
 		return *this;
 	}
 
 	constexpr vec_impl &operator/=(elem_type value)
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::assign(*this, simd::div(*this, value));
+		}
+
 		foreach(::bind_back(operators::div_eq, value));
 		return *this;
 	}
 
 	constexpr vec_impl operator/(const vec_impl &other) const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::div(*this, other);
+		}
+
 		return map(operators::div, other.elems());
 	}
 
 	constexpr vec_impl operator/(elem_type value) const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::div(*this, value);
+		}
+
 		return map(::bind_back(operators::div, value));
 	}
 
 	constexpr bool operator==(const vec_impl &other) const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::equal(*this, other);
+		}
+
 		return elems() == other.elems();
 	}
 
 	constexpr vec_impl operator-() const
 	{
+		if constexpr (simd::enabled) {
+			if (!std::is_constant_evaluated())
+				return simd::neg(*this);
+		}
+
 		return map(operators::neg);
 	}
 };
@@ -258,6 +380,101 @@ struct vec4_base {
 
 using vec4 = vec_impl<vec4_base<float>>;
 
+#ifdef VECTOR_SSE
+// Float vec4 in one __m128. Every lane does what the scalar path does to that
+// element and dot sums in the same order, so results match it bit for bit, up
+// to which NaN payload wins.
+//
+// vec3 stays scalar. Loading and storing three floats costs more than the
+// lanes save, and compilers already vectorize scalar vec3 code well
+// (bench/vector_bench).
+template<typename Base>
+struct vec_sse {
+	static constexpr bool enabled = true;
+
+	using vec = vec_impl<Base>;
+
+	static __m128 load(const vec &v)            { return _mm_loadu_ps(&v.x); }
+	static vec &store(vec &v, __m128 value)     { _mm_storeu_ps(&v.x, value); return v; }
+
+	static vec make(__m128 value)
+	{
+		vec result;
+		return store(result, value);
+	}
+
+	static __m128 sign_mask()
+	{
+		return _mm_set1_ps(-0.f);
+	}
+
+	// Sum of all lanes into the low lane, as x + (y + (z + w)) like sum_tuple
+	static __m128 sum(__m128 value)
+	{
+		const auto y = _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1));
+		const auto z = _mm_movehl_ps(value, value);
+		const auto w = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+		return _mm_add_ss(value, _mm_add_ss(y, _mm_add_ss(z, w)));
+	}
+
+	static float dot(const vec &a, const vec &b)
+	{
+		return _mm_cvtss_f32(sum(_mm_mul_ps(load(a), load(b))));
+	}
+
+	// std::min and std::max return their first argument unless the second
+	// compares less or greater, while minps and maxps return their second
+	static vec min(const vec &a, const vec &b)
+	{
+		return make(_mm_min_ps(load(b), load(a)));
+	}
+
+	static vec max(const vec &a, const vec &b)
+	{
+		return make(_mm_max_ps(load(b), load(a)));
+	}
+
+	static vec normalized(const vec &v)
+	{
+		const auto value = load(v);
+		const auto len = _mm_sqrt_ss(sum(_mm_mul_ps(value, value)));
+
+		if (_mm_cvtss_f32(len) == 0.f)
+			return v;
+
+		const auto scale = _mm_div_ss(_mm_set_ss(1.f), len);
+		return make(_mm_mul_ps(value, _mm_shuffle_ps(scale, scale, 0)));
+	}
+
+	static vec abs(const vec &v)       { return make(_mm_andnot_ps(sign_mask(), load(v))); }
+	static vec neg(const vec &v)       { return make(_mm_xor_ps(sign_mask(), load(v))); }
+	static void zero(vec &v)           { store(v, _mm_setzero_ps()); }
+
+	// A plain copy, which compilers keep in registers better than a round trip
+	// through an __m128
+	static vec &assign(vec &v, const vec &other)
+	{
+		static_cast<Base&>(v) = other;
+		return v;
+	}
+
+	static vec add(const vec &a, const vec &b)   { return make(_mm_add_ps(load(a), load(b))); }
+	static vec sub(const vec &a, const vec &b)   { return make(_mm_sub_ps(load(a), load(b))); }
+	static vec mul(const vec &a, const vec &b)   { return make(_mm_mul_ps(load(a), load(b))); }
+	static vec mul(const vec &a, float b)        { return make(_mm_mul_ps(load(a), _mm_set1_ps(b))); }
+	static vec div(const vec &a, const vec &b)   { return make(_mm_div_ps(load(a), load(b))); }
+	static vec div(const vec &a, float b)        { return make(_mm_div_ps(load(a), _mm_set1_ps(b))); }
+
+	static bool equal(const vec &a, const vec &b)
+	{
+		return _mm_movemask_ps(_mm_cmpeq_ps(load(a), load(b))) == 0xF;
+	}
+};
+
+template<>
+struct vec_simd<vec4_base<float>> : vec_sse<vec4_base<float>> {};
+#endif
+
 template<typename T, T MaxValue>
 struct color_rgb_base {
 	static constexpr auto hex(uint32_t value)
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Page level memory management used by the hook and patch engine, implemented
+// with VirtualAlloc/VirtualProtect on Windows and mmap/mprotect elsewhere.
+enum class page_access {
+	none,
+	read,
+	read_write,
+	read_execute,
+	read_write_execute
+};
+
+// Reserve an inaccessible range at address, or anywhere if address is
+// nullptr. nullptr if the range isn't free.
+void *vm_reserve(void *address, size_t size);
+
+// Back part of a reserved range with memory
+bool vm_commit(void *address, size_t size, page_access access);
+
+// Rounds out to whole pages. old receives the previous access of the first
+// page if not nullptr.
+bool vm_protect(void *address, size_t size, page_access access, page_access *old = nullptr);
+
+void vm_flush_icache(const void *address, size_t size);
+
+struct vm_range {
+	uintptr_t min;
+	uintptr_t max;
+};
+
+// Addresses available to user mode allocations
+vm_range vm_address_range();
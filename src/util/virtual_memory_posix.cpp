@@ -0,0 +1,137 @@
+#include "util/virtual_memory.h"
+#include "util/platform.h"
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+#include <sys/mman.h>
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+static int to_prot(page_access access)
+{
+	switch (access) {
+	case page_access::read:               return PROT_READ;
+	case page_access::read_write:         return PROT_READ | PROT_WRITE;
+	case page_access::read_execute:       return PROT_READ | PROT_EXEC;
+	case page_access::read_write_execute: return PROT_READ | PROT_WRITE | PROT_EXEC;
+	default:                              return PROT_NONE;
+	}
+}
+
+// Access last set on each page through vm_commit or vm_protect. mprotect
+// doesn't report the previous protection, so pages not set here are looked up
+// in the process's mappings, which takes a read of /proc/self/maps. Pages
+// changed behind vm_protect's back read stale.
+static std::mutex access_mutex;
+static std::unordered_map<uintptr_t, page_access> known_access;
+
+static page_access read_mapped_access(uintptr_t address)
+{
+	auto *maps = fopen("/proc/self/maps", "r");
+
+	if (maps == nullptr)
+		return page_access::read_execute;
+
+	auto result = page_access::read_execute;
+	unsigned long start, end;
+	char perms[5];
+
+	while (fscanf(maps, "%lx-%lx %4s%*[^\n]", &start, &end, perms) == 3) {
+		if (address < start || address >= end)
+			continue;
+
+		const auto read = perms[0] == 'r';
+		const auto write = perms[1] == 'w';
+		const auto execute = perms[2] == 'x';
+
+		if (!read)
+			result = page_access::none;
+		else if (execute)
+			result = write ? page_access::read_write_execute : page_access::read_execute;
+		else
+			result = write ? page_access::read_write : page_access::read;
+
+		break;
+	}
+
+	fclose(maps);
+	return result;
+}
+
+static page_access query_access(uintptr_t page)
+{
+	const auto lock = std::scoped_lock(access_mutex);
+
+	if (const auto known = known_access.find(page); known != known_access.end())
+		return known->second;
+
+	return read_mapped_access(page);
+}
+
+static void set_access(uintptr_t start, uintptr_t end, page_access access)
+{
+	const auto lock = std::scoped_lock(access_mutex);
+
+	for (auto page = start; page < end; page += PAGE_SIZE)
+		known_access[page] = access;
+}
+
+static bool protect(uintptr_t start, uintptr_t end, page_access access)
+{
+	if (mprotect((void*)start, end - start, to_prot(access)) != 0)
+		return false;
+
+	set_access(start, end, access);
+	return true;
+}
+
+void *vm_reserve(void *address, size_t size)
+{
+	const auto flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+	auto *result = mmap(address, size, PROT_NONE, address != nullptr ? flags | MAP_FIXED_NOREPLACE : flags, -1, 0);
+
+	if (result == MAP_FAILED)
+		return nullptr;
+
+	// Kernels without MAP_FIXED_NOREPLACE treat the address as a hint
+	if (address != nullptr && result != address) {
+		munmap(result, size);
+		return nullptr;
+	}
+
+	set_access((uintptr_t)result, (uintptr_t)result + size, page_access::none);
+	return result;
+}
+
+bool vm_commit(void *address, size_t size, page_access access)
+{
+	return protect((uintptr_t)address, (uintptr_t)address + size, access);
+}
+
+bool vm_protect(void *address, size_t size, page_access access, page_access *old)
+{
+	const auto start = (uintptr_t)address & ~(PAGE_SIZE - 1);
+	const auto end = ((uintptr_t)address + size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+	if (old != nullptr)
+		*old = query_access(start);
+
+	return protect(start, end, access);
+}
+
+void vm_flush_icache(const void *address, size_t size)
+{
+	// No-op on x86, kept for targets with incoherent instruction caches
+	__builtin___clear_cache((char*)address, (char*)address + size);
+}
+
+vm_range vm_address_range()
+{
+	// Below the lowest mmap_min_addr and above the top of the user half
+	if constexpr (sizeof(void*) == 8)
+		return {.min = 0x10000, .max = 0x7FFF'FFFF'FFFF};
+	else
+		return {.min = 0x10000, .max = 0xBFFF'FFFF};
+}
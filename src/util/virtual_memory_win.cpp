@@ -0,0 +1,75 @@
+#include "util/virtual_memory.h"
+#include <Windows.h>
+
+static DWORD to_protect(page_access access)
+{
+	switch (access) {
+	case page_access::read:               return PAGE_READONLY;
+	case page_access::read_write:         return PAGE_READWRITE;
+	case page_access::read_execute:       return PAGE_EXECUTE_READ;
+	case page_access::read_write_execute: return PAGE_EXECUTE_READWRITE;
+	default:                              return PAGE_NOACCESS;
+	}
+}
+
+static page_access from_protect(DWORD protect)
+{
+	switch (protect & 0xFF) {
+	case PAGE_READONLY:          return page_access::read;
+	case PAGE_READWRITE:
+	case PAGE_WRITECOPY:         return page_access::read_write;
+	case PAGE_EXECUTE:
+	case PAGE_EXECUTE_READ:      return page_access::read_execute;
+	case PAGE_EXECUTE_READWRITE:
+	case PAGE_EXECUTE_WRITECOPY: return page_access::read_write_execute;
+	default:                     return page_access::none;
+	}
+}
+
+void *vm_reserve(void *address, size_t size)
+{
+	if (address != nullptr) {
+		MEMORY_BASIC_INFORMATION info;
+
+		if (VirtualQuery(address, &info, sizeof(info)) == 0 || info.State != MEM_FREE)
+			return nullptr;
+
+		if ((uintptr_t)info.BaseAddress + info.RegionSize < (uintptr_t)address + size)
+			return nullptr;
+	}
+
+	return VirtualAlloc(address, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool vm_commit(void *address, size_t size, page_access access)
+{
+	return VirtualAlloc(address, size, MEM_COMMIT, to_protect(access)) != nullptr;
+}
+
+bool vm_protect(void *address, size_t size, page_access access, page_access *old)
+{
+	DWORD old_protect;
+
+	if (!VirtualProtect(address, size, to_protect(access), &old_protect))
+		return false;
+
+	if (old != nullptr)
+		*old = from_protect(old_protect);
+
+	return true;
+}
+
+void vm_flush_icache(const void *address, size_t size)
+{
+	FlushInstructionCache(GetCurrentProcess(), address, size);
+}
+
+vm_range vm_address_range()
+{
+	SYSTEM_INFO system;
+	GetSystemInfo(&system);
+	return {
+		.min = (uintptr_t)system.lpMinimumApplicationAddress,
+		.max = (uintptr_t)system.lpMaximumApplicationAddress
+	};
+}
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Table driven IA-32 and x86-64 instruction length decoder. Finds instruction
+// boundaries and the fields a relocator rewrites without disassembling, and
+// can run in constant expressions.
+
+enum class x86_mode {
+	ia32,
+	x64,
+	native = sizeof(void*) == 8 ? x64 : ia32
+};
+
+struct x86_instruction {
+	// 0 if the bytes don't decode
+	uint8_t length;
+	// 0 one byte, 1 0F, 2 0F 38, 3 0F 3A, or the XOP map 8-10
+	uint8_t map;
+	uint8_t opcode;
+	uint8_t modrm;
+	// Field offsets from the start of the instruction, 0 if absent. Prefixes
+	// come before the opcode.
+	uint8_t opcode_offset;
+	uint8_t modrm_offset;
+	uint8_t disp_offset;
+	uint8_t disp_size;
+	uint8_t imm_offset;
+	uint8_t imm_size;
+	// The immediate is a branch displacement from the end of the instruction
+	bool relative;
+	// The displacement is relative to the end of the instruction
+	bool rip_relative;
+
+	constexpr uint8_t reg() const { return (modrm >> 3) & 7; }
+};
+
+namespace detail::x86 {
+
+constexpr size_t MAX_LENGTH = 15;
+
+enum : uint16_t {
+	MODRM     = 1 << 0,
+	// ModRM names registers whatever its mod, for control register moves
+	REGISTER  = 1 << 1,
+	IMM8      = 1 << 2,
+	IMM16     = 1 << 3,
+	IMM32     = 1 << 4,
+	// 16 or 32 bits by operand size
+	IMMZ      = 1 << 5,
+	// IMMZ, or 64 bits with REX.W
+	IMMV      = 1 << 6,
+	// Address sized absolute offset
+	MOFFS     = 1 << 7,
+	REL       = 1 << 8,
+	// F6 and F7, which take an immediate for /0 and /1 only
+	GROUP3    = 1 << 9,
+	PREFIX    = 1 << 10,
+	INVALID   = 1 << 11,
+	INVALID64 = 1 << 12
+};
+
+using table = std::array<uint16_t, 256>;
+
+constexpr void set(table &t, unsigned first, unsigned last, uint16_t flags)
+{
+	for (auto i = first; i <= last; i++)
+		t[i] |= flags;
+}
+
+constexpr table make_one_byte_table()
+{
+	auto t = table {};
+
+	// ALU ops: r/m forms, then AL/eAX immediates
+	for (unsigned base = 0x00; base <= 0x38; base += 8) {
+		set(t, base, base + 3, MODRM);
+		t[base + 4] |= IMM8;
+		t[base + 5] |= IMMZ;
+	}
+
+	// push/pop segment, BCD adjust
+	for (const auto op : {0x06, 0x07, 0x0E, 0x16, 0x17, 0x1E, 0x1F, 0x27, 0x2F, 0x37, 0x3F})
+		t[op] |= INVALID64;
+
+	// Segment, operand size, address size, lock and rep
+	for (const auto op : {0x26, 0x2E, 0x36, 0x3E, 0x64, 0x65, 0x66, 0x67, 0xF0, 0xF2, 0xF3})
+		t[op] |= PREFIX;
+
+	set(t, 0x60, 0x61, INVALID64);
+	set(t, 0x62, 0x63, MODRM);
+	t[0x68] |= IMMZ;
+	t[0x69] |= MODRM | IMMZ;
+	t[0x6A] |= IMM8;
+	t[0x6B] |= MODRM | IMM8;
+	set(t, 0x70, 0x7F, IMM8 | REL);
+	set(t, 0x80, 0x83, MODRM | IMM8);
+	t[0x81] = MODRM | IMMZ;
+	t[0x82] |= INVALID64;
+	set(t, 0x84, 0x8F, MODRM);
+	// call far ptr16:z
+	t[0x9A] |= IMMZ | IMM16 | INVALID64;
+	set(t, 0xA0, 0xA3, MOFFS);
+	t[0xA8] |= IMM8;
+	t[0xA9] |= IMMZ;
+	set(t, 0xB0, 0xB7, IMM8);
+	set(t, 0xB8, 0xBF, IMMV);
+	set(t, 0xC0, 0xC1, MODRM | IMM8);
+	t[0xC2] |= IMM16;
+	set(t, 0xC4, 0xC5, MODRM);
+	t[0xC6] |= MODRM | IMM8;
+	t[0xC7] |= MODRM | IMMZ;
+	// enter imm16, imm8
+	t[0xC8] |= IMM16 | IMM8;
+	t[0xCA] |= IMM16;
+	t[0xCD] |= IMM8;
+	set(t, 0xD0, 0xD3, MODRM);
+	set(t, 0xD4, 0xD5, IMM8 | INVALID64);
+	t[0xD6] |= INVALID64;
+	// x87
+	set(t, 0xD8, 0xDF, MODRM);
+	// loop, jcxz
+	set(t, 0xE0, 0xE3, IMM8 | REL);
+	set(t, 0xE4, 0xE7, IMM8);
+	set(t, 0xE8, 0xE9, IMMZ | REL);
+	// jmp far ptr16:z
+	t[0xEA] |= IMMZ | IMM16 | INVALID64;
+	t[0xEB] |= IMM8 | REL;
+	set(t, 0xF6, 0xF7, MODRM | GROUP3);
+	set(t, 0xFE, 0xFF, MODRM);
+	return t;
+}
+
+// 0F xx
+constexpr table make_two_byte_table()
+{
+	auto t = table {};
+	set(t, 0x00, 0x03, MODRM);
+	t[0x0D] |= MODRM;
+	// 3DNow! suffix opcode
+	t[0x0F] |= MODRM | IMM8;
+	set(t, 0x10, 0x2F, MODRM);
+	set(t, 0x20, 0x23, REGISTER);
+	set(t, 0x40, 0x6F, MODRM);
+	set(t, 0x70, 0x73, MODRM | IMM8);
+	set(t, 0x74, 0x76, MODRM);
+	set(t, 0x78, 0x79, MODRM);
+	set(t, 0x7C, 0x7F, MODRM);
+	set(t, 0x80, 0x8F, IMMZ | REL);
+	set(t, 0x90, 0x9F, MODRM);
+	t[0xA3] |= MODRM;
+	t[0xA4] |= MODRM | IMM8;
+	t[0xA5] |= MODRM;
+	set(t, 0xAB, 0xAF, MODRM);
+	t[0xAC] |= IMM8;
+	set(t, 0xB0, 0xBF, MODRM);
+	t[0xBA] |= IMM8;
+	set(t, 0xC0, 0xC7, MODRM);
+	t[0xC2] |= IMM8;
+	set(t, 0xC4, 0xC6, IMM8);
+	set(t, 0xD0, 0xFF, MODRM);
+
+	for (const auto op : {0x04, 0x0A, 0x0C, 0x24, 0x25, 0x26, 0x27, 0x36, 0x39, 0x7A, 0x7B, 0xA6, 0xA7})
+		t[op] = INVALID;
+
+	set(t, 0x3B, 0x3F, INVALID);
+	return t;
+}
+
+// 0F 38 xx
+constexpr table make_three_byte_38_table()
+{
+	auto t = table {};
+	set(t, 0x00, 0xFF, MODRM);
+	return t;
+}
+
+// 0F 3A xx
+constexpr table make_three_byte_3a_table()
+{
+	auto t = table {};
+	set(t, 0x00, 0xFF, MODRM | IMM8);
+	return t;
+}
+
+constexpr table TABLES[] = {
+	make_one_byte_table(),
+	make_two_byte_table(),
+	make_three_byte_38_table(),
+	make_three_byte_3a_table()
+};
+
+} // namespace detail::x86
+
+constexpr x86_instruction decode_x86(const uint8_t *code, x86_mode mode = x86_mode::native)
+{
+	using namespace detail::x86;
+
+	const auto x64 = mode == x86_mode::x64;
+	auto insn = x86_instruction {};
+	auto operand16 = false;
+	auto address_override = false;
+	auto rex_w = false;
+	size_t i = 0;
+
+	while (TABLES[0][code[i]] & PREFIX) {
+		operand16 |= code[i] == 0x66;
+		address_override |= code[i] == 0x67;
+
+		if (++i == MAX_LENGTH)
+			return {};
+	}
+
+	// REX must directly precede the opcode
+	if (x64 && (code[i] & 0xF0) == 0x40) {
+		rex_w = (code[i] & 0x08) != 0;
+		i++;
+	}
+
+	uint16_t flags;
+
+	// VEX and EVEX reuse LES, LDS and BOUND encodings that can't take a
+	// register operand outside of x86-64
+	if ((code[i] == 0xC4 || code[i] == 0xC5 || code[i] == 0x62) && (x64 || (code[i + 1] & 0xC0) == 0xC0)) {
+		switch (code[i]) {
+		case 0xC5:
+			insn.map = 1;
+			i += 2;
+			break;
+		case 0xC4:
+			insn.map = code[i + 1] & 0x1F;
+			rex_w = (code[i + 2] & 0x80) != 0;
+			i += 3;
+			break;
+		default:
+			insn.map = code[i + 1] & 0x07;
+			rex_w = (code[i + 2] & 0x80) != 0;
+			i += 4;
+			break;
+		}
+
+		if (insn.map < 1 || insn.map > 3)
+			return {};
+
+		insn.opcode = code[i];
+		// Everything has a ModRM but vzeroupper and vzeroall
+		flags = insn.map == 1 && insn.opcode == 0x77 ? 0 : MODRM | (TABLES[insn.map][insn.opcode] & IMM8);
+	} else if (code[i] == 0x8F && (code[i + 1] & 0x1F) >= 8) {
+		// XOP, which is pop r/m with a nonzero reg field
+		insn.map = code[i + 1] & 0x1F;
+
+		if (insn.map > 10)
+			return {};
+
+		i += 3;
+		insn.opcode = code[i];
+		flags = MODRM | (insn.map == 8 ? IMM8 : 0) | (insn.map == 10 ? IMM32 : 0);
+	} else {
+		if (code[i] == 0x0F) {
+			insn.map = 1;
+
+			if (code[i + 1] == 0x38 || code[i + 1] == 0x3A) {
+				insn.map = code[i + 1] == 0x38 ? 2 : 3;
+				i++;
+			}
+
+			i++;
+		}
+
+		insn.opcode = code[i];
+		flags = TABLES[insn.map][insn.opcode];
+	}
+
+	if ((flags & INVALID) || (x64 && (flags & INVALID64)))
+		return {};
+
+	insn.opcode_offset = (uint8_t)i++;
+
+	if (flags & MODRM) {
+		insn.modrm_offset = (uint8_t)i;
+		insn.modrm = code[i++];
+
+		const auto mod = insn.modrm >> 6;
+		const auto rm = insn.modrm & 7;
+		size_t disp = 0;
+
+		if (mod == 3 || (flags & REGISTER)) {
+			// Register operand
+		} else if (!x64 && address_override) {
+			// 16 bit addressing has no SIB
+			if (mod == 1)
+				disp = 1;
+			else if (mod == 2 || rm == 6)
+				disp = 2;
+		} else {
+			if (rm == 4) {
+				// SIB with no base
+				if (mod == 0 && (code[i] & 7) == 5)
+					disp = 4;
+
+				i++;
+			} else if (mod == 0 && rm == 5) {
+				disp = 4;
+				insn.rip_relative = x64;
+			}
+
+			if (mod == 1)
+				disp = 1;
+			else if (mod == 2)
+				disp = 4;
+		}
+
+		if (disp != 0) {
+			insn.disp_offset = (uint8_t)i;
+			insn.disp_size = (uint8_t)disp;
+			i += disp;
+		}
+	}
+
+	// Near branches ignore the operand size prefix in x86-64
+	const auto immz = operand16 && !rex_w && !(x64 && (flags & REL)) ? 2 : 4;
+	size_t imm = 0;
+
+	if (flags & IMM8)
+		imm += 1;
+	if (flags & IMM16)
+		imm += 2;
+	if (flags & IMM32)
+		imm += 4;
+	if (flags & IMMZ)
+		imm += immz;
+	if (flags & IMMV)
+		imm += rex_w ? 8 : immz;
+	if (flags & MOFFS)
+		imm += x64 ? (address_override ? 4 : 8) : (address_override ? 2 : 4);
+	if ((flags & GROUP3) && insn.reg() < 2)
+		imm += insn.opcode == 0xF6 ? 1 : immz;
+
+	if (imm != 0) {
+		insn.imm_offset = (uint8_t)i;
+		insn.imm_size = (uint8_t)imm;
+		i += imm;
+	}
+
+	if (i > MAX_LENGTH)
+		return {};
+
+	insn.relative = (flags & REL) != 0;
+	insn.length = (uint8_t)i;
+	return insn;
+}
@@ -0,0 +1,80 @@
+// fast_math against the exact functions, including inputs outside rsqrt's
+// range
+#include "test.h"
+#include "util/fast_math.h"
+#include "util/vector.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+namespace {
+
+float RelativeError(float actual, float expected)
+{
+	return std::abs(actual - expected) / std::abs(expected);
+}
+
+void TestRsqrt()
+{
+	auto rng = std::mt19937(1);
+	auto maxError = 0.f;
+
+	// Every exponent with random mantissas
+	for (auto exponent = -126; exponent <= 127; exponent++) {
+		for (auto i = 0; i < 64; i++) {
+			const auto x = std::ldexp(1.f + (float)(rng() >> 9) * 0x1p-23f, exponent);
+			maxError = std::max(maxError, RelativeError(fast_math::rsqrt(x), 1.f / std::sqrt(x)));
+		}
+	}
+
+	CHECK(maxError < 1e-6f);
+}
+
+void TestExp2()
+{
+	auto maxError = 0.f;
+
+	for (auto x = -125.f; x <= 127.f; x += 1.f / 64.f)
+		maxError = std::max(maxError, RelativeError(fast_math::exp2(x), exp2f(x)));
+
+	CHECK(maxError < 5e-7f);
+	CHECK(fast_math::exp2(-200.f) == 0.f);
+	CHECK(std::isinf(fast_math::exp2(200.f)));
+}
+
+void TestLength()
+{
+	for (const auto scale : {1e-3f, 1.f, 1e3f, 1e15f}) {
+		const auto vector = vec3(1.f, -2.f, 3.f) * scale;
+		CHECK(RelativeError(fast_math::length(vector), vector.length()) < 1e-6f);
+		CHECK(RelativeError(fast_math::normalized(vector).length(), 1.f) < 1e-6f);
+	}
+
+	// Squared lengths that are denormal, zero or infinite match the exact path
+	for (const auto &vector : {
+		vec3(1e-20f, 0.f, 0.f),
+		vec3(1e-19f, 1e-20f, 0.f),
+		vec3(1e-30f, 0.f, 0.f),
+		vec3(0.f, 0.f, 0.f),
+		vec3(1e20f, 0.f, 0.f),
+		vec3(INFINITY, 0.f, 0.f)
+	}) {
+		CHECK(fast_math::length(vector) == vector.length());
+
+		const auto fast = fast_math::normalized(vector);
+		const auto exact = vector.normalized();
+		CHECK(fast.x == exact.x || (std::isnan(fast.x) && std::isnan(exact.x)));
+		CHECK(fast.y == exact.y && fast.z == exact.z);
+	}
+}
+
+} // namespace
+
+int main()
+{
+	TestRsqrt();
+	TestExp2();
+	TestLength();
+	return test::Result();
+}
@@ -0,0 +1,72 @@
+// Hook names from compiler signatures, and counting through instrumented
+#include "test.h"
+#include "util/hook_profile.h"
+#include <algorithm>
+
+using detail::hook_profile::parse_name;
+
+namespace {
+
+int hook_plain(int x)
+{
+	return x + 1;
+}
+
+template<int Site>
+int hook_per_site(int x)
+{
+	return x + Site;
+}
+
+void TestParseName()
+{
+	// MSVC's __FUNCSIG__, whose return type has template arguments
+	CHECK(parse_name(
+		"class std::basic_string_view<char,struct std::char_traits<char> > __cdecl "
+		"detail::hook_profile::hook_name<&hook_CheckJumpButton>(void)") == "hook_CheckJumpButton");
+	CHECK(parse_name(
+		"class std::basic_string_view<char,struct std::char_traits<char> > __cdecl "
+		"detail::hook_profile::hook_name<&hook_MoveCharacter<13452621> >(void)") == "hook_MoveCharacter<13452621>");
+
+	// GCC's and Clang's __PRETTY_FUNCTION__
+	CHECK(parse_name(
+		"std::string_view detail::hook_profile::hook_name() [with auto Hook = hook_CheckJumpButton; "
+		"std::string_view = std::basic_string_view<char>]") == "hook_CheckJumpButton");
+	CHECK(parse_name(
+		"std::string_view detail::hook_profile::hook_name() [with auto Hook = hook_MoveCharacter<13452621>; "
+		"std::string_view = std::basic_string_view<char>]") == "hook_MoveCharacter<13452621>");
+	CHECK(parse_name(
+		"std::string_view detail::hook_profile::hook_name() [Hook = &hook_CheckJumpButton]") == "hook_CheckJumpButton");
+
+	// This compiler's own
+	CHECK(detail::hook_profile::hook_name<hook_plain>().ends_with("hook_plain"));
+	CHECK(detail::hook_profile::hook_name<hook_per_site<3>>().ends_with("hook_per_site<3>"));
+}
+
+void TestCounting()
+{
+	CHECK(instrumented<hook_plain>(1) == 2);
+	CHECK(instrumented<hook_per_site<3>>(1) == 4);
+	CHECK(instrumented<hook_per_site<3>>(2) == 5);
+
+	const auto profiles = get_hook_profiles();
+	const auto calls = [&](std::string_view suffix) {
+		const auto found = std::ranges::find_if(profiles, [&](const hook_profile &profile) {
+			return profile.name.ends_with(suffix);
+		});
+
+		return found != profiles.end() ? found->calls : 0;
+	};
+
+	CHECK(calls("hook_plain") == 1);
+	CHECK(calls("hook_per_site<3>") == 2);
+}
+
+} // namespace
+
+int main()
+{
+	TestParseName();
+	TestCounting();
+	return test::Result();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Defined in hook_targets.S
+extern "C" {
+
+int callee(int x);
+
+#define HOOK_TARGET_CALLER(name) \
+	int name(int x); \
+	extern const uint8_t name##_site[];
+
+HOOK_TARGET_CALLER(caller_base)
+HOOK_TARGET_CALLER(caller_tls)
+HOOK_TARGET_CALLER(caller_static)
+HOOK_TARGET_CALLER(caller_expected)
+HOOK_TARGET_CALLER(caller_shared)
+HOOK_TARGET_CALLER(caller_site_a)
+HOOK_TARGET_CALLER(caller_site_b)
+HOOK_TARGET_CALLER(caller_bench_tls)
+HOOK_TARGET_CALLER(caller_bench_static)
+HOOK_TARGET_CALLER(caller_bench_dispatch)
+HOOK_TARGET_CALLER(caller_bench_chain)
+
+#undef HOOK_TARGET_CALLER
+
+int jmp_target(int x);
+int jmp_target_bench(int x);
+
+}
+
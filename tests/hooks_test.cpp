@@ -0,0 +1,256 @@
+// Hooks the functions in hook_targets.S through each patching path
+#include "hook_targets.h"
+#include "test.h"
+#include "util/exec_arena.h"
+#include "util/hooks.h"
+#include "util/memory.h"
+#include "util/patch_transaction.h"
+#include "util/virtual_memory.h"
+#include <memory>
+#include <thread>
+
+using namespace std::string_view_literals;
+
+namespace {
+
+using int_function = int(*)(int);
+
+int hook_tls(int x)
+{
+	return ((int_function)HookGetOriginal())(x) + 100;
+}
+
+int hook_static(int x)
+{
+	return ((int_function)HookGetOriginal<hook_static>())(x) + 1000;
+}
+
+int hook_expected(int x)
+{
+	return x;
+}
+
+int hook_shared(int x)
+{
+	return ((int_function)HookGetOriginal<hook_shared>())(x) + 10000;
+}
+
+JmpHook<int_function, int_function, int> *g_jmpHook;
+
+int hook_jmp(int x)
+{
+	return g_jmpHook->callOriginal(x) * 10;
+}
+
+struct Base {
+	virtual int Get(int x) { return x; }
+	virtual ~Base() = default;
+};
+
+int hook_vtable(Base *object, int x)
+{
+	return ((int(*)(Base*, int))HookGetOriginal<hook_vtable>())(object, x) + 7;
+}
+
+void TestTrampolineCallHook()
+{
+	CHECK(patch_call_rel32((uintptr_t)caller_tls_site, (const void*)hook_tls));
+	CHECK(caller_tls(5) == 111);
+
+	// Each thread gets its own original
+	auto result = 0;
+	std::thread([&] { result = caller_tls(6); }).join();
+	CHECK(result == 113);
+}
+
+void TestStaticCallHook()
+{
+	{
+		auto patches = patch_transaction();
+		patches.call_rel32(
+			(uintptr_t)caller_static_site, (const void*)hook_static,
+			{}, &detail::hook::static_original<hook_static>);
+
+		CHECK(patches.commit());
+		CHECK(caller_static(5) == 1011);
+		CHECK(patches.revert());
+		CHECK(caller_static(5) == 11);
+		CHECK(patches.commit());
+		CHECK(caller_static(5) == 1011);
+	}
+
+	// Reverted when destroyed
+	CHECK(caller_static(5) == 11);
+}
+
+void TestExpectedMismatch()
+{
+	auto patches = patch_transaction();
+	patches.call_rel32((uintptr_t)caller_expected_site, (const void*)hook_expected, "\xE9"sv);
+	CHECK(!patches.commit());
+	CHECK(caller_expected(5) == 11);
+}
+
+void TestMaskedExpected()
+{
+	const auto site = (uintptr_t)caller_expected_site;
+
+	// Only the masked bits of e9 are compared against the e8 there
+	auto matching = patch_transaction();
+	matching.code(site, "\xE8"sv, "\xE9"sv, "\xFE"sv);
+	CHECK(matching.commit());
+
+	auto mismatched = patch_transaction();
+	mismatched.code(site, "\xE8"sv, "\xE9"sv, "\xFF"sv);
+	CHECK(!mismatched.commit());
+}
+
+// Shared sites go through the registry in the same page batch as the writes
+void TestSharedHook()
+{
+	auto *registry = get_hook_dispatch_registry();
+	const auto site = (uintptr_t)caller_shared_site;
+
+	{
+		auto patches = patch_transaction();
+		patches.shared_call_rel32(site, (const void*)hook_shared, &detail::hook::static_original<hook_shared>);
+		patches.code(site, "\xE8"sv, "\xE8"sv);
+
+		CHECK(patches.commit());
+		CHECK(caller_shared(5) == 10011);
+		CHECK(registry->handler_count(hook_site::call_rel32, site) == 1);
+
+		const auto first = site & ~(PAGE_SIZE - 1);
+		const auto last = (site + 4) & ~(PAGE_SIZE - 1);
+		CHECK(patches.page_count() == (first == last ? 1u : 2u));
+
+		CHECK(patches.revert());
+		CHECK(caller_shared(5) == 11);
+		CHECK(registry->handler_count(hook_site::call_rel32, site) == 0);
+		CHECK(patches.commit());
+		CHECK(caller_shared(5) == 10011);
+	}
+
+	CHECK(caller_shared(5) == 11);
+
+	// Protection is back as it was
+	auto old = page_access::none;
+	CHECK(vm_protect((void*)site, 1, page_access::read_execute, &old));
+	CHECK(old == page_access::read_execute);
+}
+
+// One instance per site, each with its own original
+template<int Site>
+int hook_per_site(int x)
+{
+	return ((int_function)HookGetOriginal<hook_per_site<Site>>())(x) + 10000;
+}
+
+void TestPerSiteOriginals()
+{
+	auto *registry = get_hook_dispatch_registry();
+	const auto siteA = (uintptr_t)caller_site_a_site;
+	const auto siteB = (uintptr_t)caller_site_b_site;
+
+	// Another module's hook on one of the sites
+	CHECK(patch_call_rel32(siteB, (const void*)hook_tls));
+	CHECK(caller_site_b(5) == 111);
+
+	// One slot can't serve two sites
+	{
+		auto patches = patch_transaction();
+		patches.shared_call_rel32(siteA, (const void*)hook_per_site<0>, &detail::hook::static_original<hook_per_site<0>>);
+		patches.shared_call_rel32(siteB, (const void*)hook_per_site<0>, &detail::hook::static_original<hook_per_site<0>>);
+		CHECK(!patches.commit());
+		CHECK(registry->handler_count(hook_site::call_rel32, siteA) == 0);
+		CHECK(caller_site_a(5) == 11);
+	}
+
+	{
+		auto patches = patch_transaction();
+		patches.shared_call_rel32(siteA, (const void*)hook_per_site<1>, &detail::hook::static_original<hook_per_site<1>>);
+		patches.shared_call_rel32(siteB, (const void*)hook_per_site<2>, &detail::hook::static_original<hook_per_site<2>>);
+		CHECK(patches.commit());
+		CHECK(caller_site_a(5) == 10011);
+		CHECK(caller_site_b(5) == 10111);
+	}
+
+	CHECK(caller_site_a(5) == 11);
+	CHECK(caller_site_b(5) == 111);
+}
+
+void TestVtableHook()
+{
+	auto object = std::make_unique<Base>();
+	auto *vtable = *(void***)object.get();
+
+	// Through the vtable, as the compiler may devirtualize a plain call
+	CHECK(patch_vtable<hook_vtable>(vtable, 0));
+	CHECK(call_virtual<0, decltype(&Base::Get)>(object.get(), 3) == 10);
+}
+
+void TestJmpHook()
+{
+	CHECK(jmp_target(4) == 5);
+
+	{
+		auto hook = JmpHook((void*)jmp_target, hook_jmp);
+		g_jmpHook = (decltype(g_jmpHook))&hook;
+		CHECK(hook.is_installed());
+		CHECK(jmp_target(4) == 50);
+	}
+
+	CHECK(jmp_target(4) == 5);
+}
+
+// Hot and cold stubs near the same code never share a block, so rarely run
+// stubs stay off the hot stubs' cache lines
+void TestStubHeat()
+{
+	const auto hot = make_exec(16, (void*)jmp_target);
+	const auto cold = make_exec(16, (void*)jmp_target, stub_heat::cold);
+	const auto hotAgain = make_exec(16, (void*)jmp_target);
+	const auto block = [](const exec_ptr &stub) { return (uintptr_t)stub.get() & ~(uintptr_t)0xFFFF; };
+
+	CHECK(hot != nullptr && cold != nullptr && hotAgain != nullptr);
+	CHECK(block(hot) != block(cold));
+	CHECK(block(hotAgain) != block(cold));
+	CHECK(in_rel32_reach((uintptr_t)jmp_target, cold.get()));
+}
+
+void TestProtectionQuery()
+{
+	auto *page = vm_reserve(nullptr, PAGE_SIZE);
+	CHECK(page != nullptr);
+	CHECK(vm_commit(page, PAGE_SIZE, page_access::read_write));
+
+	auto old = page_access::none;
+	CHECK(vm_protect(page, 1, page_access::read_execute, &old));
+	CHECK(old == page_access::read_write);
+	CHECK(vm_protect(page, 1, page_access::read_write, &old));
+	CHECK(old == page_access::read_execute);
+
+	// Code pages the process mapped itself
+	CHECK(vm_protect((void*)callee, 1, page_access::read_write_execute, &old));
+	CHECK(old == page_access::read_execute);
+	CHECK(vm_protect((void*)callee, 1, old, &old));
+	CHECK(old == page_access::read_write_execute);
+}
+
+} // namespace
+
+int main()
+{
+	CHECK(caller_base(5) == 11);
+	TestTrampolineCallHook();
+	TestStaticCallHook();
+	TestExpectedMismatch();
+	TestMaskedExpected();
+	TestSharedHook();
+	TestPerSiteOriginals();
+	TestVtableHook();
+	TestJmpHook();
+	TestStubHeat();
+	TestProtectionQuery();
+	return test::Result();
+}
@@ -0,0 +1,111 @@
+// A plugin build for hot_reload_test, following the plugin's reload steps. It
+// hooks caller_base's call in the test executable, and each hooked call stands
+// in for a movement step, advancing the player state carried between builds.
+#include "hook_targets.h"
+#include "hot_reload.h"
+#include "util/hook_gate.h"
+#include "util/memory.h"
+#include "util/patch_transaction.h"
+#include <chrono>
+
+namespace {
+
+constexpr auto kDrainTimeout = std::chrono::milliseconds(500);
+
+hook_gate g_hookGate;
+patch_transaction g_patches;
+hot_reload::PlayerState g_player;
+hot_reload::ReloadFunction *g_currentReload;
+
+// Stands in for callee(0), returning the number of steps taken across every
+// build so far. Passing through to callee once a drain has started.
+bool StepCallback(mid_hook_context *context)
+{
+	const auto gate = g_hookGate.enter();
+
+	if (!gate)
+		return false;
+
+	g_player.fixedStep.current.x += 1.f;
+	context->ax = (uintptr_t)g_player.fixedStep.current.x;
+	return true;
+}
+
+// A generated hook, as the hook function would be out of reach of a rel32
+// and a trampoline can't reach this library's thread_local original
+bool Start()
+{
+	g_patches.add(patch_entry {
+		.kind     = patch_kind::call_rel32,
+		.address  = (uintptr_t)caller_base_site,
+		.original = &detail::hook::static_original<StepCallback>,
+		.mid      = {.callback = StepCallback, .context = MID_HOOK_AX}
+	});
+
+	g_hookGate.reopen();
+	return g_patches.commit();
+}
+
+bool Stop()
+{
+	if (!g_patches.revert())
+		return false;
+
+	if (!g_hookGate.drain(kDrainTimeout)) {
+		g_patches.commit();
+		g_hookGate.reopen();
+		return false;
+	}
+
+	return true;
+}
+
+bool Reload()
+{
+	void *module;
+	const auto hotLoad = hot_reload::LoadBuild(HOT_RELOAD_BUILD_PATH, &module);
+
+	if (hotLoad == nullptr)
+		return false;
+
+	if (!Stop()) {
+		hot_reload::UnloadBuild(module);
+		return false;
+	}
+
+	const auto handoff = hot_reload::Handoff {
+		.version   = hot_reload::kHandoffVersion,
+		.size      = sizeof(hot_reload::Handoff),
+		.current   = g_currentReload,
+		.hasPlayer = true,
+		.player    = g_player,
+		.enabled   = true
+	};
+
+	if (!hotLoad(&handoff)) {
+		hot_reload::UnloadBuild(module);
+		g_hookGate.reopen();
+		g_patches.commit();
+		return false;
+	}
+
+	return true;
+}
+
+} // namespace
+
+extern "C" __attribute__((visibility("default"))) bool PlayerPhysics_HotLoad(const hot_reload::Handoff *handoff)
+{
+	if (handoff->version != hot_reload::kHandoffVersion || handoff->size != sizeof(*handoff))
+		return false;
+
+	if (handoff->hasPlayer)
+		g_player = handoff->player;
+
+	if (!Start())
+		return false;
+
+	g_currentReload = handoff->current;
+	*g_currentReload = Reload;
+	return true;
+}
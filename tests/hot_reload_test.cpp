@@ -0,0 +1,125 @@
+// Loads hot_reload_build, then reloads it over and over while another thread
+// runs the code it hooks, as PlayerPhysicsReload does in game. Each reload
+// has to take under a second and hand the player state to the new build.
+#include "hook_targets.h"
+#include "hot_reload.h"
+#include "test.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+constexpr auto kReloads = 20;
+constexpr auto kStepsPerBuild = 1000;
+constexpr auto kMaxReloadTime = std::chrono::seconds(1);
+
+// Hooked calls so far, each of which the builds count as a step. Only written
+// by one thread at a time.
+std::atomic<int> g_steps;
+std::atomic<bool> g_stop;
+std::atomic<int> g_wrong;
+
+void RunSteps()
+{
+	while (!g_stop.load(std::memory_order_relaxed)) {
+		const auto result = caller_base(0);
+
+		// Unhooked between one build's revert and the next one's commit, or
+		// turned away by a draining build
+		if (result == 1)
+			continue;
+
+		// Hooked, counting on from every build before
+		const auto steps = g_steps.load(std::memory_order_relaxed) + 1;
+
+		if (result != steps + 1)
+			g_wrong++;
+
+		g_steps.store(steps, std::memory_order_release);
+	}
+}
+
+// False if the caller thread didn't get that many hooked calls in
+bool WaitForSteps(int count)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+	while (g_steps.load(std::memory_order_acquire) < count) {
+		if (std::chrono::steady_clock::now() >= deadline)
+			return false;
+
+		std::this_thread::yield();
+	}
+
+	return true;
+}
+
+void TestReload()
+{
+	void *module;
+	const auto hotLoad = hot_reload::LoadBuild(HOT_RELOAD_BUILD_PATH, &module);
+	CHECK(hotLoad != nullptr);
+
+	if (hotLoad == nullptr)
+		return;
+
+	// Where the first build's console command finds the current build
+	auto reload = hot_reload::ReloadFunction();
+
+	const auto handoff = hot_reload::Handoff {
+		.version = hot_reload::kHandoffVersion,
+		.size    = sizeof(hot_reload::Handoff),
+		.current = &reload,
+		.enabled = true
+	};
+
+	if (!CHECK(hotLoad(&handoff)))
+		return;
+
+	CHECK(caller_base(0) == 2);
+	g_steps = 1;
+
+	auto thread = std::thread(RunSteps);
+	auto failed = 0;
+	auto stalled = 0;
+	auto slowest = std::chrono::steady_clock::duration();
+
+	for (auto i = 0; i < kReloads; i++) {
+		// Step in each build before replacing it
+		if (!WaitForSteps(g_steps + kStepsPerBuild))
+			stalled++;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		if (!reload())
+			failed++;
+
+		slowest = std::max(slowest, std::chrono::steady_clock::now() - start);
+	}
+
+	if (!WaitForSteps(g_steps + kStepsPerBuild))
+		stalled++;
+
+	g_stop = true;
+	thread.join();
+
+	CHECK(failed == 0);
+	CHECK(stalled == 0);
+	CHECK(g_wrong == 0);
+	CHECK(slowest < kMaxReloadTime);
+
+	// The last build still counts on from the first
+	const auto steps = g_steps.load();
+	CHECK(steps > kStepsPerBuild * kReloads);
+	CHECK(caller_base(0) == steps + 2);
+}
+
+} // namespace
+
+int main()
+{
+	TestReload();
+	return test::Result();
+}
@@ -0,0 +1,3 @@
+// Stands in for the header i386 glibc installs, so the x86_64 headers can be
+// used for -m32 builds without a multilib toolchain. Nothing is linked from
+// glibc, so there are no stub functions to list.
@@ -0,0 +1,461 @@
+// Just enough of a C and C++ runtime to run the hook tests and benchmarks as
+// static i386 executables without 32 bit libraries installed. Only what they
+// call is provided, through raw Linux system calls.
+#include "util/exec_arena.h"
+#include "util/memory.h"
+#include <chrono>
+#include <cfloat>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+
+namespace {
+
+long syscall3(long number, long a, long b, long c)
+{
+	long result;
+	asm volatile("int $0x80" : "=a"(result) : "a"(number), "b"(a), "c"(b), "d"(c) : "memory");
+	return result;
+}
+
+long syscall6(long number, long a, long b, long c, long d, long e, long f)
+{
+	// ebp can't be named as an operand, so the sixth argument is swapped in
+	long result;
+	asm volatile(
+		"push %%ebp\n\t"
+		"mov %7, %%ebp\n\t"
+		"int $0x80\n\t"
+		"pop %%ebp"
+		: "=a"(result)
+		: "a"(number), "b"(a), "c"(b), "d"(c), "S"(d), "D"(e), "m"(f)
+		: "memory");
+	return result;
+}
+
+[[noreturn]] void exit_group(int code)
+{
+	for (;;)
+		syscall3(SYS_exit_group, code, 0, 0);
+}
+
+// Executable memory for stubs, never returned
+std::byte *arena;
+size_t arena_left;
+
+// printf output, flushed when full and on exit
+struct output_buffer {
+	int fd;
+	size_t size = 0;
+	char data[1024] = {};
+
+	void flush()
+	{
+		for (size_t written = 0; written < size;) {
+			const auto result = syscall3(SYS_write, fd, (long)(data + written), (long)(size - written));
+
+			if (result <= 0)
+				break;
+
+			written += (size_t)result;
+		}
+
+		size = 0;
+	}
+
+	void put(char c)
+	{
+		if (size == sizeof(data))
+			flush();
+
+		data[size++] = c;
+	}
+
+	void put(const char *string, size_t length)
+	{
+		for (size_t i = 0; i < length; i++)
+			put(string[i]);
+	}
+};
+
+output_buffer outputs[2] = {{.fd = 1}, {.fd = 2}};
+
+output_buffer &output_for(FILE *file)
+{
+	return outputs[file == stderr];
+}
+
+void put_unsigned(output_buffer &out, uint32_t value, int width)
+{
+	char digits[10];
+	auto count = 0;
+
+	do {
+		digits[count++] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	for (; width > count; width--)
+		out.put(' ');
+
+	while (count > 0)
+		out.put(digits[--count]);
+}
+
+void put_double(output_buffer &out, double value, int precision)
+{
+	if (value != value) {
+		out.put("nan", 3);
+		return;
+	}
+
+	if (value < 0) {
+		out.put('-');
+		value = -value;
+	}
+
+	if (value > DBL_MAX) {
+		out.put("inf", 3);
+		return;
+	}
+
+	if (value >= 4e9) {
+		// Too big for the integer part, scale down and show the exponent
+		auto exponent = 0u;
+
+		for (; value >= 10.; exponent++)
+			value /= 10.;
+
+		put_double(out, value, precision);
+		out.put('e');
+		put_unsigned(out, exponent, 0);
+		return;
+	}
+
+	auto scale = 1.;
+
+	for (auto i = 0; i < precision; i++)
+		scale *= 10.;
+
+	const auto whole = (uint32_t)value;
+	auto fraction = (value - whole) * scale + .5;
+	auto carry = fraction >= scale;
+
+	put_unsigned(out, whole + carry, 0);
+
+	if (precision == 0)
+		return;
+
+	out.put('.');
+
+	if (carry)
+		fraction -= scale;
+
+	for (auto i = precision - 1; i >= 0; i--) {
+		auto digit_scale = 1.;
+
+		for (auto j = 0; j < i; j++)
+			digit_scale *= 10.;
+
+		const auto digit = (int)(fraction / digit_scale);
+		out.put((char)('0' + digit));
+		fraction -= digit * digit_scale;
+	}
+}
+
+// %d %u %x %zu %s %c %f %g %p and %%, with a width on integers and a
+// precision on floats. %g prints as %f.
+int format(output_buffer &out, const char *format, va_list args)
+{
+	for (const auto *c = format; *c != '\0'; c++) {
+		if (*c != '%') {
+			out.put(*c);
+			continue;
+		}
+
+		c++;
+		auto width = 0;
+		auto precision = 6;
+
+		while (*c >= '0' && *c <= '9')
+			width = width * 10 + *c++ - '0';
+
+		if (*c == '.') {
+			precision = 0;
+
+			while (*++c >= '0' && *c <= '9')
+				precision = precision * 10 + *c - '0';
+		}
+
+		while (*c == 'z' || *c == 'l')
+			c++;
+
+		switch (*c) {
+		case 'd': {
+			const auto value = va_arg(args, int);
+
+			if (value < 0)
+				out.put('-');
+
+			put_unsigned(out, value < 0 ? 0u - (uint32_t)value : (uint32_t)value, width);
+			break;
+		}
+		case 'u':
+			put_unsigned(out, va_arg(args, uint32_t), width);
+			break;
+		case 'x':
+		case 'p': {
+			const auto value = *c == 'p' ? (uint32_t)(uintptr_t)va_arg(args, void*) : va_arg(args, uint32_t);
+
+			for (auto shift = 28; shift >= 0; shift -= 4) {
+				if ((value >> shift) != 0 || shift == 0)
+					out.put("0123456789abcdef"[(value >> shift) & 15]);
+			}
+
+			break;
+		}
+		case 's': {
+			const auto *string = va_arg(args, const char*);
+			out.put(string, strlen(string));
+			break;
+		}
+		case 'c':
+			out.put((char)va_arg(args, int));
+			break;
+		case 'f':
+		case 'g':
+			put_double(out, va_arg(args, double), precision);
+			break;
+		case '%':
+			out.put('%');
+			break;
+		default:
+			return -1;
+		}
+	}
+
+	if (&out == &outputs[1])
+		out.flush();
+
+	return 0;
+}
+
+} // namespace
+
+extern "C" {
+
+FILE *stdout = (FILE*)&outputs[0];
+FILE *stderr = (FILE*)&outputs[1];
+
+void *memcpy(void *dest, const void *src, size_t size)
+{
+	auto *d = (char*)dest;
+	const auto *s = (const char*)src;
+
+	while (size-- != 0)
+		*d++ = *s++;
+
+	return dest;
+}
+
+void *memmove(void *dest, const void *src, size_t size)
+{
+	auto *d = (char*)dest;
+	const auto *s = (const char*)src;
+
+	if (d < s)
+		return memcpy(dest, src, size);
+
+	while (size-- != 0)
+		d[size] = s[size];
+
+	return dest;
+}
+
+void *memset(void *dest, int value, size_t size)
+{
+	auto *d = (char*)dest;
+
+	while (size-- != 0)
+		*d++ = (char)value;
+
+	return dest;
+}
+
+int memcmp(const void *a, const void *b, size_t size)
+{
+	const auto *x = (const unsigned char*)a;
+	const auto *y = (const unsigned char*)b;
+
+	for (size_t i = 0; i < size; i++) {
+		if (x[i] != y[i])
+			return x[i] - y[i];
+	}
+
+	return 0;
+}
+
+size_t strlen(const char *string)
+{
+	size_t length = 0;
+
+	while (string[length] != '\0')
+		length++;
+
+	return length;
+}
+
+int strcmp(const char *a, const char *b)
+{
+	for (; *a != '\0' && *a == *b; a++, b++) {}
+
+	return (unsigned char)*a - (unsigned char)*b;
+}
+
+int vfprintf(FILE *file, const char *format_string, va_list args)
+{
+	return format(output_for(file), format_string, args);
+}
+
+int fprintf(FILE *file, const char *format_string, ...)
+{
+	va_list args;
+	va_start(args, format_string);
+	const auto result = vfprintf(file, format_string, args);
+	va_end(args);
+	return result;
+}
+
+int printf(const char *format_string, ...)
+{
+	va_list args;
+	va_start(args, format_string);
+	const auto result = vfprintf(stdout, format_string, args);
+	va_end(args);
+	return result;
+}
+
+// What GCC turns simple printf calls into
+int fputc(int c, FILE *file)
+{
+	output_for(file).put((char)c);
+	return c;
+}
+
+int putchar(int c)
+{
+	return fputc(c, stdout);
+}
+
+int fputs(const char *string, FILE *file)
+{
+	output_for(file).put(string, strlen(string));
+	return 0;
+}
+
+int puts(const char *string)
+{
+	fputs(string, stdout);
+	return putchar('\n');
+}
+
+size_t fwrite(const void *data, size_t size, size_t count, FILE *file)
+{
+	output_for(file).put((const char*)data, size * count);
+	return count;
+}
+
+int __cxa_atexit(void (*)(void*), void*, void*)
+{
+	return 0;
+}
+
+void *__dso_handle;
+
+int main(int argc, char *argv[]);
+
+extern void (*__init_array_start[])();
+extern void (*__init_array_end[])();
+
+[[noreturn]] void start_main(int argc, char *argv[])
+{
+	for (auto *init = __init_array_start; init != __init_array_end; init++)
+		(*init)();
+
+	const auto result = main(argc, argv);
+	outputs[0].flush();
+	outputs[1].flush();
+	exit_group(result);
+}
+
+}
+
+// The kernel starts the process with argc at the stack pointer and argv after
+// it. The stack is realigned for code that expects the SysV alignment.
+asm(R"(
+	.globl _start
+	.type _start, @function
+_start:
+	xor %ebp, %ebp
+	mov (%esp), %eax
+	lea 4(%esp), %ecx
+	and $-16, %esp
+	sub $8, %esp
+	push %ecx
+	push %eax
+	call start_main
+)");
+
+std::chrono::steady_clock::time_point std::chrono::steady_clock::now() noexcept
+{
+	struct {
+		int32_t seconds;
+		int32_t nanoseconds;
+	} time;
+
+	syscall3(SYS_clock_gettime, CLOCK_MONOTONIC, (long)&time, 0);
+	return time_point(duration((int64_t)time.seconds * 1000000000 + time.nanoseconds));
+}
+
+void *exec_alloc(size_t size, const void*, stub_heat)
+{
+	size = (size + STUB_ALIGN - 1) & ~(STUB_ALIGN - 1);
+
+	if (size > arena_left) {
+		constexpr auto block = (size_t)0x10000;
+
+		if (size > block)
+			return nullptr;
+
+		const auto result = syscall6(
+			SYS_mmap2, 0, block, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if ((unsigned long)result >= (unsigned long)-4095)
+			return nullptr;
+
+		arena = (std::byte*)result;
+		arena_left = block;
+	}
+
+	auto *result = arena;
+	arena += size;
+	arena_left -= size;
+	return result;
+}
+
+void exec_free(void*, size_t)
+{
+}
+
+void patch_code(void *target, const void *patch, size_t size)
+{
+	const auto start = (uintptr_t)target & ~(uintptr_t)(PAGE_SIZE - 1);
+	const auto end = ((uintptr_t)target + size + PAGE_SIZE - 1) & ~(uintptr_t)(PAGE_SIZE - 1);
+
+	syscall3(SYS_mprotect, (long)start, (long)(end - start), PROT_READ | PROT_WRITE | PROT_EXEC);
+	memcpy(target, patch, size);
+}
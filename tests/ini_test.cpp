@@ -0,0 +1,54 @@
+#include "test.h"
+#include "ini.h"
+#include <cmath>
+
+namespace {
+
+void TestParse()
+{
+	const auto settings = ini::Parse(
+		"fFriction = 3.5\n"
+		"[Physics]\n"
+		"FACCELERATION=7 ; comment\n"
+		"iProfile = 2\n"
+		"fAirSpeed = bad\n"
+		"[Other]\n"
+		"fStopSpeed = 1\n");
+
+	CHECK(settings.fFriction == ini::Settings().fFriction);
+	CHECK(settings.fAcceleration == 7.f);
+	CHECK(settings.iProfile == 2);
+	CHECK(settings.fAirSpeed == ini::Settings().fAirSpeed);
+	CHECK(settings.fStopSpeed == ini::Settings().fStopSpeed);
+}
+
+// Values that would divide by zero or stall a step are clamped
+void TestClamp()
+{
+	const auto zero = ini::Parse("[Physics]\nfLandingPenaltyImpactSpeed50=0\niMaxSubsteps=0\nfFixedTimestep=-1\n");
+	CHECK(zero.fLandingPenaltyImpactSpeed50 > 0.f);
+	CHECK(zero.iMaxSubsteps == 1);
+	CHECK(zero.fFixedTimestep == 0.f);
+
+	const auto large = ini::Parse("[Physics]\nfLandingPenaltyImpactSpeed50=-50\niMaxSubsteps=1000000\n");
+	CHECK(large.fLandingPenaltyImpactSpeed50 > 0.f);
+	CHECK(large.iMaxSubsteps <= 64);
+
+	const auto nan = ini::Parse("[Physics]\nfLandingPenaltyImpactSpeed50=nan\nfFixedTimestep=inf\n");
+	CHECK(nan.fLandingPenaltyImpactSpeed50 > 0.f);
+	CHECK(nan.fFixedTimestep == 0.f);
+
+	// In range values are kept
+	const auto kept = ini::Parse("[Physics]\nfLandingPenaltyImpactSpeed50=40\niMaxSubsteps=16\n");
+	CHECK(kept.fLandingPenaltyImpactSpeed50 == 40.f);
+	CHECK(kept.iMaxSubsteps == 16);
+}
+
+} // namespace
+
+int main()
+{
+	TestParse();
+	TestClamp();
+	return test::Result();
+}
@@ -0,0 +1,97 @@
+// InputSampler against a scripted source, and SplitInterval
+#include "test.h"
+#include "input_sampler.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace input;
+
+namespace {
+
+constexpr auto kForward = KeyBit(kInputKey_Forward);
+constexpr auto kJump = KeyBit(kInputKey_Jump);
+
+// Until a poll that started after now has also pushed its edge. A poll is
+// counted after reading keys and before pushing, so that's three more.
+void WaitForPolls(const InputSampler &sampler)
+{
+	const auto polls = sampler.GetStats().polls;
+
+	while (sampler.GetStats().polls < polls + 3)
+		std::this_thread::yield();
+}
+
+void TestSampler()
+{
+	auto source = ScriptedInputSource({
+		{.timestamp = 1000, .keys = kForward},
+		{.timestamp = 2000, .keys = kForward | kJump},
+		{.timestamp = 3000, .keys = 0}
+	});
+
+	auto sampler = InputSampler();
+	sampler.Start(&source, 100'000);
+	CHECK(sampler.IsRunning());
+
+	std::vector<InputEdge> seen;
+	std::vector<uint32_t> previous;
+
+	for (const auto time : {1500, 2500, 3500}) {
+		source.Advance(time - source.Now());
+		WaitForPolls(sampler);
+
+		const auto keys = sampler.Consume(source.Now(), [&](const InputEdge &edge, uint32_t last) {
+			seen.push_back(edge);
+			previous.push_back(last);
+		});
+
+		CHECK(keys == (seen.empty() ? 0 : seen.back().keys));
+		CHECK(sampler.GetLastConsumeTime() == time);
+	}
+
+	sampler.Stop();
+	CHECK(!sampler.IsRunning());
+
+	// Edges are stamped when seen, not when scripted
+	CHECK(seen.size() == 3);
+	CHECK(seen.size() == 3 && seen[0].keys == kForward && seen[0].timestamp == 1500);
+	CHECK(seen.size() == 3 && seen[1].keys == (kForward | kJump) && seen[1].timestamp == 2500);
+	CHECK(seen.size() == 3 && seen[2].keys == 0 && previous[2] == (kForward | kJump));
+
+	const auto stats = sampler.GetStats();
+	CHECK(stats.edges == 3 && stats.dropped == 0);
+	CHECK(stats.polls >= 9);
+	CHECK(stats.pollTime == 3500);
+	CHECK(stats.maxLatency == 0);
+}
+
+void TestSplitInterval()
+{
+	const InputEdge edges[] = {
+		{.timestamp = 250, .keys = kForward | kJump},
+		{.timestamp = 500, .keys = kForward},
+		{.timestamp = 2000, .keys = 0}
+	};
+
+	InputSegment segments[4];
+	auto count = SplitInterval(kForward, edges, 0, 1000, segments);
+	CHECK(count == 3);
+	CHECK(segments[0].keys == kForward && segments[0].fraction == .25f);
+	CHECK(segments[1].keys == (kForward | kJump) && segments[1].fraction == .25f);
+	CHECK(segments[2].keys == kForward && segments[2].fraction == .5f);
+
+	// Overflow merges into the last segment
+	count = SplitInterval(kForward, edges, 0, 1000, {segments, 2});
+	CHECK(count == 2);
+	CHECK(segments[1].keys == (kForward | kJump) && segments[1].fraction == .75f);
+}
+
+} // namespace
+
+int main()
+{
+	TestSampler();
+	TestSplitInterval();
+	return test::Result();
+}
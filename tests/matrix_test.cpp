@@ -0,0 +1,210 @@
+// The SSE matrix path against the generic path, bit for bit, over random
+// inputs including NaNs, infinities, denormals and signed zeros
+#include "test.h"
+#include "util/matrix.h"
+#include <bit>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// A float without an SSE specialization, so matrices of it take the generic
+// path with the same float operations
+struct scalar_float {
+	float value;
+
+	constexpr scalar_float operator+(scalar_float other) const { return {value + other.value}; }
+	constexpr scalar_float operator-(scalar_float other) const { return {value - other.value}; }
+	constexpr scalar_float operator*(scalar_float other) const { return {value * other.value}; }
+	constexpr scalar_float operator/(scalar_float other) const { return {value / other.value}; }
+	constexpr scalar_float operator-() const { return {-value}; }
+	constexpr bool operator==(scalar_float other) const { return value == other.value; }
+};
+
+template<size_t N, size_t M>
+using scalar_matrix = matrix<scalar_float, N, M>;
+
+constexpr auto kCases = 100000;
+
+std::mt19937 g_rng(7);
+
+float RandomFloat()
+{
+	switch (g_rng() % 16) {
+	case 0:  return std::bit_cast<float>((uint32_t)g_rng());
+	case 1:  return g_rng() % 2 != 0 ? -0.f : 0.f;
+	case 2:  return g_rng() % 2 != 0 ? INFINITY : -INFINITY;
+	case 3:  return std::bit_cast<float>((uint32_t)g_rng() & 0x807FFFFF);
+	default: return std::uniform_real_distribution<float>(-10.f, 10.f)(g_rng);
+	}
+}
+
+// Equal bits, or both NaN with any payload
+bool BitEqual(float a, float b)
+{
+	return std::bit_cast<uint32_t>(a) == std::bit_cast<uint32_t>(b) || (std::isnan(a) && std::isnan(b));
+}
+
+template<size_t N, size_t M>
+bool BitEqual(const matrix<float, N, M> &a, const scalar_matrix<N, M> &b)
+{
+	for (size_t i = 0; i < N * M; i++) {
+		if (!BitEqual(a.elems[i], b.elems[i].value))
+			return false;
+	}
+
+	return true;
+}
+
+template<size_t N, size_t M>
+bool BitEqual(const std::optional<matrix<float, N, M>> &a, const std::optional<scalar_matrix<N, M>> &b)
+{
+	return a.has_value() == b.has_value() && (!a || BitEqual(*a, *b));
+}
+
+bool BitEqual(const vec3 &a, const vec3 &b)
+{
+	return BitEqual(a.x, b.x) && BitEqual(a.y, b.y) && BitEqual(a.z, b.z);
+}
+
+template<size_t N, size_t M>
+matrix<float, N, M> RandomMatrix()
+{
+	matrix<float, N, M> m;
+
+	for (auto &elem : m.elems)
+		elem = RandomFloat();
+
+	return m;
+}
+
+template<size_t N, size_t M>
+scalar_matrix<N, M> Scalar(const matrix<float, N, M> &m)
+{
+	scalar_matrix<N, M> result;
+
+	for (size_t i = 0; i < N * M; i++)
+		result.elems[i] = {m.elems[i]};
+
+	return result;
+}
+
+void TestRandom()
+{
+	for (auto i = 0; i < kCases && test::failures == 0; i++) {
+		const auto a = RandomMatrix<4, 4>();
+		const auto b = RandomMatrix<4, 4>();
+		const auto c = RandomMatrix<3, 4>();
+		const auto d = RandomMatrix<3, 4>();
+		const auto sa = Scalar(a);
+		const auto sb = Scalar(b);
+		const auto sc = Scalar(c);
+		const auto sd = Scalar(d);
+
+		CHECK(BitEqual(a * b, sa * sb));
+		CHECK(BitEqual(c * b, sc * sb));
+		CHECK(BitEqual(affine_multiply(c, d), affine_multiply(sc, sd)));
+		CHECK(BitEqual(a.transposed(), sa.transposed()));
+		CHECK(BitEqual(inverse(a), inverse(sa)));
+		CHECK(BitEqual(affine_inverse(c), affine_inverse(sc)));
+	}
+}
+
+// Batches run four at a time with the rest one by one, so every length up to
+// a few batches against transform_point and transform_direction
+void TestTransforms()
+{
+	for (auto i = 0; i < kCases / 10 && test::failures == 0; i++) {
+		const auto m = RandomMatrix<3, 4>();
+		auto in = std::vector<vec3>((size_t)i % 11);
+
+		for (auto &v : in)
+			v = vec3(RandomFloat(), RandomFloat(), RandomFloat());
+
+		auto points = std::vector<vec3>(in.size());
+		auto directions = std::vector<vec3>(in.size());
+		transform_points(m, in, points);
+		transform_directions(m, in, directions);
+
+		for (size_t j = 0; j < in.size(); j++) {
+			CHECK(BitEqual(points[j], transform_point(m, in[j])));
+			CHECK(BitEqual(directions[j], transform_direction(m, in[j])));
+		}
+
+		// In place
+		transform_points(m, in, in);
+
+		for (size_t j = 0; j < in.size(); j++)
+			CHECK(BitEqual(in[j], points[j]));
+	}
+}
+
+// M * M^-1 stays close to the identity for well conditioned matrices
+void TestInverseAccuracy()
+{
+	auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+	auto maxError = 0.f;
+	auto maxAffineError = 0.f;
+
+	for (auto i = 0; i < kCases / 10; i++) {
+		matrix4x4 m;
+		matrix3x4 a;
+
+		for (size_t k = 0; k < 16; k++)
+			m.elems[k] = unit(g_rng) + (k % 5 == 0 ? 4.f : 0.f);
+
+		for (size_t k = 0; k < 12; k++)
+			a.elems[k] = unit(g_rng) + (k % 5 == 0 ? 4.f : 0.f);
+
+		const auto identity = m * *inverse(m);
+		const auto affineIdentity = affine_multiply(a, *affine_inverse(a));
+
+		for (size_t k = 0; k < 16; k++)
+			maxError = std::max(maxError, std::abs(identity.elems[k] - (k % 5 == 0 ? 1.f : 0.f)));
+
+		for (size_t k = 0; k < 12; k++)
+			maxAffineError = std::max(maxAffineError, std::abs(affineIdentity.elems[k] - (k % 5 == 0 ? 1.f : 0.f)));
+	}
+
+	CHECK(maxError < 2e-6f);
+	CHECK(maxAffineError < 2e-6f);
+
+	// Singular matrices have no inverse on either path
+	auto singular = matrix4x4();
+	singular.get(0, 0) = 1.f;
+	CHECK(!inverse(singular));
+	CHECK(!inverse(Scalar(singular)));
+	CHECK(!affine_inverse(matrix3x4()));
+}
+
+void TestConstant()
+{
+	constexpr auto inv = *inverse(matrix4x4(
+		2.f, 0.f, 0.f, 0.f,
+		0.f, 4.f, 0.f, 0.f,
+		0.f, 0.f, 8.f, 0.f,
+		0.f, 0.f, 0.f, 1.f));
+	static_assert(inv.get(1, 1) == .25f);
+	constexpr auto affineInv = *affine_inverse(matrix3x4(
+		1.f, 0.f, 0.f, 5.f,
+		0.f, 1.f, 0.f, 6.f,
+		0.f, 0.f, 1.f, 7.f));
+	static_assert(affineInv.get(2, 3) == -7.f);
+	static_assert(transform_point(affineInv, vec3(5.f, 6.f, 7.f)) == vec3(0.f, 0.f, 0.f));
+	static_assert(matrix3x4(
+		1.f, 2.f, 3.f, 4.f,
+		5.f, 6.f, 7.f, 8.f,
+		9.f, 10.f, 11.f, 12.f).transposed().get(3, 0) == 4.f);
+}
+
+} // namespace
+
+int main()
+{
+	TestRandom();
+	TestTransforms();
+	TestInverseAccuracy();
+	TestConstant();
+	return test::Result();
+}
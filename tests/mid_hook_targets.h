@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// Defined in mid_hook_targets.S
+extern "C" {
+
+int mid_target(int x);
+extern const uint8_t mid_target_site[];
+extern const uint8_t mid_target_taken[];
+
+int mid_flags(int a, int b);
+extern const uint8_t mid_flags_site[];
+
+int mid_callee(int x);
+int mid_caller(int x);
+extern const uint8_t mid_caller_site[];
+
+#define MID_BENCH_TARGET(name) \
+	int name(int x); \
+	extern const uint8_t name##_site[]; \
+	extern const uint8_t name##_resume[];
+
+MID_BENCH_TARGET(mid_bench_plain)
+MID_BENCH_TARGET(mid_bench_live)
+MID_BENCH_TARGET(mid_bench_dead)
+MID_BENCH_TARGET(mid_bench_naked)
+
+#undef MID_BENCH_TARGET
+
+// Called by mid_bench_naked's stub with the saved registers
+extern bool (*mid_bench_naked_callback)(void *registers);
+
+}
@@ -0,0 +1,236 @@
+// Runs generated mid hook stubs on the functions in mid_hook_targets.S. Built
+// for x86_64 with the hooks library, and for i386 against a minimal runtime
+// when the compiler can target it.
+#include "mid_hook_targets.h"
+#include "test.h"
+#include "util/memory.h"
+#include "util/mid_hook.h"
+#include <climits>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+#ifdef __x86_64__
+// r8 to r11 at mid_target's site
+constexpr auto kTargetExtra = 10;
+// lea with an address size prefix, then add
+constexpr size_t kTargetSiteSize = 7;
+#else
+constexpr auto kTargetExtra = 0;
+constexpr size_t kTargetSiteSize = 6;
+#endif
+
+constexpr uintptr_t kFlag_CF = 1 << 0;
+constexpr uintptr_t kFlag_ZF = 1 << 6;
+constexpr uintptr_t kFlag_OF = 1 << 11;
+
+// Points the five byte jmp or call at site to dest until destroyed
+class RedirectSite {
+	void *site;
+	uint8_t saved[5];
+
+public:
+	RedirectSite(const void *site, uint8_t opcode, const void *dest) : site((void*)site)
+	{
+		memcpy(saved, site, sizeof(saved));
+
+		uint8_t code[5] = {opcode};
+		const auto rel32 = make_rel32(site, dest);
+		memcpy(code + 1, &rel32, sizeof(rel32));
+		patch_code(this->site, code, sizeof(code));
+	}
+
+	~RedirectSite()
+	{
+		patch_code(site, saved, sizeof(saved));
+	}
+};
+
+// Overwrites the caller saved registers and flags as any callback might
+void ClobberVolatile()
+{
+#ifdef __x86_64__
+	asm volatile(
+		"xor %%ecx, %%ecx; xor %%edx, %%edx; xor %%esi, %%esi; xor %%edi, %%edi\n\t"
+		"xor %%r8d, %%r8d; xor %%r9d, %%r9d; xor %%r10d, %%r10d; xor %%r11d, %%r11d"
+		: : : "rcx", "rdx", "rsi", "rdi", "r8", "r9", "r10", "r11", "cc");
+#else
+	asm volatile("xor %%ecx, %%ecx; xor %%edx, %%edx" : : : "ecx", "edx", "cc");
+#endif
+}
+
+struct {
+	uintptr_t bx;
+	uintptr_t si;
+	uint32_t sentinel;
+	uintptr_t flags;
+	uintptr_t returnAddress;
+} g_seen;
+
+bool g_writeSi;
+bool g_takeJump;
+uintptr_t g_flipFlags;
+
+bool TargetCallback(mid_hook_context *context)
+{
+	g_seen.bx = context->bx;
+	g_seen.si = context->si;
+	g_seen.sentinel = context->stack<uint32_t>(0);
+
+	if (g_writeSi)
+		context->si = 200;
+
+	ClobberVolatile();
+	return g_takeJump;
+}
+
+bool FlagsCallback(mid_hook_context *context)
+{
+	g_seen.flags = context->flags;
+	context->flags ^= g_flipFlags;
+	ClobberVolatile();
+	return false;
+}
+
+bool CallCallback(mid_hook_context *context)
+{
+	g_seen.returnAddress = context->stack<uintptr_t>(0);
+#ifdef __x86_64__
+	const auto x = (int)context->di;
+#else
+	const auto x = context->stack<int>(sizeof(uintptr_t));
+#endif
+	ClobberVolatile();
+
+	if (x != 7)
+		return false;
+
+	context->ax = 1000;
+	return true;
+}
+
+void TestSiteStub()
+{
+	CHECK(mid_target(5) == 152 + kTargetExtra);
+
+	const auto hook = mid_hook {
+		.callback    = TargetCallback,
+		.context     = MID_HOOK_BX | MID_HOOK_SI,
+		.jump_target = (uintptr_t)mid_target_taken
+	};
+
+	const auto stub = create_mid_hook_stub(mid_target_site, hook);
+	CHECK(stub.error == relocate_error::none);
+	CHECK(stub.source_size == kTargetSiteSize);
+
+	if (stub.code == nullptr)
+		return;
+
+	{
+		auto redirect = RedirectSite(mid_target_site, 0xE9, stub.code.get());
+
+		// Live caller saved registers survive the callback
+		g_seen = {};
+		CHECK(mid_target(5) == 152 + kTargetExtra);
+		CHECK(g_seen.bx == 5 && g_seen.si == 100);
+		CHECK(g_seen.sentinel == 0x5EED5EED);
+
+		g_writeSi = true;
+		CHECK(mid_target(5) == 252 + kTargetExtra);
+		g_writeSi = false;
+
+		g_takeJump = true;
+		CHECK(mid_target(5) == 40);
+		g_takeJump = false;
+	}
+
+	CHECK(mid_target(6) == 161 + kTargetExtra);
+}
+
+void TestFlags()
+{
+	const int cases[][2] = {{1, 1}, {0, 1}, {5, 3}, {-1, 0}, {INT_MIN, 1}, {INT_MAX, -1}};
+	int expected[std::size(cases)];
+
+	for (size_t i = 0; i < std::size(cases); i++)
+		expected[i] = mid_flags(cases[i][0], cases[i][1]);
+
+	CHECK(expected[0] & kFlag_ZF);
+	CHECK(expected[1] & kFlag_CF);
+	CHECK(expected[4] & kFlag_OF);
+
+	// The site's mov writes dx
+	const auto hook = mid_hook {
+		.callback = FlagsCallback,
+		.context  = MID_HOOK_FLAGS,
+		.dead     = MID_HOOK_DX
+	};
+
+	const auto stub = create_mid_hook_stub(mid_flags_site, hook);
+	CHECK(stub.error == relocate_error::none && stub.source_size == 5);
+
+	if (stub.code == nullptr)
+		return;
+
+	auto redirect = RedirectSite(mid_flags_site, 0xE9, stub.code.get());
+
+	for (size_t i = 0; i < std::size(cases); i++) {
+		g_seen.flags = 0;
+		CHECK(mid_flags(cases[i][0], cases[i][1]) == expected[i]);
+		CHECK(g_seen.flags == (uintptr_t)expected[i]);
+	}
+
+	// Written flags are restored, OF included
+	g_flipFlags = kFlag_OF | kFlag_ZF | kFlag_CF;
+
+	for (size_t i = 0; i < std::size(cases); i++)
+		CHECK(mid_flags(cases[i][0], cases[i][1]) == (int)(expected[i] ^ g_flipFlags));
+
+	g_flipFlags = 0;
+}
+
+void TestCallStub()
+{
+	CHECK(read_rel32(mid_caller_site) == (void*)mid_callee);
+
+	static const void *original = (const void*)mid_callee;
+
+	const auto hook = mid_hook {
+		.callback = CallCallback,
+#ifdef __x86_64__
+		.context  = MID_HOOK_AX | MID_HOOK_DI
+#else
+		.context  = MID_HOOK_AX
+#endif
+	};
+
+	const auto stub = create_mid_call_stub(hook, &original, mid_caller_site);
+	CHECK(stub != nullptr);
+
+	if (stub == nullptr)
+		return;
+
+	{
+		auto redirect = RedirectSite(mid_caller_site, 0xE8, stub.get());
+
+		g_seen.returnAddress = 0;
+		CHECK(mid_caller(5) == 11);
+		CHECK(g_seen.returnAddress == (uintptr_t)mid_caller_site + 5);
+
+		// Taking the jump returns ax to the caller
+		CHECK(mid_caller(7) == 1001);
+	}
+
+	CHECK(mid_caller(7) == 15);
+}
+
+} // namespace
+
+int main()
+{
+	TestSiteStub();
+	TestFlags();
+	TestCallStub();
+	return test::Result();
+}
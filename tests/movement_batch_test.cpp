@@ -0,0 +1,126 @@
+// UpdateVelocityBatch against UpdateVelocity for every profile
+#include "test.h"
+#include "ini.h"
+#include "movement.h"
+#include "movement_batch.h"
+#include "movement_profiles.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace movement;
+
+namespace {
+
+// Controllers in structure-of-arrays layout, with their scalar equivalents
+struct Controllers {
+	std::vector<float> velocity[3], forward[3], up[3], groundNormal[3];
+	std::vector<uint32_t> moveFlags;
+	std::vector<float> moveSpeed;
+	std::unique_ptr<bool[]> inAir;
+	std::vector<MoveParams> moves;
+	std::vector<MoveInput> inputs;
+	std::vector<vec3> velocities;
+
+	static void Push(std::vector<float> (&soa)[3], const vec3 &vector)
+	{
+		soa[0].push_back(vector.x);
+		soa[1].push_back(vector.y);
+		soa[2].push_back(vector.z);
+	}
+
+	explicit Controllers(size_t count, uint32_t seed)
+	{
+		auto rng = std::mt19937(seed);
+		auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+		inAir = std::make_unique<bool[]>(count);
+
+		for (size_t i = 0; i < count; i++) {
+			const auto forward = vec3(unit(rng), unit(rng), 0.f).normalized();
+			const auto normal = i % 3 != 0
+				? vec3(0.f, 0.f, 1.f)
+				: vec3(unit(rng) * .5f, unit(rng) * .5f, 1.f).normalized();
+
+			// Some at rest, some below the stop speed
+			const auto scale = i % 5 == 0 ? 0.f : i % 5 == 1 ? 2.f : 40.f;
+			const auto velocity = vec3(unit(rng), unit(rng), unit(rng) * .2f) * scale;
+
+			moves.push_back({.forward = forward, .up = vec3(0.f, 0.f, 1.f), .groundNormal = normal});
+			inputs.push_back({
+				.moveFlags = (uint32_t)rng() & kMoveMask,
+				.moveSpeed = 10.f + unit(rng) * 5.f,
+				.inAir     = (rng() & 1) != 0
+			});
+			velocities.push_back(velocity);
+
+			Push(this->velocity, velocity);
+			Push(this->forward, forward);
+			Push(up, moves.back().up);
+			Push(groundNormal, normal);
+
+			moveFlags.push_back(inputs.back().moveFlags);
+			moveSpeed.push_back(inputs.back().moveSpeed);
+			inAir[i] = inputs.back().inAir;
+		}
+	}
+
+	MoveBatch Batch()
+	{
+		return {
+			.count        = moves.size(),
+			.velocity     = {velocity[0].data(), velocity[1].data(), velocity[2].data()},
+			.forward      = {forward[0].data(), forward[1].data(), forward[2].data()},
+			.up           = {up[0].data(), up[1].data(), up[2].data()},
+			.groundNormal = {groundNormal[0].data(), groundNormal[1].data(), groundNormal[2].data()},
+			.moveFlags    = moveFlags.data(),
+			.moveSpeed    = moveSpeed.data(),
+			.inAir        = inAir.get()
+		};
+	}
+};
+
+// Largest difference between the batch and scalar results relative to the
+// result's speed
+float MaxError(const ini::Settings &snapshot, size_t count, const ProfileKernels &kernels)
+{
+	auto controllers = Controllers(count, (uint32_t)count);
+	constexpr auto deltaTime = 1.f / 60.f;
+	auto maxError = 0.f;
+
+	// Several steps so each lane runs from friction to acceleration
+	for (auto step = 0; step < 8; step++) {
+		UpdateVelocityBatch(snapshot, controllers.Batch(), kernels, deltaTime);
+
+		for (size_t i = 0; i < count; i++) {
+			auto &expected = controllers.velocities[i];
+			kernels.updateVelocity(snapshot, controllers.moves[i], controllers.inputs[i], &expected, deltaTime, Integrator::Euler);
+
+			const auto actual = vec3(
+				controllers.velocity[0][i], controllers.velocity[1][i], controllers.velocity[2][i]);
+
+			maxError = std::max(maxError, (actual - expected).length() / std::max(1.f, expected.length()));
+		}
+	}
+
+	return maxError;
+}
+
+} // namespace
+
+int main()
+{
+	// Counts with and without a scalar remainder
+	constexpr size_t counts[] = {1, 3, 4, 8, 13, 64, 1027};
+
+	for (const auto fastMath : {0, 1}) {
+		const auto snapshot = ini::Settings {.bFastMath = fastMath};
+
+		for (auto profile = 0; profile < 4; profile++) {
+			for (const auto count : counts)
+				CHECK(MaxError(snapshot, count, GetProfileKernels(profile)) < 1e-5f);
+		}
+	}
+
+	return test::Result();
+}
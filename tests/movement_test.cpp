@@ -0,0 +1,198 @@
+// Headless runs of the movement core
+#include "test.h"
+#include "ini.h"
+#include "movement.h"
+#include "movement_profiles.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace movement;
+
+namespace {
+
+// Tick and frame lengths are powers of two, so float time adds up exactly
+constexpr auto kTickTime = 1.f / 128.f;
+constexpr auto kSampleRate = 32;
+constexpr auto kDefaults = ini::Settings {};
+
+const auto kFlat = MoveParams {
+	.forward      = vec3(1.f, 0.f, 0.f),
+	.up           = vec3(0.f, 0.f, 1.f),
+	.groundNormal = vec3(0.f, 0.f, 1.f)
+};
+
+bool BitEqual(const vec3 &a, const vec3 &b)
+{
+	return memcmp(&a.x, &b.x, sizeof(float)) == 0 &&
+	       memcmp(&a.y, &b.y, sizeof(float)) == 0 &&
+	       memcmp(&a.z, &b.z, sizeof(float)) == 0;
+}
+
+// Output of a second of fixed steps driven at a frame rate, sampled every
+// 1/kSampleRate seconds. Forward is held for the first half.
+std::vector<vec3> RunFixed(int frameRate)
+{
+	auto state = FixedStepState();
+	auto velocity = vec3(0.f, 0.f, 0.f);
+	auto samples = std::vector<vec3>();
+	const auto frameTime = 1.f / (float)frameRate;
+
+	for (auto frame = 0; frame < frameRate; frame++) {
+		const auto input = MoveInput {
+			.moveFlags = frame < frameRate / 2 ? (uint32_t)kMoveFlag_Forward : 0u,
+			.moveSpeed = 10.f
+		};
+
+		UpdateVelocityFixed(kDefaults, kFlat, input, &state, &velocity, frameTime, kTickTime, 8);
+
+		// Output stays between the last two ticks
+		const auto low = std::min(state.previous.x, state.current.x);
+		const auto high = std::max(state.previous.x, state.current.x);
+		CHECK(velocity.x >= low && velocity.x <= high);
+
+		if ((frame + 1) % (frameRate / kSampleRate) == 0)
+			samples.push_back(velocity);
+	}
+
+	return samples;
+}
+
+// The same ticks run whatever the frame rate, including frames shorter than
+// a tick
+void TestFixedStepFrameRateIndependence()
+{
+	const auto reference = RunFixed(kSampleRate);
+	CHECK(reference.size() == kSampleRate);
+	CHECK(reference[kSampleRate / 2 - 1].x < 0.f);
+
+	for (const auto frameRate : {64, 128, 256, 1024}) {
+		const auto samples = RunFixed(frameRate);
+		CHECK(samples.size() == reference.size());
+
+		for (size_t i = 0; i < std::min(samples.size(), reference.size()); i++)
+			CHECK(BitEqual(samples[i], reference[i]));
+	}
+}
+
+void TestFixedStepRestart()
+{
+	const auto input = MoveInput {.moveFlags = kMoveFlag_Forward, .moveSpeed = 10.f};
+	auto state = FixedStepState();
+	auto velocity = vec3(0.f, 0.f, 0.f);
+
+	UpdateVelocityFixed(kDefaults, kFlat, input, &state, &velocity, .05f, kTickTime, 8);
+	CHECK(state.tickTime == kTickTime);
+	CHECK(velocity.x < 0.f);
+
+	// A new tick length drops the old ticks and accumulated time
+	auto restarted = state;
+	auto restartedVelocity = vec3(0.f, 0.f, 0.f);
+	UpdateVelocityFixed(kDefaults, kFlat, input, &restarted, &restartedVelocity, .001f, kTickTime * 2.f, 8);
+	CHECK(restarted.tickTime == kTickTime * 2.f);
+	CHECK(restarted.accumulator == .001f);
+	CHECK(BitEqual(restartedVelocity, vec3(0.f, 0.f, 0.f)));
+
+	// Frames longer than maxSubsteps ticks drop the excess
+	auto capped = FixedStepState();
+	auto cappedVelocity = vec3(0.f, 0.f, 0.f);
+	UpdateVelocityFixed(kDefaults, kFlat, input, &capped, &cappedVelocity, 1.f, kTickTime, 1);
+	CHECK(capped.accumulator == 0.f);
+	CHECK(capped.current.x < 0.f);
+}
+
+// Exact steps against Euler over many substeps, from random velocities
+// around the stop and max speeds
+float MaxExactError(const ini::Settings &settings)
+{
+	auto rng = std::mt19937(1);
+	auto unit = std::uniform_real_distribution<float>(-1.f, 1.f);
+	auto maxError = 0.f;
+
+	for (auto i = 0; i < 1000; i++) {
+		const auto normal = i % 3 != 0
+			? vec3(0.f, 0.f, 1.f)
+			: vec3(unit(rng) * .5f, unit(rng) * .5f, 1.f).normalized();
+		const auto move = MoveParams {
+			.forward      = vec3(1.f, 0.f, 0.f),
+			.up           = vec3(0.f, 0.f, 1.f),
+			.groundNormal = normal
+		};
+		const auto input = MoveInput {
+			.moveFlags = (uint32_t)rng() & kMoveMask,
+			.moveSpeed = 8.f + unit(rng) * 4.f
+		};
+		const auto scale = i % 4 == 0 ? 4.f : i % 4 == 1 ? 12.f : 30.f;
+		const auto start = vec3(unit(rng), unit(rng), 0.f) * scale;
+		const auto deltaTime = i % 2 == 0 ? 1.f / 60.f : 1.f / 30.f;
+
+		auto exact = start;
+		UpdateVelocity(settings, move, input, &exact, deltaTime, Integrator::Exact);
+
+		auto euler = start;
+		for (auto step = 0; step < 4096; step++)
+			UpdateVelocity(settings, move, input, &euler, deltaTime / 4096.f, Integrator::Euler);
+
+		maxError = std::max(maxError, (exact - euler).length() / std::max(1.f, euler.length()));
+	}
+
+	return maxError;
+}
+
+void TestExact()
+{
+	CHECK(MaxExactError({}) < 1e-3f);
+	CHECK(MaxExactError({.fStopSpeed = 0.f}) < 1e-3f);
+	CHECK(MaxExactError({.fAcceleration = 0.f}) < 1e-3f);
+	CHECK(MaxExactError({.fFriction = 8.f, .fAcceleration = 2.f}) < 1e-3f);
+
+	// Starting at rest with no stop speed isn't crossing below it
+	auto velocity = vec3(0.f, 0.f, 0.f);
+	UpdateVelocity(
+		{.fStopSpeed = 0.f}, kFlat, {.moveFlags = kMoveFlag_Forward, .moveSpeed = 10.f}, &velocity, .03f,
+		Integrator::Exact);
+	CHECK_NEAR(velocity.x, -4.1788f, 1e-3f);
+}
+
+// Profiles only replace the movement tunables, so a profile holding the INI
+// defaults steps exactly like the defaults, with the snapshot's bFastMath
+void TestProfileOwnership()
+{
+	using Default = ConstantProfile<profiles::Default>;
+
+	const auto slope = MoveParams {
+		.forward      = vec3(1.f, 0.f, 0.f),
+		.up           = vec3(0.f, 0.f, 1.f),
+		.groundNormal = vec3(.3f, .1f, 1.f).normalized()
+	};
+	const auto input = MoveInput {.moveFlags = kMoveFlag_Forward | kMoveFlag_Left, .moveSpeed = 10.f};
+
+	for (const auto fastMath : {0, 1}) {
+		const auto snapshot = ini::Settings {.bFastMath = fastMath};
+		auto runtime = vec3(3.f, -7.f, 0.f);
+		auto constant = runtime;
+
+		for (auto step = 0; step < 16; step++) {
+			UpdateVelocity<RuntimeProfile>(snapshot, slope, input, &runtime, 1.f / 60.f);
+			UpdateVelocity<Default>(snapshot, slope, input, &constant, 1.f / 60.f);
+		}
+
+		CHECK(BitEqual(runtime, constant));
+
+		const auto air = vec3(1.f, 2.f, -30.f);
+		CHECK(GetLandingPenalty<RuntimeProfile>(snapshot, runtime, air) ==
+		      GetLandingPenalty<Default>(snapshot, constant, air));
+	}
+}
+
+} // namespace
+
+int main()
+{
+	TestFixedStepFrameRateIndependence();
+	TestFixedStepRestart();
+	TestExact();
+	TestProfileOwnership();
+	return test::Result();
+}
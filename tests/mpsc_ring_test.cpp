@@ -0,0 +1,100 @@
+#include "test.h"
+#include "util/mpsc_ring.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Item {
+	uint32_t producer;
+	uint32_t value;
+	uint32_t index;
+};
+
+void TestOrder()
+{
+	mpsc_ring<Item, 4> ring;
+
+	for (uint32_t i = 0; i < 4; i++)
+		CHECK(ring.push([&](Item &item, uint32_t index) { item = {0, i * 10, index}; }));
+
+	CHECK(!ring.push([](Item&, uint32_t) {}));
+
+	// Stopping early leaves the rest in place
+	auto seen = std::vector<Item>();
+	CHECK(ring.consume([&](const Item &item) {
+		seen.push_back(item);
+		return seen.size() < 2;
+	}) == 1);
+
+	CHECK(ring.consume([&](const Item &item) {
+		seen.push_back(item);
+		return true;
+	}) == 3);
+
+	// The refused item is seen again
+	constexpr uint32_t expected[] = {0, 1, 1, 2, 3};
+	CHECK(seen.size() == 5);
+
+	for (size_t i = 0; i < std::min(seen.size(), std::size(expected)); i++)
+		CHECK(seen[i].index == expected[i] && seen[i].value == expected[i] * 10);
+
+	// Indices keep counting across laps
+	CHECK(ring.push([](Item &item, uint32_t index) { item = {0, 0, index}; }));
+	ring.consume([](const Item &item) { CHECK(item.index == 4); return true; });
+}
+
+void TestProducers()
+{
+	constexpr uint32_t producerCount = 4;
+	constexpr uint32_t perProducer = 20000;
+	static mpsc_ring<Item, 1024> ring;
+
+	std::atomic<uint32_t> running = producerCount;
+	std::vector<std::thread> producers;
+
+	for (uint32_t p = 0; p < producerCount; p++) {
+		producers.emplace_back([&, p] {
+			for (uint32_t i = 0; i < perProducer; i++) {
+				while (!ring.push([&](Item &item, uint32_t index) { item = {p, i, index}; }))
+					std::this_thread::yield();
+			}
+
+			running--;
+		});
+	}
+
+	// Each producer's items arrive once and in order, and indices count up
+	uint32_t next[producerCount] = {};
+	auto nextIndex = 0u;
+	auto ordered = true;
+
+	const auto take = [&](const Item &item) {
+		ordered &= item.index == nextIndex++ && item.value == next[item.producer]++;
+		return true;
+	};
+
+	while (running > 0)
+		ring.consume(take);
+
+	for (auto &producer : producers)
+		producer.join();
+
+	ring.consume(take);
+	CHECK(ordered);
+
+	for (const auto count : next)
+		CHECK(count == perProducer);
+}
+
+} // namespace
+
+int main()
+{
+	TestOrder();
+	TestProducers();
+	return test::Result();
+}
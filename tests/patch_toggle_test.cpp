@@ -0,0 +1,199 @@
+// Commits and reverts a patch set over and over while other threads run the
+// patched code, as SetPlayerPhysicsEnabled does. Every call has to return
+// either the hooked or the unhooked result.
+#include "mid_hook_targets.h"
+#include "test.h"
+#include "util/patch_transaction.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+#ifdef __x86_64__
+constexpr auto kTargetExtra = 10;
+#else
+constexpr auto kTargetExtra = 0;
+#endif
+
+constexpr auto kThreadCount = 4;
+constexpr auto kToggles = 200;
+
+constexpr auto kFlag_ZF = 1 << 6;
+
+bool TargetCallback(mid_hook_context *context)
+{
+	if (context->bx == 10)
+		return true;
+
+	context->si = 200;
+	return false;
+}
+
+bool CallCallback(mid_hook_context *context)
+{
+	if (context->di != 0)
+		return false;
+
+	context->ax = 1234;
+	return true;
+}
+
+bool FlagsCallback(mid_hook_context *context)
+{
+	context->flags ^= kFlag_ZF;
+	return false;
+}
+
+void TestToggle(bool shared)
+{
+	const auto flags = mid_flags(3, 5);
+
+	const patch_entry manifest[] = {
+		{
+			.kind    = patch_kind::mid,
+			.address = (uintptr_t)mid_target_site,
+			.mid     = {
+				.callback    = TargetCallback,
+				.context     = MID_HOOK_BX | MID_HOOK_SI,
+				.jump_target = (uintptr_t)mid_target_taken
+			}
+		},
+		{
+			.kind     = patch_kind::call_rel32,
+			.address  = (uintptr_t)mid_caller_site,
+			.original = &detail::hook::static_original<CallCallback>,
+			.shared   = shared,
+			.mid      = {
+				.callback = CallCallback,
+				.context  = MID_HOOK_AX | MID_HOOK_DI,
+				.dead     = MID_HOOK_FLAGS
+			}
+		},
+		{
+			.kind    = patch_kind::mid,
+			.address = (uintptr_t)mid_flags_site,
+			.mid     = {
+				.callback    = FlagsCallback,
+				.context     = MID_HOOK_FLAGS,
+				.dead        = MID_HOOK_CX | MID_HOOK_DX,
+				// Never taken, past the mov
+				.jump_target = (uintptr_t)mid_flags_site + 5
+			}
+		}
+	};
+
+	auto patches = patch_transaction();
+	patches.add(manifest);
+
+	std::atomic<bool> stop = false;
+	std::atomic<int> wrong = 0;
+	std::atomic<int> started = 0;
+	std::atomic<bool> sawHooked = false;
+	std::atomic<bool> sawUnhooked = false;
+	std::vector<std::thread> threads;
+
+	for (auto i = 0; i < kThreadCount; i++) {
+		threads.emplace_back([&] {
+			started++;
+
+			while (!stop.load(std::memory_order_relaxed)) {
+				const auto a = mid_target(5);
+				const auto b = mid_target(10);
+				const auto c = mid_caller(0);
+				const auto d = mid_caller(3);
+				const auto e = mid_flags(3, 5);
+
+				if ((a != 152 + kTargetExtra && a != 252 + kTargetExtra) ||
+				    (b != 197 + kTargetExtra && b != 80) ||
+				    (c != 1 && c != 1235) || d != 7 ||
+				    (e != flags && e != (flags ^ kFlag_ZF)))
+					wrong++;
+
+				if (a == 252 + kTargetExtra)
+					sawHooked = true;
+				else
+					sawUnhooked = true;
+			}
+		});
+	}
+
+	while (started < kThreadCount)
+		std::this_thread::yield();
+
+	auto failed = 0;
+
+	for (auto i = 0; i < kToggles; i++) {
+		if (!(i % 2 == 0 ? patches.commit() : patches.revert()))
+			failed++;
+
+		// Let the threads run some of each state
+		std::this_thread::yield();
+	}
+
+	stop = true;
+
+	for (auto &thread : threads)
+		thread.join();
+
+	CHECK(failed == 0);
+	CHECK(wrong == 0);
+	CHECK(sawHooked && sawUnhooked);
+	CHECK(!patches.is_committed());
+
+	// Reverted cleanly
+	CHECK(mid_target(5) == 152 + kTargetExtra);
+	CHECK(mid_caller(0) == 1);
+	CHECK(mid_flags(3, 5) == flags);
+}
+
+bool OtherCallCallback(mid_hook_context *context)
+{
+	context->ax = 99;
+	return true;
+}
+
+patch_entry CallEntry(bool (*callback)(mid_hook_context*), const void **original)
+{
+	return {
+		.kind     = patch_kind::call_rel32,
+		.address  = (uintptr_t)mid_caller_site,
+		.original = original,
+		.mid      = {.callback = callback, .context = MID_HOOK_AX}
+	};
+}
+
+// Another module patching a site while ours is reverted keeps its patch, and
+// ours can be committed again once it's gone
+void TestPatchedWhileReverted()
+{
+	auto patches = patch_transaction();
+	patches.add(CallEntry(CallCallback, &detail::hook::static_original<CallCallback>));
+	CHECK(patches.commit());
+	CHECK(patches.revert());
+
+	{
+		auto other = patch_transaction();
+		other.add(CallEntry(OtherCallCallback, &detail::hook::static_original<OtherCallCallback>));
+		CHECK(other.commit());
+
+		CHECK(!patches.commit());
+		CHECK(!patches.is_committed());
+		CHECK(mid_caller(0) == 100);
+	}
+
+	CHECK(mid_caller(0) == 1);
+	CHECK(patches.commit());
+	CHECK(mid_caller(0) == 1235);
+	CHECK(patches.revert());
+}
+
+} // namespace
+
+int main()
+{
+	TestToggle(false);
+	TestToggle(true);
+	TestPatchedWhileReverted();
+	return test::Result();
+}
@@ -0,0 +1,148 @@
+// The SSE quat path against the scalar path, bit for bit, and rotations
+// against their matrices, over random inputs
+#include "test.h"
+#include "util/quat.h"
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace {
+
+constexpr auto kCases = 200000;
+
+std::mt19937 g_rng(3);
+
+float Unit()
+{
+	return std::uniform_real_distribution<float>(-1.f, 1.f)(g_rng);
+}
+
+float RandomFloat()
+{
+	switch (g_rng() % 12) {
+	case 0:  return std::bit_cast<float>((uint32_t)g_rng());
+	case 1:  return g_rng() % 2 != 0 ? -0.f : 0.f;
+	case 2:  return g_rng() % 2 != 0 ? INFINITY : -INFINITY;
+	case 3:  return std::bit_cast<float>((uint32_t)g_rng() & 0x807FFFFF);
+	default: return Unit() * 5.f;
+	}
+}
+
+// Equal bits, or both NaN with any payload
+bool BitEqual(float a, float b)
+{
+	return std::bit_cast<uint32_t>(a) == std::bit_cast<uint32_t>(b) || (std::isnan(a) && std::isnan(b));
+}
+
+template<typename V>
+bool BitEqual(const V &a, const V &b)
+{
+	auto equal = true;
+	a.foreach([&](float x, float y) { equal = equal && BitEqual(x, y); }, b.elems());
+	return equal;
+}
+
+quat RandomRotation()
+{
+	return quat(Unit(), Unit(), Unit(), Unit()).normalized();
+}
+
+vec3 Multiply(const matrix3x3 &m, const vec3 &v)
+{
+	const auto product = m * matrix<float, 3, 1>(v.x, v.y, v.z);
+	return vec3(product.elems[0], product.elems[1], product.elems[2]);
+}
+
+void TestRandom()
+{
+	for (auto i = 0; i < kCases && test::failures == 0; i++) {
+		const auto a = quat(RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat());
+		const auto b = quat(RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat());
+		const auto v = vec3(RandomFloat(), RandomFloat(), RandomFloat());
+
+		CHECK(BitEqual(quat::multiply(a, b), detail::quat_scalar::multiply(a, b)));
+		CHECK(BitEqual(quat::rotate(a, v), detail::quat_scalar::rotate(a, v)));
+	}
+}
+
+// Errors against the matrix form and between equivalent rotations, for unit
+// quaternions
+void TestAccuracy()
+{
+	auto matrixError = 0.f;
+	auto lengthError = 0.f;
+	auto fromMatrixError = 0.f;
+	auto composeError = 0.f;
+	auto slerpError = 0.f;
+
+	for (auto i = 0; i < kCases; i++) {
+		const auto p = RandomRotation();
+		const auto q = RandomRotation();
+		const auto v = vec3(Unit(), Unit(), Unit());
+		const auto m = quat::to_matrix(p);
+		const auto rotated = quat::rotate(p, v);
+
+		matrixError = std::max(matrixError, (rotated - Multiply(m, v)).length());
+		lengthError = std::max(lengthError, std::abs(rotated.length() - v.length()));
+
+		// q and -q are the same rotation
+		fromMatrixError = std::max(fromMatrixError, 1.f - std::abs(quat::dot(quat::from_matrix(m), p)));
+
+		const auto composed = quat::rotate(quat::multiply(p, q), v);
+		composeError = std::max(composeError, (composed - quat::rotate(p, quat::rotate(q, v))).length());
+
+		// Ends at either input, and at a constant angular speed between
+		const auto half = quat::slerp(p, q, .5f);
+		slerpError = std::max(slerpError, 1.f - std::abs(quat::dot(quat::slerp(p, q, 0.f), p)));
+		slerpError = std::max(slerpError, 1.f - std::abs(quat::dot(quat::slerp(p, q, 1.f), q)));
+		slerpError = std::max(slerpError, std::abs(std::abs(quat::dot(p, half)) - std::abs(quat::dot(half, q))));
+
+		// nlerp only guarantees the ends and the shorter arc
+		CHECK(std::abs(quat::nlerp(p, q, .3f).length() - 1.f) < 1e-6f);
+		CHECK(quat::dot(quat::nlerp(p, q, 0.f), p) > 1.f - 1e-6f);
+	}
+
+	CHECK(matrixError < 2e-6f);
+	CHECK(lengthError < 2e-6f);
+	CHECK(fromMatrixError < 2e-6f);
+	CHECK(composeError < 4e-6f);
+	CHECK(slerpError < 2e-6f);
+}
+
+void TestKnown()
+{
+	const auto z90 = quat::from_axis_angle(vec3(0.f, 0.f, 1.f), std::numbers::pi_v<float> / 2.f);
+	const auto x = quat::rotate(z90, vec3(1.f, 0.f, 0.f));
+	CHECK_NEAR(x.x, 0.f, 1e-6f);
+	CHECK_NEAR(x.y, 1.f, 1e-6f);
+	CHECK_NEAR(x.z, 0.f, 1e-6f);
+
+	// Right operand first
+	const auto x90 = quat::from_axis_angle(vec3(1.f, 0.f, 0.f), std::numbers::pi_v<float> / 2.f);
+	const auto y = quat::rotate(quat::multiply(x90, z90), vec3(1.f, 0.f, 0.f));
+	CHECK_NEAR(y.x, 0.f, 1e-6f);
+	CHECK_NEAR(y.y, 0.f, 1e-6f);
+	CHECK_NEAR(y.z, 1.f, 1e-6f);
+
+	CHECK((quat::multiply(z90, quat::conjugate(z90)) - quat::identity()).length() < 1e-6f);
+}
+
+void TestConstant()
+{
+	constexpr auto r = quat::rotate(quat(0.f, 0.f, .70710678f, .70710678f), vec3(1.f, 0.f, 0.f));
+	static_assert(r.y > .99f && r.x < 1e-6f);
+	static_assert(quat::multiply(quat::identity(), quat(1.f, 2.f, 3.f, 4.f)) == quat(1.f, 2.f, 3.f, 4.f));
+	static_assert(quat::to_matrix(quat::identity()).get(2, 2) == 1.f);
+}
+
+} // namespace
+
+int main()
+{
+	TestRandom();
+	TestAccuracy();
+	TestKnown();
+	TestConstant();
+	return test::Result();
+}
@@ -0,0 +1,160 @@
+// relocate_code on synthetic prologues, relocated between two buffers
+#include "test.h"
+#include "util/hooks.h"
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+constexpr size_t kJmpSize = 5;
+
+// Sources and the destination live in this image, within rel32 reach
+alignas(16) uint8_t g_dest[64];
+
+// Where the rel32 at offset in g_dest points. Addresses are compared as
+// integers, as pointers into different arrays never compare equal to the
+// compiler.
+uintptr_t Rel32Target(size_t offset, size_t instructionEnd)
+{
+	int32_t rel;
+	memcpy(&rel, g_dest + offset, sizeof(rel));
+	return (uintptr_t)g_dest + instructionEnd + rel;
+}
+
+uintptr_t Address(const uint8_t *source, ptrdiff_t offset)
+{
+	return (uintptr_t)source + offset;
+}
+
+relocate_result Relocate(const uint8_t *source)
+{
+	memset(g_dest, 0xCC, sizeof(g_dest));
+	const auto measured = relocate_code(source, kJmpSize);
+	const auto result = relocate_code(source, kJmpSize, g_dest);
+
+	// Measuring agrees with relocating
+	CHECK(measured.source_size == result.source_size);
+	CHECK(measured.code_size == result.code_size);
+	CHECK(measured.error == result.error);
+	return result;
+}
+
+void TestShortJccWidening()
+{
+	// je +0x10; nop x3
+	static const uint8_t source[] = {0x74, 0x10, 0x90, 0x90, 0x90, 0xCC};
+	const auto result = Relocate(source);
+
+	CHECK(result.error == relocate_error::none);
+	CHECK(result.source_size == 5);
+	CHECK(result.code_size == 9);
+	CHECK(g_dest[0] == 0x0F && g_dest[1] == 0x84);
+	CHECK(Rel32Target(2, 6) == Address(source, 2 + 0x10));
+	CHECK(memcmp(g_dest + 6, source + 2, 3) == 0);
+}
+
+void TestShortJmpWidening()
+{
+	// nop x4; jmp -0x20, which may end the relocated bytes
+	static const uint8_t source[] = {0x90, 0x90, 0x90, 0x90, 0xEB, 0xE0};
+	const auto result = Relocate(source);
+
+	CHECK(result.error == relocate_error::none);
+	CHECK(result.source_size == 6);
+	CHECK(result.code_size == 9);
+	CHECK(g_dest[4] == 0xE9);
+	CHECK(Rel32Target(5, 9) == Address(source, 6 - 0x20));
+}
+
+void TestNearBranches()
+{
+	// call +0x1000; jne +0x200 (0F 85)
+	static const uint8_t source[] = {
+		0xE8, 0x00, 0x10, 0x00, 0x00,
+		0x0F, 0x85, 0x00, 0x02, 0x00, 0x00
+	};
+
+	const auto result = relocate_code(source, 6, g_dest);
+	CHECK(result.error == relocate_error::none);
+	CHECK(result.source_size == 11);
+	CHECK(result.code_size == 11);
+	CHECK(g_dest[0] == 0xE8);
+	CHECK(Rel32Target(1, 5) == Address(source, 5 + 0x1000));
+	CHECK(g_dest[5] == 0x0F && g_dest[6] == 0x85);
+	CHECK(Rel32Target(7, 11) == Address(source, 11 + 0x200));
+}
+
+#ifdef __x86_64__
+void TestRipRelative()
+{
+	// mov eax, [rip+0x100]; lea rcx, [rip-0x40]
+	static const uint8_t source[] = {
+		0x8B, 0x05, 0x00, 0x01, 0x00, 0x00,
+		0x48, 0x8D, 0x0D, 0xC0, 0xFF, 0xFF, 0xFF
+	};
+
+	const auto result = relocate_code(source, 7, g_dest);
+	CHECK(result.error == relocate_error::none);
+	CHECK(result.source_size == 13);
+	CHECK(result.code_size == 13);
+	CHECK(g_dest[0] == 0x8B && g_dest[1] == 0x05);
+	CHECK(Rel32Target(2, 6) == Address(source, 6 + 0x100));
+	CHECK(g_dest[6] == 0x48 && g_dest[7] == 0x8D && g_dest[8] == 0x0D);
+	CHECK(Rel32Target(9, 13) == Address(source, 13 - 0x40));
+}
+#endif
+
+void TestRefused()
+{
+	const auto error = [](const uint8_t *source) {
+		return Relocate(source).error;
+	};
+
+	// ret before the hook jmp fits
+	static const uint8_t ret[] = {0x90, 0xC3, 0xCC, 0xCC, 0xCC, 0xCC};
+	CHECK(error(ret) == relocate_error::function_too_short);
+
+	// jmp, likewise
+	static const uint8_t jmp[] = {0xEB, 0x10, 0xCC, 0xCC, 0xCC, 0xCC};
+	CHECK(error(jmp) == relocate_error::function_too_short);
+
+	// jcxz and loop have no rel32 form
+	static const uint8_t jcxz[] = {0xE3, 0x10, 0x90, 0x90, 0x90, 0x90};
+	CHECK(error(jcxz) == relocate_error::unsupported_branch);
+
+	static const uint8_t loop[] = {0xE2, 0x10, 0x90, 0x90, 0x90, 0x90};
+	CHECK(error(loop) == relocate_error::unsupported_branch);
+
+	// An operand size prefix changes the branch's displacement size
+	static const uint8_t prefixed[] = {0x66, 0xE9, 0x10, 0x00, 0x90, 0x90, 0x90};
+	CHECK(error(prefixed) == relocate_error::unsupported_branch);
+
+	// je +1 lands inside the hook jmp
+	static const uint8_t into[] = {0x74, 0x01, 0x90, 0x90, 0x90, 0x90};
+	CHECK(error(into) == relocate_error::branch_into_patch);
+
+#ifdef __x86_64__
+	// push es doesn't exist in 64 bit mode
+	static const uint8_t invalid[] = {0x06, 0x90, 0x90, 0x90, 0x90, 0x90};
+	CHECK(error(invalid) == relocate_error::invalid_instruction);
+
+	// A destination beyond rel32 reach of the branch target
+	static const uint8_t far[] = {0x74, 0x10, 0x90, 0x90, 0x90, 0xCC};
+	auto *farDest = (void*)((uintptr_t)far + ((uintptr_t)1 << 33));
+	CHECK(relocate_code(far, kJmpSize, farDest).error == relocate_error::out_of_reach);
+#endif
+}
+
+} // namespace
+
+int main()
+{
+	TestShortJccWidening();
+	TestShortJmpWidening();
+	TestNearBranches();
+#ifdef __x86_64__
+	TestRipRelative();
+#endif
+	TestRefused();
+	return test::Result();
+}
@@ -0,0 +1,170 @@
+#include "test.h"
+#include "util/state_table.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_constructed;
+int g_destroyed;
+
+struct Counted {
+	int value = 0;
+
+	Counted() { g_constructed++; }
+	~Counted() { g_destroyed++; }
+};
+
+// Keys as aligned as real objects
+const void *Key(size_t i)
+{
+	return (const void*)(0x10000 + i * 0x40);
+}
+
+void TestLifetime()
+{
+	g_constructed = g_destroyed = 0;
+
+	{
+		state_table<Counted, 16> table;
+		CHECK(g_constructed == 0);
+
+		auto *value = table.find_or_insert(Key(1));
+		CHECK(value != nullptr && g_constructed == 1);
+		value->value = 5;
+		CHECK(table.find_or_insert(Key(1)) == value && g_constructed == 1);
+		CHECK(table.find(Key(1))->value == 5);
+
+		// Only destroyed, not replaced with a fresh value
+		table.erase(Key(1));
+		CHECK(g_constructed == 1 && g_destroyed == 1);
+		CHECK(table.find(Key(1)) == nullptr);
+
+		CHECK(table.find_or_insert(Key(1))->value == 0);
+		CHECK(table.find_or_insert(Key(2)) != nullptr);
+		CHECK(g_constructed == 3 && g_destroyed == 1);
+	}
+
+	// Live values go with the table
+	CHECK(g_destroyed == 3);
+}
+
+void TestProbing()
+{
+	state_table<int, 8> table;
+
+	for (size_t i = 0; i < 8; i++)
+		*table.find_or_insert(Key(i)) = (int)i;
+
+	CHECK(table.find_or_insert(Key(8)) == nullptr);
+
+	// Keys past a tombstone stay reachable, and the tombstone is reused
+	table.erase(Key(3));
+
+	for (size_t i = 0; i < 8; i++)
+		CHECK(i == 3 ? table.find(Key(i)) == nullptr : *table.find(Key(i)) == (int)i);
+
+	CHECK(table.find_or_insert(Key(8)) != nullptr);
+	CHECK(table.find(nullptr) == nullptr);
+	CHECK(table.find_or_insert(nullptr) == nullptr);
+}
+
+void TestConcurrentInserts()
+{
+	constexpr size_t threadCount = 4;
+	constexpr size_t perThread = 200;
+	static state_table<size_t, 1024> table;
+	std::vector<std::thread> threads;
+
+	for (size_t t = 0; t < threadCount; t++) {
+		threads.emplace_back([t] {
+			for (size_t i = 0; i < perThread; i++)
+				*table.find_or_insert(Key(t * perThread + i)) = t * perThread + i;
+		});
+	}
+
+	for (auto &thread : threads)
+		thread.join();
+
+	for (size_t i = 0; i < threadCount * perThread; i++) {
+		const auto *value = table.find(Key(i));
+		CHECK(value != nullptr && *value == i);
+	}
+}
+
+// Controllers are recreated on every cell load, so the table sees far more
+// keys over time than it holds at once
+void TestChurn()
+{
+	constexpr size_t live = 16;
+	state_table<size_t, 64> table;
+
+	for (size_t i = 0; i < live; i++)
+		*table.find_or_insert(Key(i)) = i;
+
+	for (size_t i = live; i < 100000 && test::failures == 0; i++) {
+		table.erase(Key(i - live));
+		CHECK(table.find(Key(i - live)) == nullptr);
+
+		auto *value = table.find_or_insert(Key(i));
+		CHECK(value != nullptr && *value == 0);
+
+		if (value != nullptr)
+			*value = i;
+	}
+
+	for (size_t i = 100000 - live; i < 100000; i++) {
+		const auto *value = table.find(Key(i));
+		CHECK(value != nullptr && *value == i);
+	}
+}
+
+// Another thread looks the key up from inside its value's constructor, which
+// must not find the value yet
+struct LookupWhileConstructing;
+
+state_table<LookupWhileConstructing, 16> *g_lookupTable;
+std::atomic<int> g_lookupStage;
+bool g_foundEarly;
+
+struct LookupWhileConstructing {
+	LookupWhileConstructing()
+	{
+		g_lookupStage = 1;
+
+		while (g_lookupStage != 2)
+			std::this_thread::yield();
+	}
+};
+
+void TestPublishOrder()
+{
+	static state_table<LookupWhileConstructing, 16> table;
+	g_lookupTable = &table;
+
+	auto finder = std::thread([] {
+		while (g_lookupStage != 1)
+			std::this_thread::yield();
+
+		g_foundEarly = g_lookupTable->find(Key(1)) != nullptr;
+		g_lookupStage = 2;
+	});
+
+	CHECK(table.find_or_insert(Key(1)) != nullptr);
+	finder.join();
+	CHECK(!g_foundEarly);
+	CHECK(table.find(Key(1)) != nullptr);
+}
+
+} // namespace
+
+int main()
+{
+	TestLifetime();
+	TestProbing();
+	TestConcurrentInserts();
+	TestChurn();
+	TestPublishOrder();
+	return test::Result();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+// Checks for the test executables. Failed checks are reported and counted
+// rather than stopping the test, and Result fails the run if any were.
+namespace test {
+
+inline int failures;
+
+inline bool Check(bool passed, const char *expression, const char *file, int line)
+{
+	if (!passed) {
+		fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+		failures++;
+	}
+
+	return passed;
+}
+
+inline bool CheckNear(double a, double b, double tolerance, const char *expression, const char *file, int line)
+{
+	if (std::abs(a - b) <= tolerance)
+		return true;
+
+	fprintf(stderr, "%s:%d: check failed: %s (%g vs %g)\n", file, line, expression, a, b);
+	failures++;
+	return false;
+}
+
+// Exit code for main
+inline int Result()
+{
+	if (failures != 0)
+		fprintf(stderr, "%d checks failed\n", failures);
+
+	return failures != 0;
+}
+
+} // namespace test
+
+#define CHECK(...) test::Check((bool)(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+#define CHECK_NEAR(a, b, tolerance) test::CheckNear((a), (b), (tolerance), #a " ~ " #b, __FILE__, __LINE__)
@@ -0,0 +1,92 @@
+// Stops running and blocked threads with thread_freeze. Built against
+// thread_freeze_win.cpp on Windows and thread_freeze_posix.cpp elsewhere.
+#include "test.h"
+#include "util/thread_freeze.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr auto kSpinnerCount = 3;
+
+struct alignas(64) Counter {
+	std::atomic<uint64_t> value = 0;
+};
+
+void TestFreeze()
+{
+	std::atomic<bool> stop = false;
+	Counter counters[kSpinnerCount];
+	std::vector<std::thread> threads;
+
+	for (auto &counter : counters) {
+		threads.emplace_back([&] {
+			while (!stop.load(std::memory_order_relaxed))
+				counter.value.fetch_add(1, std::memory_order_relaxed);
+		});
+	}
+
+	// Blocked in the kernel rather than spinning
+	threads.emplace_back([&] {
+		while (!stop.load(std::memory_order_relaxed))
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	});
+
+	for (auto &counter : counters) {
+		while (counter.value.load(std::memory_order_relaxed) == 0)
+			std::this_thread::yield();
+	}
+
+	for (auto round = 0; round < 50; round++) {
+		uint64_t before[kSpinnerCount];
+
+		{
+			const auto freeze = thread_freeze();
+			CHECK(freeze.is_complete());
+
+			const auto ips = freeze.get_instruction_pointers();
+			CHECK(ips.size() >= threads.size());
+
+			// Resuming at an address isn't resuming partway into it
+			if (!ips.empty()) {
+				const auto ip = ips[0];
+				CHECK(!freeze.any_inside((const void*)ip, 1));
+				CHECK(freeze.any_inside((const void*)(ip - 1), 2));
+			}
+
+			for (auto i = 0; i < kSpinnerCount; i++)
+				before[i] = counters[i].value.load(std::memory_order_relaxed);
+
+			if (round % 10 == 0)
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+			for (auto i = 0; i < kSpinnerCount; i++)
+				CHECK(counters[i].value.load(std::memory_order_relaxed) == before[i]);
+		}
+
+		// And running again afterwards
+		for (auto i = 0; i < kSpinnerCount; i++) {
+			while (counters[i].value.load(std::memory_order_relaxed) == before[i])
+				std::this_thread::yield();
+		}
+	}
+
+	stop = true;
+
+	for (auto &thread : threads)
+		thread.join();
+
+	// Nothing left to stop
+	const auto freeze = thread_freeze();
+	CHECK(freeze.is_complete());
+}
+
+} // namespace
+
+int main()
+{
+	TestFreeze();
+	return test::Result();
+}
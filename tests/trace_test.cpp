@@ -0,0 +1,79 @@
+// Records from several threads through to the trace file
+#include "test.h"
+#include "trace.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void TestRecordAndReadBack()
+{
+	constexpr uint32_t threadCount = 4;
+	constexpr uint32_t perThread = 1000;
+	const auto path = (std::filesystem::temp_directory_path() / "trace_test.trace").string();
+
+	CHECK(trace::Start(path.c_str(), threadCount * perThread));
+	CHECK(trace::IsRecording());
+	CHECK(!trace::Start(path.c_str(), 1));
+
+	std::vector<std::thread> threads;
+
+	for (uint32_t t = 0; t < threadCount; t++) {
+		threads.emplace_back([t] {
+			for (uint32_t i = 0; i < perThread; i++) {
+				trace::Record({.controller = t, .moveFlags = i});
+
+				// Stay within the ring between flushes
+				if (i % 256 == 255)
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			}
+		});
+	}
+
+	for (auto &thread : threads)
+		thread.join();
+
+	trace::Stop();
+	CHECK(!trace::IsRecording());
+
+	auto *file = fopen(path.c_str(), "rb");
+	CHECK(file != nullptr);
+
+	if (file == nullptr)
+		return;
+
+	auto header = trace::TraceHeader();
+	CHECK(fread(&header, sizeof(header), 1, file) == 1);
+	CHECK(header.magic == trace::kTraceMagic && header.recordSize == sizeof(trace::TraceRecord));
+	CHECK(header.recordCount + header.droppedCount == threadCount * perThread);
+
+	// Sequence numbers count up, and each thread's records keep their order
+	auto records = std::vector<trace::TraceRecord>(header.recordCount);
+	CHECK(fread(records.data(), sizeof(trace::TraceRecord), records.size(), file) == records.size());
+	fseek(file, 0, SEEK_END);
+	CHECK(ftell(file) == (long)(sizeof(header) + records.size() * sizeof(trace::TraceRecord)));
+	fclose(file);
+	std::filesystem::remove(path);
+
+	int64_t last[threadCount] = {-1, -1, -1, -1};
+
+	for (size_t i = 1; i < records.size(); i++)
+		CHECK(records[i].sequence > records[i - 1].sequence);
+
+	for (const auto &record : records) {
+		CHECK(record.controller < threadCount);
+		CHECK((int64_t)record.moveFlags > last[record.controller % threadCount]);
+		last[record.controller % threadCount] = record.moveFlags;
+	}
+}
+
+} // namespace
+
+int main()
+{
+	TestRecordAndReadBack();
+	return test::Result();
+}
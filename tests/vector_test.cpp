@@ -0,0 +1,141 @@
+// The SSE vector path against the scalar path, bit for bit, over random
+// inputs including NaNs, infinities, denormals and signed zeros
+#include "test.h"
+#include "util/vector.h"
+#include <bit>
+#include <cmath>
+#include <random>
+
+namespace {
+
+// The same layouts without an SSE specialization
+struct scalar_vec3_base : vec3_base<float> {};
+struct scalar_vec4_base : vec4_base<float> {};
+
+using scalar_vec3 = vec_impl<scalar_vec3_base>;
+using scalar_vec4 = vec_impl<scalar_vec4_base>;
+
+constexpr auto kCases = 200000;
+
+std::mt19937 g_rng(42);
+
+float RandomFloat()
+{
+	switch (g_rng() % 10) {
+	case 0:  return std::bit_cast<float>((uint32_t)g_rng());
+	case 1:  return g_rng() % 2 != 0 ? -0.f : 0.f;
+	case 2:  return g_rng() % 2 != 0 ? INFINITY : -INFINITY;
+	case 3:  return std::bit_cast<float>((uint32_t)g_rng() & 0x807FFFFF);
+	default: return std::uniform_real_distribution<float>(-100.f, 100.f)(g_rng);
+	}
+}
+
+// Equal bits, or both NaN with any payload
+bool BitEqual(float a, float b)
+{
+	return std::bit_cast<uint32_t>(a) == std::bit_cast<uint32_t>(b) || (std::isnan(a) && std::isnan(b));
+}
+
+template<typename A, typename B>
+bool BitEqual(const A &a, const B &b)
+{
+	auto equal = true;
+	a.foreach([&](float x, float y) { equal = equal && BitEqual(x, y); }, b.elems());
+	return equal;
+}
+
+// Runs every operation on V and its scalar twin S with the same inputs
+template<typename V, typename S>
+void CompareOps(const V &a, const V &b, float s)
+{
+	const auto sa = S(a.elems());
+	const auto sb = S(b.elems());
+
+	CHECK(BitEqual(V::dot(a, b), S::dot(sa, sb)));
+	CHECK(BitEqual(V::min(a, b), S::min(sa, sb)));
+	CHECK(BitEqual(V::max(a, b), S::max(sa, sb)));
+	CHECK(BitEqual(V::min(b, a), S::min(sb, sa)));
+	CHECK(BitEqual(a.normalized(), sa.normalized()));
+	CHECK(BitEqual(a.abs(), sa.abs()));
+	CHECK(BitEqual(-a, -sa));
+	CHECK(BitEqual(a + b, sa + sb));
+	CHECK(BitEqual(a - b, sa - sb));
+	CHECK(BitEqual(a * b, sa * sb));
+	CHECK(BitEqual(a / b, sa / sb));
+	CHECK(BitEqual(a * s, sa * s));
+	CHECK(BitEqual(a / s, sa / s));
+	CHECK((a == b) == (sa == sb));
+	CHECK((a == a) == (sa == sa));
+
+	auto e = a;
+	auto se = sa;
+	e += b;
+	se += sb;
+	e *= s;
+	se *= s;
+	e -= a;
+	se -= sa;
+	e /= b;
+	se /= sb;
+	e *= b;
+	se *= sb;
+	e /= s;
+	se /= s;
+	CHECK(BitEqual(e, se));
+}
+
+template<typename V>
+V RandomVec()
+{
+	V v;
+	v.foreach([](float &x) { x = RandomFloat(); });
+	return v;
+}
+
+void TestRandom()
+{
+	for (auto i = 0; i < kCases && test::failures == 0; i++) {
+		CompareOps<vec3, scalar_vec3>(RandomVec<vec3>(), RandomVec<vec3>(), RandomFloat());
+		CompareOps<vec4, scalar_vec4>(RandomVec<vec4>(), RandomVec<vec4>(), RandomFloat());
+
+		const auto a = RandomVec<vec3>();
+		const auto b = RandomVec<vec3>();
+		CHECK(BitEqual(vec3::cross(a, b), vec3::cross(scalar_vec3(a.elems()), scalar_vec3(b.elems()))));
+	}
+}
+
+// min and max of values that compare equal keep the first, as std::min and
+// std::max do
+void TestSignedZeros()
+{
+	const auto a = vec4(0.f, -0.f, 0.f, NAN);
+	const auto b = vec4(-0.f, 0.f, NAN, 0.f);
+	const auto sa = scalar_vec4(a.elems());
+	const auto sb = scalar_vec4(b.elems());
+
+	CHECK(BitEqual(vec4::min(a, b), scalar_vec4::min(sa, sb)));
+	CHECK(BitEqual(vec4::max(a, b), scalar_vec4::max(sa, sb)));
+	CHECK(BitEqual(vec4::min(b, a), scalar_vec4::min(sb, sa)));
+	CHECK(std::signbit(vec4::min(a, b).y));
+	CHECK(!std::signbit(vec4::min(a, b).x));
+}
+
+void TestConstant()
+{
+	constexpr auto cross = vec3::cross(vec3(1, 0, 0), vec3(0, 1, 0)) + vec3() * 2.f;
+	static_assert(cross == vec3(0, 0, 1));
+	static_assert(vec4::dot(vec4(1, 2, 3, 4), vec4(1, 1, 1, 1)) == 10);
+	static_assert(-vec4(1, 2, 3, 4) == vec4(-1, -2, -3, -4));
+
+	CHECK(BitEqual(vec4(), vec4(0.f, 0.f, 0.f, 0.f)));
+}
+
+} // namespace
+
+int main()
+{
+	TestRandom();
+	TestSignedZeros();
+	TestConstant();
+	return test::Result();
+}
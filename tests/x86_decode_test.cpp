@@ -0,0 +1,91 @@
+// decode_x86 against objdump's instruction lengths, and the fields the
+// relocator rewrites
+#include "test.h"
+#include "x86_decode_fixtures.h"
+#include "util/x86_decode.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Fixture bytes followed by int3 padding, as the decoder may look ahead
+struct Code {
+	uint8_t bytes[detail::x86::MAX_LENGTH * 2];
+	size_t size = 0;
+
+	explicit Code(const char *hex)
+	{
+		memset(bytes, 0xCC, sizeof(bytes));
+
+		for (auto *at = hex; *at != '\0';) {
+			char *end;
+			bytes[size++] = (uint8_t)strtoul(at, &end, 16);
+			at = end;
+		}
+	}
+};
+
+void TestFixtureLengths()
+{
+	for (const auto &fixture : X86_FIXTURES) {
+		const auto code = Code(fixture.bytes);
+		const auto length = decode_x86(code.bytes, fixture.mode).length;
+
+		if (!CHECK(length == code.size))
+			fprintf(stderr, "  %s: decoded %u bytes\n", fixture.bytes, length);
+	}
+}
+
+void TestFields()
+{
+	// jne rel32
+	auto insn = decode_x86(Code("0f 85 10 00 00 00").bytes, x86_mode::x64);
+	CHECK(insn.relative && insn.map == 1 && insn.opcode == 0x85);
+	CHECK(insn.imm_offset == 2 && insn.imm_size == 4);
+
+	// je rel8
+	insn = decode_x86(Code("74 10").bytes, x86_mode::ia32);
+	CHECK(insn.relative && insn.imm_offset == 1 && insn.imm_size == 1);
+
+	// call rel32, and call through a register, which isn't relative
+	CHECK(decode_x86(Code("e8 00 00 00 00").bytes, x86_mode::ia32).relative);
+	CHECK(!decode_x86(Code("ff d0").bytes, x86_mode::ia32).relative);
+
+	// jmp rel16 with an operand size prefix
+	insn = decode_x86(Code("66 e9 10 00").bytes, x86_mode::ia32);
+	CHECK(insn.length == 4 && insn.relative && insn.opcode_offset == 1 && insn.imm_size == 2);
+
+	// mov eax, [rip+0x100] is RIP relative only in 64 bit mode
+	insn = decode_x86(Code("8b 05 00 01 00 00").bytes, x86_mode::x64);
+	CHECK(insn.rip_relative && insn.disp_offset == 2 && insn.disp_size == 4);
+	CHECK(!decode_x86(Code("8b 05 00 01 00 00").bytes, x86_mode::ia32).rip_relative);
+
+	// cmp dword ptr [rip+0x10], 1 puts the immediate after the displacement
+	insn = decode_x86(Code("83 3d 10 00 00 00 01").bytes, x86_mode::x64);
+	CHECK(insn.length == 7 && insn.rip_relative && insn.imm_offset == 6 && insn.imm_size == 1);
+
+	// cmp byte ptr [esp+0x1B], 0, which the game's mid hook replaces
+	insn = decode_x86(Code("80 7c 24 1b 00").bytes, x86_mode::ia32);
+	CHECK(insn.length == 5 && insn.modrm_offset == 1 && insn.disp_offset == 3 && insn.imm_offset == 4);
+
+	// mov rax, imm64
+	CHECK(decode_x86(Code("48 b8 01 02 03 04 05 06 07 08").bytes, x86_mode::x64).length == 10);
+
+	// Past 15 bytes of prefixes
+	CHECK(decode_x86(Code("66 66 66 66 66 66 66 66 66 66 66 66 66 66 90").bytes, x86_mode::x64).length == 15);
+	CHECK(decode_x86(Code("66 66 66 66 66 66 66 66 66 66 66 66 66 66 66 90").bytes, x86_mode::x64).length == 0);
+
+	// Constant evaluation
+	constexpr uint8_t push[] = {0x55};
+	static_assert(decode_x86(push, x86_mode::ia32).length == 1);
+}
+
+} // namespace
+
+int main()
+{
+	TestFixtureLengths();
+	TestFields();
+	return test::Result();
+}
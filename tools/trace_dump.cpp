@@ -0,0 +1,224 @@
+// Dumps movement traces recorded with bTrace=1
+//
+//   g++ -std=c++20 -O2 -Isrc tools/trace_dump.cpp -o trace_dump
+//   trace_dump [options] player_physics.trace
+//
+//   --kind <move|jumping|onground|inair>  only records of this kind
+//   --controller <hex>                     only this controller
+//   --from <n> / --to <n>                  sequence range, inclusive
+//   --physics                              only steps using the custom model
+//   --csv                                  comma separated output
+#include "trace_format.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace trace;
+
+namespace {
+
+constexpr const char *kKindNames[] = {"move", "jumping", "onground", "inair"};
+
+struct Filter {
+	std::optional<TraceKind> kind;
+	std::optional<uint32_t> controller;
+	uint32_t from = 0;
+	uint32_t to = UINT32_MAX;
+	bool physicsOnly = false;
+	bool csv = false;
+
+	bool Matches(const TraceRecord &record) const
+	{
+		if (kind.has_value() && record.kind != *kind)
+			return false;
+		if (controller.has_value() && record.controller != *controller)
+			return false;
+		if (record.sequence < from || record.sequence > to)
+			return false;
+		if (physicsOnly && !(record.flags & kTraceFlag_UsedPhysics))
+			return false;
+		return true;
+	}
+};
+
+[[noreturn]] void Usage(const char *argv0)
+{
+	fprintf(stderr,
+		"usage: %s [--kind move|jumping|onground|inair] [--controller hex]\n"
+		"       [--from n] [--to n] [--physics] [--csv] file\n", argv0);
+	exit(1);
+}
+
+std::optional<uint32_t> ParseInt(std::string_view string, int base = 10)
+{
+	if (base == 16 && string.starts_with("0x"))
+		string.remove_prefix(2);
+
+	auto value = uint32_t();
+	const auto *end = string.data() + string.size();
+	const auto result = std::from_chars(string.data(), end, value, base);
+	return result.ec == std::errc() && result.ptr == end ? std::optional(value) : std::nullopt;
+}
+
+const char *KindName(TraceKind kind)
+{
+	return kind < std::size(kKindNames) ? kKindNames[kind] : "?";
+}
+
+void PrintVec3(const char *separator, const TraceVec3 &vector)
+{
+	printf("%s%.4f%s%.4f%s%.4f", separator, vector.x, separator, vector.y, separator, vector.z);
+}
+
+void PrintCsvHeader()
+{
+	printf("sequence,controller,kind,physics,hkState,wantState,moveFlags,deltaTime,"
+	       "inX,inY,inZ,outX,outY,outZ,"
+	       "forwardX,forwardY,forwardZ,normalX,normalY,normalZ,"
+	       "inputX,inputY,inputZ,maxSpeed\n");
+}
+
+void PrintCsv(const TraceRecord &record)
+{
+	printf("%u,%08x,%s,%d,%u,%u,%u,%.6f",
+		record.sequence, record.controller, KindName(record.kind),
+		(record.flags & kTraceFlag_UsedPhysics) != 0,
+		record.hkState, record.wantState, record.moveFlags, record.deltaTime);
+
+	PrintVec3(",", record.velocityIn);
+	PrintVec3(",", record.velocityOut);
+	PrintVec3(",", record.params.forward);
+	PrintVec3(",", record.params.groundNormal);
+	PrintVec3(",", record.params.input);
+	printf(",%.4f\n", record.params.maxSpeed);
+}
+
+void PrintText(const TraceRecord &record)
+{
+	printf("#%-8u %08x %-8s %s state %u->%u flags %02x dt %.5f in",
+		record.sequence, record.controller, KindName(record.kind),
+		record.flags & kTraceFlag_UsedPhysics ? "phys" : "orig",
+		record.hkState, record.wantState, record.moveFlags, record.deltaTime);
+
+	PrintVec3(" ", record.velocityIn);
+	printf(" out");
+	PrintVec3(" ", record.velocityOut);
+
+	if (record.flags & kTraceFlag_HasParams) {
+		printf(" normal");
+		PrintVec3(" ", record.params.groundNormal);
+		printf(" max %.3f", record.params.maxSpeed);
+	}
+
+	printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	auto filter = Filter();
+	const char *path = nullptr;
+
+	for (auto i = 1; i < argc; i++) {
+		const auto arg = std::string_view(argv[i]);
+		const auto next = [&] {
+			if (i + 1 >= argc)
+				Usage(argv[0]);
+			return std::string_view(argv[++i]);
+		};
+
+		if (arg == "--kind") {
+			const auto name = next();
+			auto found = false;
+			for (auto kind = 0; kind < (int)std::size(kKindNames); kind++) {
+				if (name == kKindNames[kind]) {
+					filter.kind = (TraceKind)kind;
+					found = true;
+				}
+			}
+			if (!found)
+				Usage(argv[0]);
+		} else if (arg == "--controller") {
+			filter.controller = ParseInt(next(), 16);
+			if (!filter.controller.has_value())
+				Usage(argv[0]);
+		} else if (arg == "--from" || arg == "--to") {
+			const auto value = ParseInt(next());
+			if (!value.has_value())
+				Usage(argv[0]);
+			(arg == "--from" ? filter.from : filter.to) = *value;
+		} else if (arg == "--physics") {
+			filter.physicsOnly = true;
+		} else if (arg == "--csv") {
+			filter.csv = true;
+		} else if (path == nullptr && !arg.starts_with("--")) {
+			path = argv[i];
+		} else {
+			Usage(argv[0]);
+		}
+	}
+
+	if (path == nullptr)
+		Usage(argv[0]);
+
+	const auto fd = open(path, O_RDONLY);
+	struct stat info;
+
+	if (fd < 0 || fstat(fd, &info) != 0) {
+		perror(path);
+		return 1;
+	}
+
+	if ((size_t)info.st_size < sizeof(TraceHeader)) {
+		fprintf(stderr, "%s: too small for a trace\n", path);
+		return 1;
+	}
+
+	const auto *data = (const std::byte*)mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	if (data == MAP_FAILED) {
+		perror("mmap");
+		return 1;
+	}
+
+	const auto *header = (const TraceHeader*)data;
+
+	if (header->magic != kTraceMagic || header->version != kTraceVersion ||
+	    header->recordSize != sizeof(TraceRecord)) {
+		fprintf(stderr, "%s: not a version %u trace\n", path, kTraceVersion);
+		return 1;
+	}
+
+	// Files left by a crash keep their preallocated size
+	const auto available = (info.st_size - sizeof(TraceHeader)) / sizeof(TraceRecord);
+	const auto count = std::min((size_t)header->recordCount, available);
+	const auto *records = (const TraceRecord*)(header + 1);
+
+	if (filter.csv)
+		PrintCsvHeader();
+	else
+		printf("%zu records, %u dropped\n", count, header->droppedCount);
+
+	for (size_t i = 0; i < count; i++) {
+		if (!filter.Matches(records[i]))
+			continue;
+
+		if (filter.csv)
+			PrintCsv(records[i]);
+		else
+			PrintText(records[i]);
+	}
+
+	munmap((void*)data, info.st_size);
+	close(fd);
+	return 0;
+}